@@ -417,6 +417,29 @@ struct alignas(8) K32V32 {
   uint32_t key;
 };
 
+// Same layouts as K32V32 and K64V64, but with signed or floating-point keys,
+// which vqsort orders accordingly without requiring callers to encode them.
+// Negative zero is ordered before positive zero.
+struct alignas(8) KI32V32 {
+  uint32_t value;  // little-endian layout
+  int32_t key;
+};
+
+struct alignas(8) KF32V32 {
+  uint32_t value;  // little-endian layout
+  float key;
+};
+
+struct alignas(16) KI64V64 {
+  uint64_t value;  // little-endian layout
+  int64_t key;
+};
+
+struct alignas(16) KF64V64 {
+  uint64_t value;  // little-endian layout
+  double key;
+};
+
 #pragma pack(pop)
 
 static inline HWY_MAYBE_UNUSED bool operator<(const uint128_t& a,
@@ -461,6 +484,62 @@ static inline HWY_MAYBE_UNUSED bool operator==(const K32V32& a,
   return a.key == b.key;
 }
 
+static inline HWY_MAYBE_UNUSED bool operator<(const KI32V32& a,
+                                              const KI32V32& b) {
+  return a.key < b.key;
+}
+// Required for std::greater.
+static inline HWY_MAYBE_UNUSED bool operator>(const KI32V32& a,
+                                              const KI32V32& b) {
+  return b < a;
+}
+static inline HWY_MAYBE_UNUSED bool operator==(const KI32V32& a,
+                                               const KI32V32& b) {
+  return a.key == b.key;
+}
+
+static inline HWY_MAYBE_UNUSED bool operator<(const KF32V32& a,
+                                              const KF32V32& b) {
+  return a.key < b.key;
+}
+// Required for std::greater.
+static inline HWY_MAYBE_UNUSED bool operator>(const KF32V32& a,
+                                              const KF32V32& b) {
+  return b < a;
+}
+static inline HWY_MAYBE_UNUSED bool operator==(const KF32V32& a,
+                                               const KF32V32& b) {
+  return a.key == b.key;
+}
+
+static inline HWY_MAYBE_UNUSED bool operator<(const KI64V64& a,
+                                              const KI64V64& b) {
+  return a.key < b.key;
+}
+// Required for std::greater.
+static inline HWY_MAYBE_UNUSED bool operator>(const KI64V64& a,
+                                              const KI64V64& b) {
+  return b < a;
+}
+static inline HWY_MAYBE_UNUSED bool operator==(const KI64V64& a,
+                                               const KI64V64& b) {
+  return a.key == b.key;
+}
+
+static inline HWY_MAYBE_UNUSED bool operator<(const KF64V64& a,
+                                              const KF64V64& b) {
+  return a.key < b.key;
+}
+// Required for std::greater.
+static inline HWY_MAYBE_UNUSED bool operator>(const KF64V64& a,
+                                              const KF64V64& b) {
+  return b < a;
+}
+static inline HWY_MAYBE_UNUSED bool operator==(const KF64V64& a,
+                                               const KF64V64& b) {
+  return a.key == b.key;
+}
+
 //------------------------------------------------------------------------------
 // Controlling overload resolution (SFINAE)
 
@@ -2088,6 +2167,22 @@ template <>
 constexpr bool IsSigned<hwy::K32V32>() {
   return false;
 }
+template <>
+constexpr bool IsSigned<hwy::KI32V32>() {
+  return true;
+}
+template <>
+constexpr bool IsSigned<hwy::KF32V32>() {
+  return true;
+}
+template <>
+constexpr bool IsSigned<hwy::KI64V64>() {
+  return true;
+}
+template <>
+constexpr bool IsSigned<hwy::KF64V64>() {
+  return true;
+}
 
 template <typename T, bool = IsInteger<T>() && !IsIntegerLaneType<T>()>
 struct MakeLaneTypeIfIntegerT {
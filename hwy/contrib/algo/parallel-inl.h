@@ -0,0 +1,481 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-target include guard
+#if defined(HIGHWAY_HWY_CONTRIB_ALGO_PARALLEL_INL_H_) == \
+    defined(HWY_TARGET_TOGGLE)  // NOLINT
+#ifdef HIGHWAY_HWY_CONTRIB_ALGO_PARALLEL_INL_H_
+#undef HIGHWAY_HWY_CONTRIB_ALGO_PARALLEL_INL_H_
+#else
+#define HIGHWAY_HWY_CONTRIB_ALGO_PARALLEL_INL_H_
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <vector>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/contrib/algo/copy-inl.h"
+#include "hwy/contrib/algo/find-inl.h"
+#include "hwy/contrib/algo/transform-inl.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+// Overloads of the functions in copy-inl.h, find-inl.h and transform-inl.h
+// which split the arrays into chunks and process them on `pool`, plus
+// reductions at the end of this file. The results
+// are the same as for the single-threaded versions, but `func` may be called
+// concurrently and must therefore be thread-safe. Small arrays are processed
+// on the calling thread because the fork-join overhead would dominate.
+
+namespace detail {
+
+// Splits `[0, count)` into chunks whose boundaries (other than 0 and `count`)
+// are at cache line boundaries of `array`, so that no two workers write to the
+// same line. There are several chunks per worker for load balancing, but each
+// is large enough to amortize the overhead of a task.
+class ParallelChunks {
+  static constexpr size_t kLineBytes = 64;
+  static constexpr size_t kMinChunkBytes = 32 * 1024;
+  static constexpr size_t kChunksPerWorker = 4;
+
+ public:
+  template <typename T>
+  ParallelChunks(const T* array, size_t count, size_t num_workers)
+      : count_(count) {
+    static_assert(kLineBytes % sizeof(T) == 0, "T must divide cache line");
+    const size_t bytes = count * sizeof(T);
+    const size_t chunk_bytes = RoundUpTo(
+        HWY_MAX(kMinChunkBytes, DivCeil(bytes, kChunksPerWorker * num_workers)),
+        kLineBytes);
+    chunk_ = chunk_bytes / sizeof(T);
+    misalign_ = (reinterpret_cast<uintptr_t>(array) % kLineBytes) / sizeof(T);
+    num_ = num_workers <= 1 ? 1 : DivCeil(count + misalign_, chunk_);
+  }
+
+  // If 1, the caller should use the single-threaded version.
+  uint64_t Num() const { return static_cast<uint64_t>(num_); }
+
+  size_t Begin(uint64_t chunk) const {
+    if (chunk == 0) return 0;
+    return HWY_MIN(static_cast<size_t>(chunk) * chunk_ - misalign_, count_);
+  }
+  size_t End(uint64_t chunk) const { return Begin(chunk + 1); }
+
+ private:
+  size_t count_;
+  size_t chunk_;     // elements
+  size_t misalign_;  // elements before the first cache line boundary
+  size_t num_;
+};
+
+// Lowers `first` to `value` if that is smaller.
+HWY_INLINE void AtomicMin(std::atomic<size_t>& first, size_t value) {
+  size_t prev = first.load(std::memory_order_relaxed);
+  while (value < prev &&
+         !first.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {
+  }
+}
+
+// Adds `offset` to the indices passed to the user's Generate `func`.
+template <class Func>
+struct GenerateWithOffset {
+  template <class D, class VU>
+  Vec<D> operator()(D d, VU idx) const {
+    using TU = TFromV<VU>;
+    return func(d, Add(idx, Set(DFromV<VU>(), static_cast<TU>(offset))));
+  }
+
+  const Func& func;
+  size_t offset;
+};
+
+// Returns the number of elements in `in[0, count)` for which `func(d, vec)`
+// returns true.
+template <class D, class Func, typename T = TFromD<D>>
+size_t CountIf(D d, const T* HWY_RESTRICT in, size_t count, const Func& func) {
+  const size_t N = Lanes(d);
+
+  size_t num = 0;
+  size_t i = 0;
+  if (count >= N) {
+    for (; i <= count - N; i += N) {
+      num += CountTrue(d, func(d, LoadU(d, in + i)));
+    }
+  }
+
+  if (i != count) {
+#if HWY_MEM_OPS_MIGHT_FAULT
+    const CappedTag<T, 1> d1;
+    for (; i < count; ++i) {
+      // Workaround for -Waggressive-loop-optimizations on GCC 8, see CopyIf.
+      const uintptr_t addr = reinterpret_cast<uintptr_t>(in);
+      const T* HWY_RESTRICT in_i =
+          reinterpret_cast<const T * HWY_RESTRICT>(addr + (i * sizeof(T)));
+      num += CountTrue(d1, func(d1, LoadU(d1, in_i)));
+    }
+#else
+    const size_t remaining = count - i;
+    HWY_DASSERT(0 != remaining && remaining < N);
+    const Mask<D> mask = FirstN(d, remaining);
+    const Vec<D> v = MaskedLoad(mask, d, in + i);
+    num += CountTrue(d, And(func(d, v), mask));
+#endif  // HWY_MEM_OPS_MIGHT_FAULT
+  }
+  return num;
+}
+
+// Below this size, reductions run on the calling thread.
+constexpr size_t kMinParallelReduceBytes = 64 * 1024;
+
+// Returns ParallelReduce(pool, 0, count, ...) or, for small arrays, the same
+// computation as if there were only one worker.
+template <typename T, class Func, class Combine>
+T ReduceArray(hwy::ThreadPool& pool, size_t count, const T& identity,
+              const Func& func, const Combine& combine) {
+  if (count * sizeof(T) < kMinParallelReduceBytes) {
+    T acc = identity;
+    if (count != 0) func(0, count, acc);
+    return combine(identity, acc);
+  }
+  return ParallelReduce(pool, 0, count, identity, func, combine);
+}
+
+// Returns the lane-wise sum of all vectors in `in[0, count)`, with zero
+// padding for the last partial vector.
+template <class D, typename T = TFromD<D>>
+Vec<D> SumOfVectors(D d, const T* HWY_RESTRICT in, size_t count) {
+  const size_t N = Lanes(d);
+  // Two accumulators to reduce the dependency chain.
+  Vec<D> sum0 = Zero(d);
+  Vec<D> sum1 = Zero(d);
+  size_t i = 0;
+  if (count >= 2 * N) {
+    for (; i <= count - 2 * N; i += 2 * N) {
+      sum0 = Add(sum0, LoadU(d, in + i));
+      sum1 = Add(sum1, LoadU(d, in + i + N));
+    }
+  }
+  for (; i + N <= count; i += N) {
+    sum0 = Add(sum0, LoadU(d, in + i));
+  }
+  if (i != count) sum1 = Add(sum1, LoadN(d, in + i, count - i));
+  return Add(sum0, sum1);
+}
+
+template <class D, HWY_IF_FLOAT_D(D)>
+Vec<D> MinIdentity(D d) {
+  return Inf(d);
+}
+template <class D, HWY_IF_NOT_FLOAT_D(D)>
+Vec<D> MinIdentity(D d) {
+  return Set(d, HighestValue<TFromD<D>>());
+}
+
+template <class D, HWY_IF_FLOAT_D(D)>
+Vec<D> MaxIdentity(D d) {
+  return Neg(Inf(d));
+}
+template <class D, HWY_IF_NOT_FLOAT_D(D)>
+Vec<D> MaxIdentity(D d) {
+  return Set(d, LowestValue<TFromD<D>>());
+}
+
+}  // namespace detail
+
+template <class D, typename T = TFromD<D>>
+void Fill(D d, T value, size_t count, T* HWY_RESTRICT to,
+          hwy::ThreadPool& pool) {
+  const detail::ParallelChunks chunks(to, count, pool.NumWorkers());
+  if (chunks.Num() <= 1) return Fill(d, value, count, to);
+  pool.Run(0, chunks.Num(), [&](uint64_t chunk, size_t /*thread*/) HWY_ATTR {
+    const size_t begin = chunks.Begin(chunk);
+    Fill(d, value, chunks.End(chunk) - begin, to + begin);
+  });
+}
+
+template <class D, typename T = TFromD<D>>
+void Copy(D d, const T* HWY_RESTRICT from, size_t count, T* HWY_RESTRICT to,
+          hwy::ThreadPool& pool) {
+  const detail::ParallelChunks chunks(to, count, pool.NumWorkers());
+  if (chunks.Num() <= 1) return Copy(d, from, count, to);
+  pool.Run(0, chunks.Num(), [&](uint64_t chunk, size_t /*thread*/) HWY_ATTR {
+    const size_t begin = chunks.Begin(chunk);
+    Copy(d, from + begin, chunks.End(chunk) - begin, to + begin);
+  });
+}
+
+// Order-preserving: first counts the elements to copy per chunk, then each
+// chunk writes to the output position given by the prefix sum of the counts.
+// `func` is thus called twice for each element.
+// NOTE: this is only supported for 16-, 32- or 64-bit types.
+template <class D, class Func, typename T = TFromD<D>>
+T* CopyIf(D d, const T* HWY_RESTRICT from, size_t count, T* HWY_RESTRICT to,
+          const Func& func, hwy::ThreadPool& pool) {
+  const size_t num_workers = pool.NumWorkers();
+  const detail::ParallelChunks chunks(from, count, num_workers);
+  const uint64_t num_chunks = chunks.Num();
+  if (num_chunks <= 1) return CopyIf(d, from, count, to, func);
+
+  std::vector<size_t> offsets(static_cast<size_t>(num_chunks) + 1, 0);
+  pool.Run(0, num_chunks, [&](uint64_t chunk, size_t /*thread*/) HWY_ATTR {
+    const size_t begin = chunks.Begin(chunk);
+    offsets[chunk + 1] =
+        detail::CountIf(d, from + begin, chunks.End(chunk) - begin, func);
+  });
+  for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+    offsets[chunk + 1] += offsets[chunk];
+  }
+
+  // CompressBlendedStore may write (unchanged values) up to a vector beyond the
+  // last selected element, which would race with the next chunk. Hence the
+  // last outputs of each chunk go through a per-worker buffer.
+  const size_t N = Lanes(d);
+  AlignedFreeUniquePtr<T[]> buffers = AllocateAligned<T>(num_workers * 2 * N);
+  HWY_ASSERT(buffers);
+  pool.Run(0, num_chunks, [&](uint64_t chunk, size_t thread) HWY_ATTR {
+    const size_t end = chunks.End(chunk);
+    T* HWY_RESTRICT out = to + offsets[chunk];
+    T* HWY_RESTRICT out_end = to + offsets[chunk + 1];
+    size_t i = chunks.Begin(chunk);
+    for (; i + N <= end && out + N <= out_end; i += N) {
+      const Vec<D> v = LoadU(d, from + i);
+      out += CompressBlendedStore(v, func(d, v), d, out);
+    }
+    // Fewer than N outputs remain. The buffer has room for the up to N - 1
+    // outputs plus the CompressBlendedStore of up to N lanes after them.
+    T* HWY_RESTRICT buf = buffers.get() + thread * 2 * N;
+    const size_t num = static_cast<size_t>(
+        CopyIf(d, from + i, end - i, buf, func) - buf);
+    HWY_DASSERT(out + num == out_end);
+    CopyBytes(buf, out, num * sizeof(T));
+  });
+  return to + offsets[num_chunks];
+}
+
+template <class D, typename T = TFromD<D>>
+size_t Find(D d, T value, const T* HWY_RESTRICT in, size_t count,
+            hwy::ThreadPool& pool) {
+  const detail::ParallelChunks chunks(in, count, pool.NumWorkers());
+  if (chunks.Num() <= 1) return Find(d, value, in, count);
+  std::atomic<size_t> first{count};
+  pool.Run(0, chunks.Num(), [&](uint64_t chunk, size_t /*thread*/) HWY_ATTR {
+    const size_t begin = chunks.Begin(chunk);
+    // Skip if a preceding chunk already found a match.
+    if (begin >= first.load(std::memory_order_relaxed)) return;
+    const size_t num = chunks.End(chunk) - begin;
+    const size_t pos = Find(d, value, in + begin, num);
+    if (pos != num) detail::AtomicMin(first, begin + pos);
+  });
+  return first.load(std::memory_order_relaxed);
+}
+
+template <class D, class Func, typename T = TFromD<D>>
+size_t FindIf(D d, const T* HWY_RESTRICT in, size_t count, const Func& func,
+              hwy::ThreadPool& pool) {
+  const detail::ParallelChunks chunks(in, count, pool.NumWorkers());
+  if (chunks.Num() <= 1) return FindIf(d, in, count, func);
+  std::atomic<size_t> first{count};
+  pool.Run(0, chunks.Num(), [&](uint64_t chunk, size_t /*thread*/) HWY_ATTR {
+    const size_t begin = chunks.Begin(chunk);
+    // Skip if a preceding chunk already found a match.
+    if (begin >= first.load(std::memory_order_relaxed)) return;
+    const size_t num = chunks.End(chunk) - begin;
+    const size_t pos = FindIf(d, in + begin, num, func);
+    if (pos != num) detail::AtomicMin(first, begin + pos);
+  });
+  return first.load(std::memory_order_relaxed);
+}
+
+template <class D, class Func, typename T = TFromD<D>>
+void Generate(D d, T* HWY_RESTRICT out, size_t count, const Func& func,
+              hwy::ThreadPool& pool) {
+  const detail::ParallelChunks chunks(out, count, pool.NumWorkers());
+  if (chunks.Num() <= 1) return Generate(d, out, count, func);
+  pool.Run(0, chunks.Num(), [&](uint64_t chunk, size_t /*thread*/) HWY_ATTR {
+    const size_t begin = chunks.Begin(chunk);
+    const detail::GenerateWithOffset<Func> func_offset{func, begin};
+    Generate(d, out + begin, chunks.End(chunk) - begin, func_offset);
+  });
+}
+
+template <class D, class Func, typename T = TFromD<D>>
+void Transform(D d, T* HWY_RESTRICT inout, size_t count, const Func& func,
+               hwy::ThreadPool& pool) {
+  const detail::ParallelChunks chunks(inout, count, pool.NumWorkers());
+  if (chunks.Num() <= 1) return Transform(d, inout, count, func);
+  pool.Run(0, chunks.Num(), [&](uint64_t chunk, size_t /*thread*/) HWY_ATTR {
+    const size_t begin = chunks.Begin(chunk);
+    Transform(d, inout + begin, chunks.End(chunk) - begin, func);
+  });
+}
+
+template <class D, class Func, typename T = TFromD<D>>
+void Transform1(D d, T* HWY_RESTRICT inout, size_t count,
+                const T* HWY_RESTRICT in1, const Func& func,
+                hwy::ThreadPool& pool) {
+  const detail::ParallelChunks chunks(inout, count, pool.NumWorkers());
+  if (chunks.Num() <= 1) return Transform1(d, inout, count, in1, func);
+  pool.Run(0, chunks.Num(), [&](uint64_t chunk, size_t /*thread*/) HWY_ATTR {
+    const size_t begin = chunks.Begin(chunk);
+    Transform1(d, inout + begin, chunks.End(chunk) - begin, in1 + begin, func);
+  });
+}
+
+template <class D, class Func, typename T = TFromD<D>>
+void Transform2(D d, T* HWY_RESTRICT inout, size_t count,
+                const T* HWY_RESTRICT in1, const T* HWY_RESTRICT in2,
+                const Func& func, hwy::ThreadPool& pool) {
+  const detail::ParallelChunks chunks(inout, count, pool.NumWorkers());
+  if (chunks.Num() <= 1) return Transform2(d, inout, count, in1, in2, func);
+  pool.Run(0, chunks.Num(), [&](uint64_t chunk, size_t /*thread*/) HWY_ATTR {
+    const size_t begin = chunks.Begin(chunk);
+    Transform2(d, inout + begin, chunks.End(chunk) - begin, in1 + begin,
+               in2 + begin, func);
+  });
+}
+
+template <class D, typename T = TFromD<D>>
+void Replace(D d, T* HWY_RESTRICT inout, size_t count, T new_t, T old_t,
+             hwy::ThreadPool& pool) {
+  const detail::ParallelChunks chunks(inout, count, pool.NumWorkers());
+  if (chunks.Num() <= 1) return Replace(d, inout, count, new_t, old_t);
+  pool.Run(0, chunks.Num(), [&](uint64_t chunk, size_t /*thread*/) HWY_ATTR {
+    const size_t begin = chunks.Begin(chunk);
+    Replace(d, inout + begin, chunks.End(chunk) - begin, new_t, old_t);
+  });
+}
+
+template <class D, class Func, typename T = TFromD<D>>
+void ReplaceIf(D d, T* HWY_RESTRICT inout, size_t count, T new_t,
+               const Func& func, hwy::ThreadPool& pool) {
+  const detail::ParallelChunks chunks(inout, count, pool.NumWorkers());
+  if (chunks.Num() <= 1) return ReplaceIf(d, inout, count, new_t, func);
+  pool.Run(0, chunks.Num(), [&](uint64_t chunk, size_t /*thread*/) HWY_ATTR {
+    const size_t begin = chunks.Begin(chunk);
+    ReplaceIf(d, inout + begin, chunks.End(chunk) - begin, new_t, func);
+  });
+}
+
+// Reductions via ParallelReduce: each worker reduces a contiguous subrange to a
+// scalar in its own accumulator, and these are combined in worker order. Hence
+// floating-point results are reproducible for a given target and number of
+// workers, but may differ from a sequential sum due to rounding.
+
+// Returns the sum of `in[0, count)`, or zero if `count` is zero.
+// NOTE: this is only supported for 16-, 32- or 64-bit types.
+template <class D, typename T = TFromD<D>>
+T ParallelSum(D d, const T* HWY_RESTRICT in, size_t count,
+              hwy::ThreadPool& pool) {
+  return detail::ReduceArray(
+      pool, count, ConvertScalarTo<T>(0),
+      [&](uint64_t begin, uint64_t end, T& acc) HWY_ATTR {
+        const size_t num = static_cast<size_t>(end - begin);
+        acc = ReduceSum(d, detail::SumOfVectors(d, in + begin, num));
+      },
+      [](T a, T b) { return ConvertScalarTo<T>(a + b); });
+}
+
+// Returns the smallest of `in[0, count)`, or if `count` is zero, infinity or
+// the highest representable value. The result is unspecified if any input is
+// NaN because per-task results are combined with scalar comparisons.
+template <class D, typename T = TFromD<D>>
+T ParallelMin(D d, const T* HWY_RESTRICT in, size_t count,
+              hwy::ThreadPool& pool) {
+  const Vec<D> identity = detail::MinIdentity(d);
+  return detail::ReduceArray(
+      pool, count, GetLane(identity),
+      [&](uint64_t begin, uint64_t end, T& acc) HWY_ATTR {
+        const size_t N = Lanes(d);
+        const size_t num = static_cast<size_t>(end - begin);
+        const T* HWY_RESTRICT range = in + begin;
+        Vec<D> min = identity;
+        size_t i = 0;
+        for (; i + N <= num; i += N) min = Min(min, LoadU(d, range + i));
+        if (i != num) min = Min(min, LoadNOr(identity, d, range + i, num - i));
+        acc = ReduceMin(d, min);
+      },
+      [](T a, T b) { return HWY_MIN(a, b); });
+}
+
+// Returns the largest of `in[0, count)`, or if `count` is zero, negative
+// infinity or the lowest representable value. As with ParallelMin, the result
+// is unspecified if any input is NaN.
+template <class D, typename T = TFromD<D>>
+T ParallelMax(D d, const T* HWY_RESTRICT in, size_t count,
+              hwy::ThreadPool& pool) {
+  const Vec<D> identity = detail::MaxIdentity(d);
+  return detail::ReduceArray(
+      pool, count, GetLane(identity),
+      [&](uint64_t begin, uint64_t end, T& acc) HWY_ATTR {
+        const size_t N = Lanes(d);
+        const size_t num = static_cast<size_t>(end - begin);
+        const T* HWY_RESTRICT range = in + begin;
+        Vec<D> max = identity;
+        size_t i = 0;
+        for (; i + N <= num; i += N) max = Max(max, LoadU(d, range + i));
+        if (i != num) max = Max(max, LoadNOr(identity, d, range + i, num - i));
+        acc = ReduceMax(d, max);
+      },
+      [](T a, T b) { return HWY_MAX(a, b); });
+}
+
+// Returns the dot product of `a[0, count)` and `b[0, count)`. For large arrays
+// of float32 or bfloat16, see also contrib/dot, which is faster but
+// single-threaded.
+template <class D, typename T = TFromD<D>, HWY_IF_FLOAT_D(D)>
+T ParallelDot(D d, const T* HWY_RESTRICT a, const T* HWY_RESTRICT b,
+              size_t count, hwy::ThreadPool& pool) {
+  return detail::ReduceArray(
+      pool, count, ConvertScalarTo<T>(0),
+      [&](uint64_t begin, uint64_t end, T& acc) HWY_ATTR {
+        const size_t N = Lanes(d);
+        const size_t num = static_cast<size_t>(end - begin);
+        const T* HWY_RESTRICT pa = a + begin;
+        const T* HWY_RESTRICT pb = b + begin;
+        Vec<D> sum0 = Zero(d);
+        Vec<D> sum1 = Zero(d);
+        size_t i = 0;
+        if (num >= 2 * N) {
+          for (; i <= num - 2 * N; i += 2 * N) {
+            sum0 = MulAdd(LoadU(d, pa + i), LoadU(d, pb + i), sum0);
+            sum1 = MulAdd(LoadU(d, pa + i + N), LoadU(d, pb + i + N), sum1);
+          }
+        }
+        for (; i + N <= num; i += N) {
+          sum0 = MulAdd(LoadU(d, pa + i), LoadU(d, pb + i), sum0);
+        }
+        if (i != num) {
+          // Zero padding does not change the sum.
+          sum1 = MulAdd(LoadN(d, pa + i, num - i), LoadN(d, pb + i, num - i),
+                        sum1);
+        }
+        acc = ReduceSum(d, Add(sum0, sum1));
+      },
+      [](T x, T y) { return ConvertScalarTo<T>(x + y); });
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_ALGO_PARALLEL_INL_H_
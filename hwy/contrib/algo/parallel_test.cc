@@ -0,0 +1,292 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
+
+// clang-format off
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "hwy/contrib/algo/parallel_test.cc"  //NOLINT
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+#include "hwy/highway.h"
+#include "hwy/contrib/algo/parallel-inl.h"
+#include "hwy/tests/test_util-inl.h"
+// clang-format on
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+// Functors rather than generic lambdas for C++11 compatibility.
+struct IsOdd {
+  template <class D, class V>
+  Mask<D> operator()(D d, V v) const {
+    return TestBit(v, Set(d, TFromD<D>{1}));
+  }
+};
+
+struct AddOne {
+  template <class D, class V>
+  V operator()(D d, V v) const {
+    return Add(v, Set(d, TFromD<D>{1}));
+  }
+};
+
+struct AddXor {
+  template <class D, class V>
+  V operator()(D /*d*/, V v, V v1) const {
+    return Add(v, v1);
+  }
+  template <class D, class V>
+  V operator()(D /*d*/, V v, V v1, V v2) const {
+    return Xor(Add(v, v1), v2);
+  }
+};
+
+struct IndexToValue {
+  template <class D, class VU>
+  Vec<D> operator()(D d, VU idx) const {
+    return BitCast(d, idx);
+  }
+};
+
+// Both large enough for multiple chunks, even for 8-bit types, and not a
+// multiple of the vector or cache line size.
+constexpr size_t kCounts[] = {0, 1, 100, 70001, 300007};
+
+template <typename T>
+void VerifyEqual(const T* expected, const T* actual, size_t count, int line) {
+  const auto info = hwy::detail::MakeTypeInfo<T>();
+  hwy::detail::AssertArrayEqual(info, expected, actual, count,
+                                hwy::TargetName(HWY_TARGET), __FILE__, line);
+}
+
+// Compares each parallel function with its single-threaded version.
+struct TestParallelAlgo {
+  template <typename T, class D>
+  HWY_NOINLINE void operator()(T /*unused*/, D d) {
+    // More threads than cores is fine for testing.
+    ThreadPool pool(HWY_ARCH_WASM ? 0 : 4);
+    RandomState rng;
+    for (size_t count : kCounts) {
+      for (size_t misalign : {size_t{0}, size_t{3}}) {
+        Test(d, count, misalign, pool, rng);
+      }
+    }
+  }
+
+  template <class D>
+  void Test(D d, size_t count, size_t misalign, ThreadPool& pool,
+            RandomState& rng) {
+    using T = TFromD<D>;
+    const size_t alloc = HWY_MAX(1, misalign + count);
+    AlignedFreeUniquePtr<T[]> pa = AllocateAligned<T>(alloc);
+    AlignedFreeUniquePtr<T[]> pb = AllocateAligned<T>(alloc);
+    AlignedFreeUniquePtr<T[]> pe = AllocateAligned<T>(alloc);
+    AlignedFreeUniquePtr<T[]> pi1 = AllocateAligned<T>(alloc);
+    AlignedFreeUniquePtr<T[]> pi2 = AllocateAligned<T>(alloc);
+    HWY_ASSERT(pa && pb && pe && pi1 && pi2);
+    T* HWY_RESTRICT a = pa.get() + misalign;
+    T* HWY_RESTRICT actual = pb.get() + misalign;
+    T* HWY_RESTRICT expected = pe.get() + misalign;
+    T* HWY_RESTRICT in1 = pi1.get() + misalign;
+    T* HWY_RESTRICT in2 = pi2.get() + misalign;
+    for (size_t i = 0; i < count; ++i) {
+      a[i] = ConvertScalarTo<T>(Random32(&rng) & 127);
+      in1[i] = ConvertScalarTo<T>(Random32(&rng) & 127);
+      in2[i] = ConvertScalarTo<T>(Random32(&rng) & 127);
+    }
+
+    const T value = ConvertScalarTo<T>(Random32(&rng) & 127);
+    Fill(d, value, count, expected);
+    Fill(d, value, count, actual, pool);
+    VerifyEqual(expected, actual, count, __LINE__);
+
+    Copy(d, a, count, actual, pool);
+    VerifyEqual(a, actual, count, __LINE__);
+
+    Generate(d, expected, count, IndexToValue());
+    Generate(d, actual, count, IndexToValue(), pool);
+    VerifyEqual(expected, actual, count, __LINE__);
+
+    Copy(d, a, count, expected);
+    Copy(d, a, count, actual);
+    Transform(d, expected, count, AddOne());
+    Transform(d, actual, count, AddOne(), pool);
+    VerifyEqual(expected, actual, count, __LINE__);
+
+    Transform1(d, expected, count, in1, AddXor());
+    Transform1(d, actual, count, in1, AddXor(), pool);
+    VerifyEqual(expected, actual, count, __LINE__);
+
+    Transform2(d, expected, count, in1, in2, AddXor());
+    Transform2(d, actual, count, in1, in2, AddXor(), pool);
+    VerifyEqual(expected, actual, count, __LINE__);
+
+    const T old_t = ConvertScalarTo<T>(5);
+    const T new_t = ConvertScalarTo<T>(200);
+    Copy(d, a, count, expected);
+    Copy(d, a, count, actual);
+    Replace(d, expected, count, new_t, old_t);
+    Replace(d, actual, count, new_t, old_t, pool);
+    VerifyEqual(expected, actual, count, __LINE__);
+
+    ReplaceIf(d, expected, count, old_t, IsOdd());
+    ReplaceIf(d, actual, count, old_t, IsOdd(), pool);
+    VerifyEqual(expected, actual, count, __LINE__);
+
+    // Find the first, a late, and a missing value.
+    HWY_ASSERT_EQ(Find(d, a[0], a, count), Find(d, a[0], a, count, pool));
+    if (count != 0) {
+      a[count - 1] = ConvertScalarTo<T>(255);
+      HWY_ASSERT_EQ(count - 1, Find(d, a[count - 1], a, count, pool));
+    }
+    HWY_ASSERT_EQ(count, Find(d, ConvertScalarTo<T>(254), a, count, pool));
+    HWY_ASSERT_EQ(FindIf(d, a, count, IsOdd()),
+                  FindIf(d, a, count, IsOdd(), pool));
+  }
+};
+
+void TestAllParallelAlgo() {
+  ForIntegerTypes(ForPartialVectors<TestParallelAlgo>());
+}
+
+struct TestParallelCopyIf {
+  template <typename T, class D>
+  HWY_NOINLINE void operator()(T /*unused*/, D d) {
+    ThreadPool pool(HWY_ARCH_WASM ? 0 : 4);
+    RandomState rng;
+    const size_t padding = Lanes(ScalableTag<T>());
+    for (size_t count : kCounts) {
+      // Vary the fraction of selected elements, including none and all.
+      for (uint32_t odd_mask : {0u, 1u, 3u, 127u}) {
+        const size_t alloc = HWY_MAX(1, count + padding);
+        AlignedFreeUniquePtr<T[]> pa = AllocateAligned<T>(alloc);
+        AlignedFreeUniquePtr<T[]> pe = AllocateAligned<T>(alloc);
+        AlignedFreeUniquePtr<T[]> pb = AllocateAligned<T>(alloc);
+        HWY_ASSERT(pa && pe && pb);
+        for (size_t i = 0; i < count; ++i) {
+          pa[i] = ConvertScalarTo<T>(Random32(&rng) & odd_mask);
+        }
+        const size_t num_expected =
+            static_cast<size_t>(CopyIf(d, pa.get(), count, pe.get(), IsOdd()) -
+                                pe.get());
+        const size_t num_actual = static_cast<size_t>(
+            CopyIf(d, pa.get(), count, pb.get(), IsOdd(), pool) - pb.get());
+        HWY_ASSERT_EQ(num_expected, num_actual);
+        VerifyEqual(pe.get(), pb.get(), num_expected, __LINE__);
+      }
+    }
+  }
+};
+
+void TestAllParallelCopyIf() {
+  ForUI163264(ForPartialVectors<TestParallelCopyIf>());
+}
+
+// Compares reductions with scalar loops, and checks that floating-point results
+// are the same for every call.
+struct TestParallelReductions {
+  template <typename T, class D>
+  HWY_NOINLINE void operator()(T /*unused*/, D d) {
+    ThreadPool pool(HWY_ARCH_WASM ? 0 : 4);
+    RandomState rng;
+    for (size_t count : kCounts) {
+      const size_t alloc = HWY_MAX(1, count);
+      AlignedFreeUniquePtr<T[]> pa = AllocateAligned<T>(alloc);
+      AlignedFreeUniquePtr<T[]> pb = AllocateAligned<T>(alloc);
+      HWY_ASSERT(pa && pb);
+      // Small integers so that sums and dot products are exact.
+      for (size_t i = 0; i < count; ++i) {
+        pa[i] = ConvertScalarTo<T>(Random32(&rng) & 15);
+        pb[i] = ConvertScalarTo<T>(Random32(&rng) & 3);
+      }
+      // Extremes in the last partial vector and the middle.
+      if (count != 0) {
+        pa[count / 2] = ConvertScalarTo<T>(1);
+        pa[count - 1] = ConvertScalarTo<T>(100);
+      }
+
+      double sum = 0.0;
+      double dot = 0.0;
+      T min = GetLane(detail::MinIdentity(d));
+      T max = GetLane(detail::MaxIdentity(d));
+      for (size_t i = 0; i < count; ++i) {
+        sum += ConvertScalarTo<double>(pa[i]);
+        dot += ConvertScalarTo<double>(pa[i]) * ConvertScalarTo<double>(pb[i]);
+        min = HWY_MIN(min, pa[i]);
+        max = HWY_MAX(max, pa[i]);
+      }
+
+      const T actual_sum = ParallelSum(d, pa.get(), count, pool);
+      HWY_ASSERT_EQ(ConvertScalarTo<T>(sum), actual_sum);
+      HWY_ASSERT_EQ(min, ParallelMin(d, pa.get(), count, pool));
+      HWY_ASSERT_EQ(max, ParallelMax(d, pa.get(), count, pool));
+      TestDot(d, pa.get(), pb.get(), count, dot, pool);
+    }
+  }
+
+  template <class D, typename T = TFromD<D>, HWY_IF_FLOAT_D(D)>
+  void TestDot(D d, const T* a, const T* b, size_t count, double expected,
+               ThreadPool& pool) {
+    const T actual = ParallelDot(d, a, b, count, pool);
+    HWY_ASSERT_EQ(ConvertScalarTo<T>(expected), actual);
+
+    // Inexact inputs: results depend on the order of operations, but are the
+    // same for every call with the same pool.
+    AlignedFreeUniquePtr<T[]> in = AllocateAligned<T>(HWY_MAX(1, count));
+    HWY_ASSERT(in);
+    for (size_t i = 0; i < count; ++i) {
+      in[i] = ConvertScalarTo<T>(1.0 / static_cast<double>(i + 3));
+    }
+    const T sum = ParallelSum(d, in.get(), count, pool);
+    const T dot = ParallelDot(d, in.get(), a, count, pool);
+    for (size_t rep = 0; rep < 5; ++rep) {
+      HWY_ASSERT(sum == ParallelSum(d, in.get(), count, pool));
+      HWY_ASSERT(dot == ParallelDot(d, in.get(), a, count, pool));
+    }
+  }
+  template <class D, typename T = TFromD<D>, HWY_IF_NOT_FLOAT_D(D)>
+  void TestDot(D, const T*, const T*, size_t, double, ThreadPool&) {}
+};
+
+void TestAllParallelReductions() {
+  ForPartialVectors<TestParallelReductions> test;
+  test(float());
+  test(int32_t());
+  test(uint64_t());
+#if HWY_HAVE_FLOAT64
+  test(double());
+#endif
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+
+namespace hwy {
+HWY_BEFORE_TEST(ParallelAlgoTest);
+HWY_EXPORT_AND_TEST_P(ParallelAlgoTest, TestAllParallelAlgo);
+HWY_EXPORT_AND_TEST_P(ParallelAlgoTest, TestAllParallelCopyIf);
+HWY_EXPORT_AND_TEST_P(ParallelAlgoTest, TestAllParallelReductions);
+}  // namespace hwy
+
+#endif
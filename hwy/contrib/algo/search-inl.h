@@ -0,0 +1,247 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-target include guard
+#if defined(HIGHWAY_HWY_CONTRIB_ALGO_SEARCH_INL_H_) == \
+    defined(HWY_TARGET_TOGGLE)  // NOLINT
+#ifdef HIGHWAY_HWY_CONTRIB_ALGO_SEARCH_INL_H_
+#undef HIGHWAY_HWY_CONTRIB_ALGO_SEARCH_INL_H_
+#else
+#define HIGHWAY_HWY_CONTRIB_ALGO_SEARCH_INL_H_
+#endif
+
+#include <stddef.h>
+
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+// Batched searches in sorted arrays, for example the output of VQSort. Each
+// vector holds one query per lane, and all lanes perform the same number of
+// steps, so there are no branch mispredictions, and the gathers of the lanes
+// are independent memory accesses. Supports 32 and 64-bit lanes; `num` must be
+// less than LimitsMax<MakeSigned<T>>() because lane indices are of that type.
+
+namespace detail {
+
+// Shared by LowerBound and UpperBound: `kUpper` selects whether the result is
+// the first position whose key is greater than (instead of: not less than) the
+// query. Comparisons are as for operator<, hence unlike VQSort, NaN are not
+// ordered.
+template <bool kUpper, class D, typename T = TFromD<D>>
+HWY_INLINE Vec<RebindToSigned<D>> BranchlessSearch(D d,
+                                                   const T* HWY_RESTRICT sorted,
+                                                   size_t num, Vec<D> queries) {
+  const RebindToSigned<D> di;
+  using TI = TFromD<decltype(di)>;
+  using VI = Vec<decltype(di)>;
+
+  // Invariant: the result is in [base, base + remaining].
+  VI base = Zero(di);
+  size_t remaining = num;
+  while (remaining > 1) {
+    const size_t half = remaining / 2;
+    const Vec<D> probe =
+        GatherIndex(d, sorted, Add(base, Set(di, static_cast<TI>(half - 1))));
+    const Mask<D> right = kUpper ? Not(Lt(queries, probe)) : Lt(probe, queries);
+    base = Add(base, IfThenElseZero(RebindMask(di, right),
+                                    Set(di, static_cast<TI>(half))));
+    remaining -= half;
+  }
+  // `remaining` is 1 (or num is 0, in which case base is 0).
+  if (remaining == 1) {
+    const Vec<D> probe = GatherIndex(d, sorted, base);
+    const Mask<D> right = kUpper ? Not(Lt(queries, probe)) : Lt(probe, queries);
+    base = Sub(base, VecFromMask(di, RebindMask(di, right)));
+  }
+  return base;
+}
+
+template <bool kUpper, class D, typename T = TFromD<D>>
+HWY_INLINE void BatchedSearch(D d, const T* HWY_RESTRICT sorted, size_t num,
+                              const T* HWY_RESTRICT queries, size_t num_queries,
+                              size_t* HWY_RESTRICT out) {
+  const RebindToSigned<D> di;
+  using TI = TFromD<decltype(di)>;
+  HWY_DASSERT(num < static_cast<size_t>(LimitsMax<TI>()));
+  const size_t N = Lanes(d);
+  HWY_ALIGN TI buf[MaxLanes(di)];
+
+  size_t i = 0;
+  if (num_queries >= N) {
+    for (; i <= num_queries - N; i += N) {
+      Store(BranchlessSearch<kUpper>(d, sorted, num, LoadU(d, queries + i)),
+            di, buf);
+      for (size_t j = 0; j < N; ++j) out[i + j] = static_cast<size_t>(buf[j]);
+    }
+  }
+  const size_t remaining = num_queries - i;
+  if (remaining != 0) {
+    const Vec<D> v = LoadN(d, queries + i, remaining);
+    Store(BranchlessSearch<kUpper>(d, sorted, num, v), di, buf);
+    for (size_t j = 0; j < remaining; ++j) {
+      out[i + j] = static_cast<size_t>(buf[j]);
+    }
+  }
+}
+
+}  // namespace detail
+
+// For each i < num_queries, sets out[i] to the index of the first element of
+// sorted[0, num) that is not less than queries[i], or num if there is none.
+// Equivalent to std::lower_bound. `sorted` must be in ascending order.
+template <class D, typename T = TFromD<D>,
+          HWY_IF_T_SIZE_ONE_OF_D(D, (1 << 4) | (1 << 8))>
+void LowerBound(D d, const T* HWY_RESTRICT sorted, size_t num,
+                const T* HWY_RESTRICT queries, size_t num_queries,
+                size_t* HWY_RESTRICT out) {
+  detail::BatchedSearch</*kUpper=*/false>(d, sorted, num, queries, num_queries,
+                                          out);
+}
+
+// As LowerBound, but returns the index of the first element greater than
+// queries[i]. Equivalent to std::upper_bound.
+template <class D, typename T = TFromD<D>,
+          HWY_IF_T_SIZE_ONE_OF_D(D, (1 << 4) | (1 << 8))>
+void UpperBound(D d, const T* HWY_RESTRICT sorted, size_t num,
+                const T* HWY_RESTRICT queries, size_t num_queries,
+                size_t* HWY_RESTRICT out) {
+  detail::BatchedSearch</*kUpper=*/true>(d, sorted, num, queries, num_queries,
+                                         out);
+}
+
+// ------------------------------ Eytzinger layout
+
+// Binary search in a sorted array touches a different cache line in most steps.
+// The Eytzinger (BFS) layout stores the implicit search tree level by level:
+// the children of layout[k] are layout[2k] and layout[2k + 1]. The top levels
+// then occupy only a few cache lines, which remain cached across queries. This
+// is faster for arrays that do not fit in L2, at the cost of a copy.
+
+namespace detail {
+
+// Recursive in-order traversal of the tree rooted at 1-based index `k`.
+template <typename T>
+size_t FillEytzinger(const T* HWY_RESTRICT sorted, size_t num, size_t pos,
+                     size_t k, T* HWY_RESTRICT layout) {
+  if (k <= num) {
+    pos = FillEytzinger(sorted, num, pos, 2 * k, layout);
+    layout[k] = sorted[pos++];
+    pos = FillEytzinger(sorted, num, pos, 2 * k + 1, layout);
+  }
+  return pos;
+}
+
+// Returns the index within the sorted array of the element at 1-based index
+// `k` in the Eytzinger layout of `num` elements, or num if k is 0.
+static HWY_INLINE size_t EytzingerToSorted(size_t k, size_t num) {
+  if (k == 0) return num;
+  // The complete tree of depth `max_depth` has 2^(max_depth + 1) - 1 slots; the
+  // bottom level holds the `num_bottom` leftmost of them.
+  const size_t max_depth = 63 - Num0BitsAboveMS1Bit_Nonzero64(num);
+  const size_t depth = 63 - Num0BitsAboveMS1Bit_Nonzero64(k);
+  const size_t num_bottom = num - ((size_t{1} << max_depth) - 1);
+  // In-order position within the complete tree. Bottom-level slots are at even
+  // positions; subtract the missing ones to the left of k.
+  const size_t pos = ((2 * (k - (size_t{1} << depth)) + 1)
+                      << (max_depth - depth)) -
+                     1;
+  return (pos > 2 * num_bottom) ? pos - (pos - 2 * num_bottom + 1) / 2 : pos;
+}
+
+template <bool kUpper, class D, typename T = TFromD<D>>
+HWY_INLINE void BatchedSearchEytzinger(D d, const T* HWY_RESTRICT layout,
+                                       size_t num,
+                                       const T* HWY_RESTRICT queries,
+                                       size_t num_queries,
+                                       size_t* HWY_RESTRICT out) {
+  const RebindToSigned<D> di;
+  using TI = TFromD<decltype(di)>;
+  using VI = Vec<decltype(di)>;
+  HWY_DASSERT(num < static_cast<size_t>(LimitsMax<TI>()) / 2);
+  const size_t N = Lanes(d);
+  HWY_ALIGN TI buf[MaxLanes(di)];
+  const size_t levels =
+      num == 0 ? 0 : 64 - Num0BitsAboveMS1Bit_Nonzero64(num);
+  const VI vnum = Set(di, static_cast<TI>(num));
+  const VI k1 = Set(di, TI{1});
+
+  for (size_t i = 0; i < num_queries; i += N) {
+    const size_t count = HWY_MIN(N, num_queries - i);
+    const Vec<D> q = LoadN(d, queries + i, count);
+    // Descend: k = 2k + (layout[k] < q). All lanes take `levels` steps except
+    // those already past the bottom level, which keep k.
+    VI k = k1;
+    for (size_t level = 0; level < levels; ++level) {
+      const Mask<decltype(di)> valid = Le(k, vnum);
+      const Vec<D> node = MaskedGatherIndex(RebindMask(d, valid), d, layout, k);
+      const Mask<D> right = kUpper ? Not(Lt(q, node)) : Lt(node, q);
+      // VecFromMask is -1 where true, hence subtract it to add 1.
+      const VI child = Sub(Add(k, k), VecFromMask(di, RebindMask(di, right)));
+      k = IfThenElse(valid, child, k);
+    }
+    Store(k, di, buf);
+    for (size_t j = 0; j < count; ++j) {
+      // The last left turn leads to the result: strip the trailing 1-bits
+      // (right turns) and the 0-bit (left turn).
+      const uint64_t bits = static_cast<uint64_t>(buf[j]);
+      const size_t result = static_cast<size_t>(
+          bits >> (Num0BitsBelowLS1Bit_Nonzero64(~bits) + 1));
+      out[i + j] = EytzingerToSorted(result, num);
+    }
+  }
+}
+
+}  // namespace detail
+
+// Writes the Eytzinger layout of sorted[0, num) to layout[1, num]; layout[0]
+// is unused. `layout` must have num + 1 elements.
+template <typename T>
+void BuildEytzinger(const T* HWY_RESTRICT sorted, size_t num,
+                    T* HWY_RESTRICT layout) {
+  layout[0] = T();
+  detail::FillEytzinger(sorted, num, 0, 1, layout);
+}
+
+// Same results as LowerBound, i.e. indices into the sorted array, but searches
+// `layout` as written by BuildEytzinger.
+template <class D, typename T = TFromD<D>,
+          HWY_IF_T_SIZE_ONE_OF_D(D, (1 << 4) | (1 << 8))>
+void LowerBoundEytzinger(D d, const T* HWY_RESTRICT layout, size_t num,
+                         const T* HWY_RESTRICT queries, size_t num_queries,
+                         size_t* HWY_RESTRICT out) {
+  detail::BatchedSearchEytzinger</*kUpper=*/false>(d, layout, num, queries,
+                                                   num_queries, out);
+}
+
+// Same results as UpperBound, but searches `layout` as written by
+// BuildEytzinger.
+template <class D, typename T = TFromD<D>,
+          HWY_IF_T_SIZE_ONE_OF_D(D, (1 << 4) | (1 << 8))>
+void UpperBoundEytzinger(D d, const T* HWY_RESTRICT layout, size_t num,
+                         const T* HWY_RESTRICT queries, size_t num_queries,
+                         size_t* HWY_RESTRICT out) {
+  detail::BatchedSearchEytzinger</*kUpper=*/true>(d, layout, num, queries,
+                                                  num_queries, out);
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_ALGO_SEARCH_INL_H_
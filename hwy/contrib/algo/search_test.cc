@@ -0,0 +1,132 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+
+#include <algorithm>  // std::lower_bound
+#include <vector>
+
+#include "hwy/base.h"
+
+// clang-format off
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "hwy/contrib/algo/search_test.cc"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+#include "hwy/highway.h"
+#include "hwy/contrib/algo/search-inl.h"
+#include "hwy/tests/test_util-inl.h"
+// clang-format on
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+// Few distinct values so that there are many duplicates, plus queries below
+// and above all of them.
+template <typename T>
+T RandomSearchValue(RandomState& rng) {
+  const int32_t bits = static_cast<int32_t>(Random32(&rng) & 255);
+  const int32_t val = IsSigned<T>() ? bits - 128 : bits;
+  return ConvertScalarTo<T>(val);
+}
+
+template <typename T>
+void VerifySearch(const std::vector<size_t>& expected,
+                  const std::vector<size_t>& actual, const T* queries,
+                  size_t num, const char* caller, size_t N) {
+  for (size_t i = 0; i < expected.size(); ++i) {
+    if (expected[i] != actual[i]) {
+      fprintf(stderr, "%s %s num %d: query %f at %d expected %d actual %d\n",
+              caller, hwy::TypeName(T(), N).c_str(), static_cast<int>(num),
+              ConvertScalarTo<double>(queries[i]), static_cast<int>(i),
+              static_cast<int>(expected[i]), static_cast<int>(actual[i]));
+      HWY_ASSERT(false);
+    }
+  }
+}
+
+struct TestSearch {
+  template <typename T, class D>
+  HWY_NOINLINE void operator()(T /*unused*/, D d) {
+    RandomState rng;
+    const size_t N = Lanes(d);
+    for (size_t num : {size_t{0}, size_t{1}, size_t{2}, size_t{3}, size_t{7},
+                       size_t{8}, size_t{100}, AdjustedReps(5000)}) {
+      std::vector<T> sorted(num);
+      for (T& x : sorted) x = RandomSearchValue<T>(rng);
+      std::sort(sorted.begin(), sorted.end());
+
+      for (size_t num_queries : {size_t{1}, N - 1, 3 * N + 1, size_t{300}}) {
+        std::vector<T> queries(num_queries);
+        for (T& q : queries) {
+          q = (Random32(&rng) & 7) == 0
+                  ? ConvertScalarTo<T>(IsSigned<T>() ? -200 : 0)
+                  : RandomSearchValue<T>(rng);
+        }
+        if (num_queries != 0 && (Random32(&rng) & 3) == 0) {
+          queries[0] = ConvertScalarTo<T>(300);
+        }
+
+        std::vector<size_t> lower(num_queries), upper(num_queries);
+        for (size_t i = 0; i < num_queries; ++i) {
+          lower[i] = static_cast<size_t>(
+              std::lower_bound(sorted.begin(), sorted.end(), queries[i]) -
+              sorted.begin());
+          upper[i] = static_cast<size_t>(
+              std::upper_bound(sorted.begin(), sorted.end(), queries[i]) -
+              sorted.begin());
+        }
+
+        std::vector<size_t> actual(num_queries);
+        LowerBound(d, sorted.data(), num, queries.data(), num_queries,
+                   actual.data());
+        VerifySearch(lower, actual, queries.data(), num, "LowerBound", N);
+        UpperBound(d, sorted.data(), num, queries.data(), num_queries,
+                   actual.data());
+        VerifySearch(upper, actual, queries.data(), num, "UpperBound", N);
+
+        std::vector<T> layout(num + 1);
+        BuildEytzinger(sorted.data(), num, layout.data());
+        LowerBoundEytzinger(d, layout.data(), num, queries.data(), num_queries,
+                            actual.data());
+        VerifySearch(lower, actual, queries.data(), num, "LowerBoundEytzinger",
+                     N);
+        UpperBoundEytzinger(d, layout.data(), num, queries.data(), num_queries,
+                            actual.data());
+        VerifySearch(upper, actual, queries.data(), num, "UpperBoundEytzinger",
+                     N);
+      }
+    }
+  }
+};
+
+void TestAllSearch() {
+  ForUI3264(ForPartialVectors<TestSearch>());
+  ForFloat3264Types(ForPartialVectors<TestSearch>());
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+
+namespace hwy {
+HWY_BEFORE_TEST(SearchTest);
+HWY_EXPORT_AND_TEST_P(SearchTest, TestAllSearch);
+}  // namespace hwy
+
+#endif
@@ -0,0 +1,269 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-target include guard
+#if defined(HIGHWAY_HWY_CONTRIB_ALGO_SET_OPS_INL_H_) == \
+    defined(HWY_TARGET_TOGGLE)  // NOLINT
+#ifdef HIGHWAY_HWY_CONTRIB_ALGO_SET_OPS_INL_H_
+#undef HIGHWAY_HWY_CONTRIB_ALGO_SET_OPS_INL_H_
+#else
+#define HIGHWAY_HWY_CONTRIB_ALGO_SET_OPS_INL_H_
+#endif
+
+#include <stddef.h>
+
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+// Set operations on sorted arrays without duplicates, for example posting
+// lists or the output of VQSort followed by Unique. Each writes the result,
+// which is also sorted, to `out` and returns the number of elements written.
+// `out` must not overlap the inputs and have space for `num_a` (intersection
+// and difference) or `num_a + num_b` (union) elements. Equivalent to
+// std::set_intersection etc., but faster if the inputs are of similar size,
+// in which case we compare vectors of `a` with all lanes of the corresponding
+// vector of `b`, or if one input is much smaller than the other, in which
+// case we search for each of its elements by galloping over the larger one.
+//
+// NOTE: this is only supported for 16-, 32- or 64-bit types, typically
+// unsigned integers. NaN are not supported.
+
+namespace detail {
+
+// Use galloping if one input is at least this many times larger.
+constexpr size_t kSetOpsGallopRatio = 32;
+
+// Returns the index of the first element of `sorted`[begin, num) that is not
+// less than `key`, or `num` if there is none. Galloping (doubling the step)
+// is faster than binary search if the result is likely close to `begin`. The
+// last step checks up to one vector of candidates at once.
+template <class D, typename T = TFromD<D>>
+HWY_INLINE size_t GallopLowerBound(D d, const T* HWY_RESTRICT sorted,
+                                   size_t begin, size_t num, T key) {
+  const size_t N = Lanes(d);
+  // Invariant: all of sorted[begin, lo) are less than key.
+  size_t lo = begin;
+  size_t step = 1;
+  while (lo + step <= num && sorted[lo + step - 1] < key) {
+    lo += step;
+    step *= 2;
+  }
+  // The result is in [lo, hi].
+  size_t hi = HWY_MIN(lo + step, num);
+  while (hi - lo > N) {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (sorted[mid] < key) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  const size_t remaining = hi - lo;
+  const Vec<D> v = LoadN(d, sorted + lo, remaining);
+  const Mask<D> less = And(FirstN(d, remaining), Lt(v, Set(d, key)));
+  return lo + CountTrue(d, less);
+}
+
+// Copies `num` elements from `from` to `to` and returns `num`.
+template <typename T>
+HWY_INLINE size_t CopyRange(const T* HWY_RESTRICT from, size_t num,
+                            T* HWY_RESTRICT to) {
+  if (num != 0) CopyBytes(from, to, num * sizeof(T));
+  return num;
+}
+
+// Returns a mask of the lanes of `va` that equal any of b[0, N). Comparing
+// against broadcasts of each element of `b` is cheaper than rotating a vector
+// of `b` on most targets, and also works for scalable vectors.
+template <class D, typename T = TFromD<D>>
+HWY_INLINE Mask<D> MatchAny(D d, Vec<D> va, const T* HWY_RESTRICT b) {
+  const size_t N = Lanes(d);
+  Mask<D> match = Eq(va, Set(d, b[0]));
+  for (size_t k = 1; k < N; ++k) {
+    match = Or(match, Eq(va, Set(d, b[k])));
+  }
+  return match;
+}
+
+// Shared by SetIntersection and SetDifference: compares whole vectors of both
+// inputs and writes the lanes of `a` that do (`kKeepMatches`) or do not occur
+// in `b`. Returns the number written and updates `i` and `j` to the first
+// element of `a` and `b` not yet handled.
+template <bool kKeepMatches, class D, typename T = TFromD<D>>
+HWY_INLINE size_t BlockSetOp(D d, const T* HWY_RESTRICT a, size_t num_a,
+                             const T* HWY_RESTRICT b, size_t num_b,
+                             T* HWY_RESTRICT out, size_t& i, size_t& j) {
+  const size_t N = Lanes(d);
+  size_t num_out = 0;
+  if (num_a < N || num_b < N) return num_out;
+
+  // Lanes of the current vector of `a` that occur in any vector of `b` seen so
+  // far. Because the inputs are strictly increasing, advancing past the vector
+  // with the smaller maximum ensures all overlapping pairs are compared.
+  Mask<D> match = MaskFalse(d);
+  while (i + N <= num_a && j + N <= num_b) {
+    const Vec<D> va = LoadU(d, a + i);
+    match = Or(match, MatchAny(d, va, b + j));
+    const T max_a = a[i + N - 1];
+    const T max_b = b[j + N - 1];
+    if (!(max_b < max_a)) {
+      const Mask<D> keep = kKeepMatches ? match : Not(match);
+      num_out += CompressBlendedStore(va, keep, d, out + num_out);
+      match = MaskFalse(d);
+      i += N;
+    }
+    if (!(max_a < max_b)) j += N;
+  }
+
+  // `b` has less than a vector left, but the current vector of `a` may have
+  // been partially compared. Its lanes less than b[j] are final; the caller
+  // handles the others.
+  if (i + N <= num_a) {
+    const Vec<D> va = LoadU(d, a + i);
+    Mask<D> done = FirstN(d, N);
+    if (j != num_b) done = Lt(va, Set(d, b[j]));
+    const Mask<D> keep = And(done, kKeepMatches ? match : Not(match));
+    num_out += CompressBlendedStore(va, keep, d, out + num_out);
+    i += CountTrue(d, done);
+  }
+  return num_out;
+}
+
+}  // namespace detail
+
+template <class D, typename T = TFromD<D>>
+size_t SetIntersection(D d, const T* HWY_RESTRICT a, size_t num_a,
+                       const T* HWY_RESTRICT b, size_t num_b,
+                       T* HWY_RESTRICT out) {
+  // The result is symmetric, so gallop over the larger input.
+  if (num_a > num_b) return SetIntersection(d, b, num_b, a, num_a, out);
+
+  size_t num_out = 0;
+  if (num_b >= detail::kSetOpsGallopRatio * num_a) {
+    size_t j = 0;
+    for (size_t i = 0; i < num_a; ++i) {
+      j = detail::GallopLowerBound(d, b, j, num_b, a[i]);
+      if (j == num_b) break;
+      if (b[j] == a[i]) out[num_out++] = a[i];
+    }
+    return num_out;
+  }
+
+  size_t i = 0;
+  size_t j = 0;
+  num_out = detail::BlockSetOp</*kKeepMatches=*/true>(d, a, num_a, b, num_b,
+                                                      out, i, j);
+  while (i < num_a && j < num_b) {
+    const T x = a[i];
+    const T y = b[j];
+    if (x == y) out[num_out++] = x;
+    i += !(y < x);
+    j += !(x < y);
+  }
+  return num_out;
+}
+
+// Writes the elements of `a` that do not occur in `b`.
+template <class D, typename T = TFromD<D>>
+size_t SetDifference(D d, const T* HWY_RESTRICT a, size_t num_a,
+                     const T* HWY_RESTRICT b, size_t num_b,
+                     T* HWY_RESTRICT out) {
+  size_t num_out = 0;
+  size_t i = 0;
+  size_t j = 0;
+  if (num_b >= detail::kSetOpsGallopRatio * num_a) {
+    for (; i < num_a; ++i) {
+      j = detail::GallopLowerBound(d, b, j, num_b, a[i]);
+      if (j == num_b) break;
+      if (b[j] != a[i]) out[num_out++] = a[i];
+    }
+  } else if (num_a >= detail::kSetOpsGallopRatio * num_b) {
+    // Copy the ranges of `a` between elements of `b`.
+    for (; j < num_b; ++j) {
+      const size_t end = detail::GallopLowerBound(d, a, i, num_a, b[j]);
+      num_out += detail::CopyRange(a + i, end - i, out + num_out);
+      i = end;
+      if (i == num_a) break;
+      i += (a[i] == b[j]);
+    }
+  } else {
+    num_out = detail::BlockSetOp</*kKeepMatches=*/false>(d, a, num_a, b, num_b,
+                                                         out, i, j);
+    while (i < num_a && j < num_b) {
+      const T x = a[i];
+      const T y = b[j];
+      if (x < y) out[num_out++] = x;
+      i += !(y < x);
+      j += !(x < y);
+    }
+  }
+  return num_out + detail::CopyRange(a + i, num_a - i, out + num_out);
+}
+
+template <class D, typename T = TFromD<D>>
+size_t SetUnion(D d, const T* HWY_RESTRICT a, size_t num_a,
+                const T* HWY_RESTRICT b, size_t num_b, T* HWY_RESTRICT out) {
+  // The result is symmetric, so gallop over the larger input.
+  if (num_a < num_b) return SetUnion(d, b, num_b, a, num_a, out);
+
+  const size_t N = Lanes(d);
+  size_t num_out = 0;
+  size_t i = 0;
+  size_t j = 0;
+  if (num_a >= detail::kSetOpsGallopRatio * num_b) {
+    // Copy the ranges of `a` between elements of `b`, which are inserted.
+    for (; j < num_b; ++j) {
+      const size_t end = detail::GallopLowerBound(d, a, i, num_a, b[j]);
+      num_out += detail::CopyRange(a + i, end - i, out + num_out);
+      i = end;
+      out[num_out++] = b[j];
+      i += (i != num_a && a[i] == b[j]);
+    }
+  } else {
+    // Merge, but copy an entire vector if it precedes the other input's next
+    // element, which is common for clustered inputs.
+    while (i < num_a && j < num_b) {
+      if (i + N <= num_a && a[i + N - 1] < b[j]) {
+        StoreU(LoadU(d, a + i), d, out + num_out);
+        num_out += N;
+        i += N;
+        continue;
+      }
+      if (j + N <= num_b && b[j + N - 1] < a[i]) {
+        StoreU(LoadU(d, b + j), d, out + num_out);
+        num_out += N;
+        j += N;
+        continue;
+      }
+      const T x = a[i];
+      const T y = b[j];
+      out[num_out++] = (y < x) ? y : x;
+      i += !(y < x);
+      j += !(x < y);
+    }
+  }
+  num_out += detail::CopyRange(a + i, num_a - i, out + num_out);
+  return num_out + detail::CopyRange(b + j, num_b - j, out + num_out);
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_ALGO_SET_OPS_INL_H_
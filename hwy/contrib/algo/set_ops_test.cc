@@ -0,0 +1,109 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+
+#include <algorithm>  // std::set_intersection
+#include <iterator>   // std::back_inserter
+#include <vector>
+
+#include "hwy/base.h"
+
+// clang-format off
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "hwy/contrib/algo/set_ops_test.cc"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+#include "hwy/highway.h"
+#include "hwy/contrib/algo/set_ops-inl.h"
+#include "hwy/tests/test_util-inl.h"
+// clang-format on
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+// Returns `num` strictly increasing values. Each is one more than its
+// predecessor with probability 1/`max_gap`, so that the inputs overlap.
+template <typename T>
+std::vector<T> RandomSet(RandomState& rng, size_t num, uint32_t max_gap) {
+  std::vector<T> set(num);
+  int64_t val = IsSigned<T>() ? -1000 : 0;
+  for (T& x : set) {
+    val += 1 + static_cast<int64_t>(Random32(&rng) % max_gap);
+    x = ConvertScalarTo<T>(val);
+  }
+  return set;
+}
+
+struct TestSetOps {
+  template <typename T, class D>
+  HWY_NOINLINE void operator()(T /*unused*/, D d) {
+    RandomState rng;
+    const size_t N = Lanes(d);
+    // Also includes very different sizes, which use galloping.
+    const size_t sizes[] = {0, 1, N - 1, N, 3 * N + 1, 100, AdjustedReps(3000)};
+    for (size_t num_a : sizes) {
+      for (size_t num_b : sizes) {
+        for (uint32_t max_gap : {1u, 2u, 4u}) {
+          // Unsigned 16-bit values must not wrap around.
+          if (sizeof(T) == 2 && (num_a + num_b) * max_gap > 30000) continue;
+          const std::vector<T> a = RandomSet<T>(rng, num_a, max_gap);
+          const std::vector<T> b = RandomSet<T>(rng, num_b, max_gap);
+          std::vector<T> out(num_a + num_b);
+
+          std::vector<T> expected;
+          std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                                std::back_inserter(expected));
+          size_t num = SetIntersection(d, a.data(), num_a, b.data(), num_b,
+                                       out.data());
+          HWY_ASSERT_EQ(expected.size(), num);
+          HWY_ASSERT_ARRAY_EQ(expected.data(), out.data(), num);
+
+          expected.clear();
+          std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                              std::back_inserter(expected));
+          num = SetDifference(d, a.data(), num_a, b.data(), num_b, out.data());
+          HWY_ASSERT_EQ(expected.size(), num);
+          HWY_ASSERT_ARRAY_EQ(expected.data(), out.data(), num);
+
+          expected.clear();
+          std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                         std::back_inserter(expected));
+          num = SetUnion(d, a.data(), num_a, b.data(), num_b, out.data());
+          HWY_ASSERT_EQ(expected.size(), num);
+          HWY_ASSERT_ARRAY_EQ(expected.data(), out.data(), num);
+        }
+      }
+    }
+  }
+};
+
+void TestAllSetOps() {
+  ForUI163264(ForPartialVectors<TestSetOps>());
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+
+namespace hwy {
+HWY_BEFORE_TEST(SetOpsTest);
+HWY_EXPORT_AND_TEST_P(SetOpsTest, TestAllSetOps);
+}  // namespace hwy
+
+#endif
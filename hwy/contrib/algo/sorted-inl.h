@@ -0,0 +1,191 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-target include guard
+#if defined(HIGHWAY_HWY_CONTRIB_ALGO_SORTED_INL_H_) == \
+    defined(HWY_TARGET_TOGGLE)  // NOLINT
+#ifdef HIGHWAY_HWY_CONTRIB_ALGO_SORTED_INL_H_
+#undef HIGHWAY_HWY_CONTRIB_ALGO_SORTED_INL_H_
+#else
+#define HIGHWAY_HWY_CONTRIB_ALGO_SORTED_INL_H_
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hwy/contrib/algo/find-inl.h"
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+// Vectorized equivalents of std::is_sorted_until, std::is_sorted and
+// std::is_partitioned. The optional `func(d, cur, prev)` returns a mask of the
+// lanes in which `cur` must not follow `prev`; the default is Lt, i.e.
+// ascending order; a functor returning Gt(cur, prev) checks for descending
+// order. As with std::less, NaN are never considered out of order.
+
+namespace detail {
+
+struct SortedLt {
+  template <class D, class V>
+  Mask<D> operator()(D /*d*/, V cur, V prev) const {
+    return Lt(cur, prev);
+  }
+};
+
+#if HWY_TARGET != HWY_SCALAR
+struct SortedLt128 {
+  template <class D, class V>
+  Mask<D> operator()(D d, V cur, V prev) const {
+    return Lt128(d, cur, prev);
+  }
+};
+#endif
+
+template <class Func>
+class NotFunc {
+ public:
+  explicit NotFunc(const Func& func) : func_(func) {}
+  template <class D, class V>
+  Mask<D> operator()(D d, V v) const {
+    return Not(func_(d, v));
+  }
+
+ private:
+  const Func& func_;
+};
+
+// Returns the index of the first element in `in`[`i`, `count`) for which
+// `func(d, in[idx], in[idx - 1])` is true, otherwise `count`. `kStep` is 1 for
+// keys that occupy a single lane, or 2 for 128-bit keys, in which case `func`
+// must set the mask for both lanes of a key, and all indices are lanes.
+template <size_t kStep, class D, class Func, typename T = TFromD<D>>
+HWY_INLINE size_t FirstOutOfOrder(D d, const T* HWY_RESTRICT in, size_t i,
+                                  size_t count, const Func& func) {
+  const size_t N = Lanes(d);
+
+  // Unrolled for memory bandwidth; the single-vector loop below determines the
+  // exact position.
+  if (count >= 4 * N + kStep) {
+    for (; i <= count - 4 * N; i += 4 * N) {
+      const T* HWY_RESTRICT pos = in + i;
+      const Mask<D> m0 = func(d, LoadU(d, pos), LoadU(d, pos - kStep));
+      const Mask<D> m1 =
+          func(d, LoadU(d, pos + N), LoadU(d, pos + N - kStep));
+      const Mask<D> m2 =
+          func(d, LoadU(d, pos + 2 * N), LoadU(d, pos + 2 * N - kStep));
+      const Mask<D> m3 =
+          func(d, LoadU(d, pos + 3 * N), LoadU(d, pos + 3 * N - kStep));
+      if (HWY_UNLIKELY(!AllFalse(d, Or(Or(m0, m1), Or(m2, m3))))) break;
+    }
+  }
+
+  if (count >= N + kStep) {
+    for (; i <= count - N; i += N) {
+      const Mask<D> m = func(d, LoadU(d, in + i), LoadU(d, in + i - kStep));
+      const intptr_t pos = FindFirstTrue(d, m);
+      if (pos >= 0) return i + static_cast<size_t>(pos);
+    }
+  }
+
+  if (i == count) return count;
+  const size_t remaining = count - i;
+  HWY_DASSERT(0 != remaining && remaining < N);
+  const Vec<D> v = LoadN(d, in + i, remaining);
+  const Vec<D> prev = LoadN(d, in + i - kStep, remaining);
+  const intptr_t pos =
+      FindFirstTrue(d, And(FirstN(d, remaining), func(d, v, prev)));
+  return (pos >= 0) ? i + static_cast<size_t>(pos) : count;
+}
+
+}  // namespace detail
+
+// Returns the index of the first element of `in`[0, `count`) that is ordered
+// before its predecessor according to `func`, otherwise `count`.
+template <class D, class Func, typename T = TFromD<D>>
+size_t IsSortedUntil(D d, const T* HWY_RESTRICT in, size_t count,
+                     const Func& func) {
+  if (count < 2) return count;
+  return detail::FirstOutOfOrder<1>(d, in, 1, count, func);
+}
+
+template <class D, typename T = TFromD<D>>
+size_t IsSortedUntil(D d, const T* HWY_RESTRICT in, size_t count) {
+  return IsSortedUntil(d, in, count, detail::SortedLt());
+}
+
+template <class D, class Func, typename T = TFromD<D>>
+bool IsSorted(D d, const T* HWY_RESTRICT in, size_t count, const Func& func) {
+  return IsSortedUntil(d, in, count, func) == count;
+}
+
+template <class D, typename T = TFromD<D>>
+bool IsSorted(D d, const T* HWY_RESTRICT in, size_t count) {
+  return IsSortedUntil(d, in, count) == count;
+}
+
+#if HWY_TARGET != HWY_SCALAR
+
+// 128-bit keys, each stored as two u64 lanes with the lower half first, as in
+// hwy::uint128_t. `num_keys` and the return value are in units of keys. The
+// default `func` is Lt128; a functor returning Lt128Upper only compares the
+// upper halves, as for K64V64. `func` must set the mask in both lanes of a key,
+// hence `d` must have at least two lanes.
+template <class D, class Func, HWY_IF_U64_D(D)>
+size_t IsSortedUntil128(D d, const uint64_t* HWY_RESTRICT keys,
+                        size_t num_keys, const Func& func) {
+  if (num_keys < 2) return num_keys;
+  const size_t num_lanes = 2 * num_keys;
+  return detail::FirstOutOfOrder<2>(d, keys, 2, num_lanes, func) / 2;
+}
+
+template <class D, HWY_IF_U64_D(D)>
+size_t IsSortedUntil128(D d, const uint64_t* HWY_RESTRICT keys,
+                        size_t num_keys) {
+  return IsSortedUntil128(d, keys, num_keys, detail::SortedLt128());
+}
+
+template <class D, class Func, HWY_IF_U64_D(D)>
+bool IsSorted128(D d, const uint64_t* HWY_RESTRICT keys, size_t num_keys,
+                 const Func& func) {
+  return IsSortedUntil128(d, keys, num_keys, func) == num_keys;
+}
+
+template <class D, HWY_IF_U64_D(D)>
+bool IsSorted128(D d, const uint64_t* HWY_RESTRICT keys, size_t num_keys) {
+  return IsSortedUntil128(d, keys, num_keys) == num_keys;
+}
+
+#endif  // HWY_TARGET != HWY_SCALAR
+
+// Returns whether all elements of `in`[0, `count`) for which `func(d, vec)`
+// returns true precede all of those for which it returns false.
+template <class D, class Func, typename T = TFromD<D>>
+bool IsPartitioned(D d, const T* HWY_RESTRICT in, size_t count,
+                   const Func& func) {
+  const size_t first_false = FindIf(d, in, count, detail::NotFunc<Func>(func));
+  if (first_false == count) return true;
+  const size_t remaining = count - first_false;
+  return FindIf(d, in + first_false, remaining, func) == remaining;
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_ALGO_SORTED_INL_H_
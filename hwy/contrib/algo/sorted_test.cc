@@ -0,0 +1,207 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>  // std::is_sorted_until, std::is_partitioned
+#include <vector>
+
+#include "hwy/base.h"
+
+// clang-format off
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "hwy/contrib/algo/sorted_test.cc"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+#include "hwy/highway.h"
+#include "hwy/contrib/algo/sorted-inl.h"
+#include "hwy/tests/test_util-inl.h"
+// clang-format on
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+// Functors rather than generic lambdas for C++11 compatibility.
+struct Descending {
+  template <class D, class V>
+  Mask<D> operator()(D /*d*/, V cur, V prev) const {
+    return Gt(cur, prev);
+  }
+};
+
+class LessThan {
+ public:
+  explicit LessThan(int val) : val_(val) {}
+  template <class D, class V>
+  Mask<D> operator()(D d, V v) const {
+    return Lt(v, Set(d, ConvertScalarTo<TFromD<D>>(val_)));
+  }
+
+ private:
+  int val_;
+};
+
+// Random values in [-64, 64), or [0, 64) for unsigned types.
+template <typename T>
+std::vector<T> RandomValues(RandomState& rng, size_t count) {
+  std::vector<T> values(count);
+  for (T& value : values) {
+    int32_t val = static_cast<int32_t>(Random32(&rng) & 127) - 64;
+    if (!IsSigned<T>() && val < 0) val = -val - 1;
+    value = ConvertScalarTo<T>(val);
+  }
+  return values;
+}
+
+std::vector<size_t> CountsForTest(size_t N) {
+  return {size_t{0}, size_t{1}, size_t{2}, N - 1,     N,
+          N + 1,     4 * N,     4 * N + 1, 5 * N + 3, AdjustedReps(1000)};
+}
+
+struct TestIsSorted {
+  template <typename T, class D>
+  HWY_NOINLINE void operator()(T /*unused*/, D d) {
+    RandomState rng;
+    const size_t N = Lanes(d);
+    for (size_t count : CountsForTest(N)) {
+      std::vector<T> keys = RandomValues<T>(rng, count);
+      std::sort(keys.begin(), keys.end());
+      HWY_ASSERT_EQ(count, IsSortedUntil(d, keys.data(), count));
+      HWY_ASSERT(IsSorted(d, keys.data(), count));
+
+      std::vector<T> reversed(keys.rbegin(), keys.rend());
+      HWY_ASSERT(IsSorted(d, reversed.data(), count, Descending()));
+      const size_t expected_rev =
+          static_cast<size_t>(std::is_sorted_until(reversed.begin(),
+                                                   reversed.end()) -
+                              reversed.begin());
+      HWY_ASSERT_EQ(expected_rev, IsSortedUntil(d, reversed.data(), count));
+
+      if (count < 2) continue;
+      // Make a key larger than its successor at various positions.
+      for (size_t pos : {size_t{1}, count / 2, count - 1}) {
+        std::vector<T> copy = keys;
+        copy[pos - 1] = ConvertScalarTo<T>(100);
+        HWY_ASSERT_EQ(pos, IsSortedUntil(d, copy.data(), count));
+        HWY_ASSERT(!IsSorted(d, copy.data(), count));
+      }
+
+      // Unsorted input.
+      keys = RandomValues<T>(rng, count);
+      const size_t expected = static_cast<size_t>(
+          std::is_sorted_until(keys.begin(), keys.end()) - keys.begin());
+      HWY_ASSERT_EQ(expected, IsSortedUntil(d, keys.data(), count));
+    }
+  }
+};
+
+void TestAllIsSorted() {
+  ForUI163264(ForPartialVectors<TestIsSorted>());
+  ForFloat3264Types(ForPartialVectors<TestIsSorted>());
+}
+
+struct TestIsSorted128 {
+  template <typename T, class D>
+  HWY_NOINLINE void operator()(T /*unused*/, D d) {
+#if HWY_TARGET != HWY_SCALAR
+    RandomState rng;
+    const size_t N = Lanes(d);
+    for (size_t num_keys : CountsForTest(N)) {
+      std::vector<uint128_t> keys(num_keys);
+      for (uint128_t& key : keys) {
+        // Few distinct upper halves so that the lower halves matter.
+        key.hi = Random64(&rng) & 3;
+        key.lo = Random64(&rng);
+      }
+      std::sort(keys.begin(), keys.end());
+      const uint64_t* lanes = reinterpret_cast<const uint64_t*>(keys.data());
+      HWY_ASSERT_EQ(num_keys, IsSortedUntil128(d, lanes, num_keys));
+      HWY_ASSERT(IsSorted128(d, lanes, num_keys));
+
+      if (num_keys < 2) continue;
+      for (size_t pos : {size_t{1}, num_keys / 2, num_keys - 1}) {
+        std::vector<uint128_t> copy = keys;
+        // Same upper half, smaller lower half than the predecessor.
+        copy[pos] = copy[pos - 1];
+        copy[pos - 1].lo |= 1;
+        copy[pos].lo = copy[pos - 1].lo - 1;
+        lanes = reinterpret_cast<const uint64_t*>(copy.data());
+        HWY_ASSERT_EQ(pos, IsSortedUntil128(d, lanes, num_keys));
+        HWY_ASSERT(!IsSorted128(d, lanes, num_keys));
+      }
+    }
+#else
+    (void)d;
+#endif
+  }
+};
+
+void TestAllIsSorted128() {
+  ForGEVectors<128, TestIsSorted128>()(uint64_t());
+}
+
+struct TestIsPartitioned {
+  template <typename T, class D>
+  HWY_NOINLINE void operator()(T /*unused*/, D d) {
+    RandomState rng;
+    const size_t N = Lanes(d);
+    for (size_t count : CountsForTest(N)) {
+      for (int val : {-65, -3, 0, 10, 64}) {
+        const LessThan less(val);
+        const T threshold = ConvertScalarTo<T>(val);
+        const auto scalar_less = [threshold](T x) { return x < threshold; };
+
+        std::vector<T> keys = RandomValues<T>(rng, count);
+        bool expected =
+            std::is_partitioned(keys.begin(), keys.end(), scalar_less);
+        HWY_ASSERT_EQ(expected, IsPartitioned(d, keys.data(), count, less));
+
+        std::partition(keys.begin(), keys.end(), scalar_less);
+        HWY_ASSERT(IsPartitioned(d, keys.data(), count, less));
+
+        // Move a key that satisfies the predicate to the end.
+        const auto it = std::find_if(keys.begin(), keys.end(), scalar_less);
+        if (it != keys.end() && it + 1 != keys.end()) {
+          std::rotate(it, it + 1, keys.end());
+          expected =
+              std::is_partitioned(keys.begin(), keys.end(), scalar_less);
+          HWY_ASSERT_EQ(expected, IsPartitioned(d, keys.data(), count, less));
+        }
+      }
+    }
+  }
+};
+
+void TestAllIsPartitioned() {
+  ForUI163264(ForPartialVectors<TestIsPartitioned>());
+  ForFloat3264Types(ForPartialVectors<TestIsPartitioned>());
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+
+namespace hwy {
+HWY_BEFORE_TEST(SortedTest);
+HWY_EXPORT_AND_TEST_P(SortedTest, TestAllIsSorted);
+HWY_EXPORT_AND_TEST_P(SortedTest, TestAllIsSorted128);
+HWY_EXPORT_AND_TEST_P(SortedTest, TestAllIsPartitioned);
+}  // namespace hwy
+
+#endif
@@ -0,0 +1,143 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-target include guard
+#if defined(HIGHWAY_HWY_CONTRIB_ALGO_UNIQUE_INL_H_) == \
+    defined(HWY_TARGET_TOGGLE)  // NOLINT
+#ifdef HIGHWAY_HWY_CONTRIB_ALGO_UNIQUE_INL_H_
+#undef HIGHWAY_HWY_CONTRIB_ALGO_UNIQUE_INL_H_
+#else
+#define HIGHWAY_HWY_CONTRIB_ALGO_UNIQUE_INL_H_
+#endif
+
+#include <stddef.h>
+
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+// These functions are typically called after sorting (e.g. with VQSort), but
+// also work for unsorted inputs, where they only consider adjacent elements.
+// Equality is as for operator==, so -0.0 and +0.0 are duplicates, but NaN are
+// always unique, as in std::unique.
+//
+// NOTE: this is only supported for 16-, 32- or 64-bit types.
+
+// Removes all but the first element of each group of consecutive equal
+// elements in `keys`[0, `count`). Returns the number of remaining elements,
+// which are moved to the front of `keys`; the others are unchanged.
+template <class D, typename T = TFromD<D>>
+size_t Unique(D d, T* HWY_RESTRICT keys, size_t count) {
+  if (count == 0) return 0;
+  const size_t N = Lanes(d);
+
+  // keys[0] is always kept. Compares each element with its predecessor, which
+  // is not overwritten because CompressBlendedStore only writes the kept
+  // elements, which are each at or before their original position.
+  size_t out = 1;
+  size_t idx = 1;
+  if (count >= N + 1) {
+    for (; idx <= count - N; idx += N) {
+      const Vec<D> v = LoadU(d, keys + idx);
+      const Vec<D> prev = LoadU(d, keys + idx - 1);
+      out += CompressBlendedStore(v, Ne(v, prev), d, keys + out);
+    }
+  }
+
+  // `count` - 1 was a multiple of the vector length `N`: already done.
+  if (HWY_UNLIKELY(idx == count)) return out;
+
+  const size_t remaining = count - idx;
+  HWY_DASSERT(0 != remaining && remaining < N);
+  const Vec<D> v = LoadN(d, keys + idx, remaining);
+  const Vec<D> prev = LoadN(d, keys + idx - 1, remaining);
+  const Mask<D> mask = And(FirstN(d, remaining), Ne(v, prev));
+  out += CompressBlendedStore(v, mask, d, keys + out);
+  return out;
+}
+
+namespace detail {
+
+// Appends the runs that begin at the lanes of `mask` within the vector `v`,
+// which was loaded from index `idx`. `num_runs` is at least 1 and `run_begin`
+// is the index of the first element of the last run so far.
+template <class D, typename T = TFromD<D>>
+HWY_INLINE void AppendRuns(D d, Vec<D> v, Mask<D> mask, size_t idx, T* values,
+                           size_t* HWY_RESTRICT counts, size_t& num_runs,
+                           size_t& run_begin) {
+  const RebindToUnsigned<D> du;
+  using TU = TFromD<decltype(du)>;
+  HWY_ALIGN TU starts[MaxLanes(du)];
+
+  const size_t num_new = CompressBlendedStore(v, mask, d, values + num_runs);
+  // Lane indices fit in any lane type because Lanes(d) <= LimitsMax<TU>().
+  CompressStore(Iota(du, 0), RebindMask(du, mask), du, starts);
+  for (size_t i = 0; i < num_new; ++i) {
+    const size_t begin = idx + static_cast<size_t>(starts[i]);
+    counts[num_runs - 1] = begin - run_begin;
+    run_begin = begin;
+    ++num_runs;
+  }
+}
+
+}  // namespace detail
+
+// Run-length encodes `keys`[0, `count`): for each group of consecutive equal
+// elements, appends the first of them to `values` and the group size to
+// `counts`. Returns the number of groups, which is the number of elements
+// written to each of `values` and `counts`. `values` may be the same as
+// `keys`, in which case this is equivalent to Unique plus the counts.
+template <class D, typename T = TFromD<D>>
+size_t RunLengths(D d, const T* keys, size_t count, T* values,
+                  size_t* HWY_RESTRICT counts) {
+  if (count == 0) return 0;
+  const size_t N = Lanes(d);
+
+  values[0] = keys[0];
+  size_t num_runs = 1;
+  size_t run_begin = 0;
+
+  // As in Unique, `values` may alias `keys`.
+  size_t idx = 1;
+  if (count >= N + 1) {
+    for (; idx <= count - N; idx += N) {
+      const Vec<D> v = LoadU(d, keys + idx);
+      const Vec<D> prev = LoadU(d, keys + idx - 1);
+      detail::AppendRuns(d, v, Ne(v, prev), idx, values, counts, num_runs,
+                         run_begin);
+    }
+  }
+
+  if (idx != count) {
+    const size_t remaining = count - idx;
+    HWY_DASSERT(0 != remaining && remaining < N);
+    const Vec<D> v = LoadN(d, keys + idx, remaining);
+    const Vec<D> prev = LoadN(d, keys + idx - 1, remaining);
+    detail::AppendRuns(d, v, And(FirstN(d, remaining), Ne(v, prev)), idx,
+                       values, counts, num_runs, run_begin);
+  }
+
+  counts[num_runs - 1] = count - run_begin;
+  return num_runs;
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_ALGO_UNIQUE_INL_H_
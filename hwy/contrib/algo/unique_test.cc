@@ -0,0 +1,111 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+
+#include <algorithm>  // std::unique
+#include <vector>
+
+#include "hwy/base.h"
+
+// clang-format off
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "hwy/contrib/algo/unique_test.cc"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+#include "hwy/highway.h"
+#include "hwy/contrib/algo/unique-inl.h"
+#include "hwy/tests/test_util-inl.h"
+// clang-format on
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+// Sorted runs of random length, or (if `max_run` is 1) all distinct values.
+template <typename T>
+std::vector<T> RandomRuns(RandomState& rng, size_t count, uint32_t max_run) {
+  std::vector<T> keys(count);
+  int32_t val = IsSigned<T>() ? -64 : 0;
+  size_t i = 0;
+  while (i < count) {
+    const size_t run = 1 + (Random32(&rng) % max_run);
+    for (size_t j = 0; j < run && i < count; ++j) {
+      keys[i++] = ConvertScalarTo<T>(val);
+    }
+    ++val;
+  }
+  return keys;
+}
+
+struct TestUnique {
+  template <typename T, class D>
+  HWY_NOINLINE void operator()(T /*unused*/, D d) {
+    RandomState rng;
+    const size_t N = Lanes(d);
+    for (size_t count : {size_t{0}, size_t{1}, size_t{2}, N - 1, N, N + 1,
+                         3 * N + 2, AdjustedReps(1000)}) {
+      for (uint32_t max_run : {1u, 2u, 5u, 100u}) {
+        const std::vector<T> keys = RandomRuns<T>(rng, count, max_run);
+
+        std::vector<T> expected = keys;
+        expected.erase(std::unique(expected.begin(), expected.end()),
+                       expected.end());
+        std::vector<size_t> expected_counts;
+        for (size_t i = 0; i < count; ++i) {
+          if (i == 0 || keys[i] != keys[i - 1]) expected_counts.push_back(0);
+          ++expected_counts.back();
+        }
+
+        // In-place Unique.
+        std::vector<T> actual = keys;
+        const size_t num = Unique(d, actual.data(), count);
+        HWY_ASSERT_EQ(expected.size(), num);
+        HWY_ASSERT_ARRAY_EQ(expected.data(), actual.data(), num);
+
+        // Out-of-place and in-place RunLengths.
+        std::vector<T> values(count);
+        std::vector<size_t> counts(count);
+        for (bool in_place : {false, true}) {
+          actual = keys;
+          T* out = in_place ? actual.data() : values.data();
+          const size_t num_runs =
+              RunLengths(d, actual.data(), count, out, counts.data());
+          HWY_ASSERT_EQ(expected.size(), num_runs);
+          HWY_ASSERT_ARRAY_EQ(expected.data(), out, num_runs);
+          HWY_ASSERT_ARRAY_EQ(expected_counts.data(), counts.data(), num_runs);
+        }
+      }
+    }
+  }
+};
+
+void TestAllUnique() {
+  ForUI163264(ForPartialVectors<TestUnique>());
+  ForFloat3264Types(ForPartialVectors<TestUnique>());
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+
+namespace hwy {
+HWY_BEFORE_TEST(UniqueTest);
+HWY_EXPORT_AND_TEST_P(UniqueTest, TestAllUnique);
+}  // namespace hwy
+
+#endif
@@ -17,12 +17,15 @@
 #ifndef HIGHWAY_HWY_CONTRIB_SORT_ALGO_INL_H_
 #define HIGHWAY_HWY_CONTRIB_SORT_ALGO_INL_H_
 
+#include <math.h>  // exp2
 #include <stdint.h>
+#include <stdio.h>
 
-#include <algorithm>   // std::sort, std::min, std::max
+#include <algorithm>   // std::sort, std::nth_element, std::min, std::max
 #include <functional>  // std::less, std::greater
 #include <vector>
 
+#include "hwy/aligned_allocator.h"
 #include "hwy/base.h"
 #include "hwy/contrib/sort/vqsort.h"
 #include "hwy/print.h"
@@ -104,12 +107,37 @@ HWY_POP_ATTRIBUTES
 
 namespace hwy {
 
-enum class Dist { kUniform8, kUniform16, kUniform32 };
+// Input distributions. The first three are generated by masking random bits;
+// the others are derived from kUniform32 by rearranging or replacing keys.
+enum class Dist {
+  kUniform8,
+  kUniform16,
+  kUniform32,
+  kSorted,
+  kReverse,
+  kOrganPipe,   // ascending first half, descending second half
+  kZipf,        // skewed: rank r has probability proportional to 1/r
+  kFewUnique,   // 16 distinct values
+  kAllEqual,
+  kFile,        // raw lanes read from SORT_BENCH_INPUT, repeated as required
+};
 
 static inline std::vector<Dist> AllDist() {
   return {/*Dist::kUniform8, Dist::kUniform16,*/ Dist::kUniform32};
 }
 
+// Superset of AllDist for benchmarks, which can afford more inputs. kFile is
+// only included if the SORT_BENCH_INPUT path is defined.
+static inline std::vector<Dist> BenchDist() {
+  return {Dist::kUniform32, Dist::kSorted,     Dist::kReverse,
+          Dist::kOrganPipe, Dist::kZipf,       Dist::kFewUnique,
+          Dist::kAllEqual,
+#ifdef SORT_BENCH_INPUT
+          Dist::kFile,
+#endif
+  };
+}
+
 static inline const char* DistName(Dist dist) {
   switch (dist) {
     case Dist::kUniform8:
@@ -118,10 +146,166 @@ static inline const char* DistName(Dist dist) {
       return "uniform16";
     case Dist::kUniform32:
       return "uniform32";
+    case Dist::kSorted:
+      return "sorted";
+    case Dist::kReverse:
+      return "reverse";
+    case Dist::kOrganPipe:
+      return "organpipe";
+    case Dist::kZipf:
+      return "zipf";
+    case Dist::kFewUnique:
+      return "fewunique";
+    case Dist::kAllEqual:
+      return "allequal";
+    case Dist::kFile:
+      return "file";
   }
   return "unreachable";
 }
 
+namespace detail {
+
+static inline uint64_t NextSplitMix64(uint64_t& state) {
+  uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+// Fills `v` with the lanes stored in `path`, repeating them if the file is
+// shorter than `num` lanes.
+template <typename T>
+void ReadInputFile(const char* path, T* v, size_t num) {
+  FILE* f = fopen(path, "rb");
+  if (f == nullptr) HWY_ABORT("Failed to open input file %s\n", path);
+  const size_t num_read = fread(v, sizeof(T), num, f);
+  fclose(f);
+  if (num_read == 0) HWY_ABORT("Input file %s is empty\n", path);
+  for (size_t i = num_read; i < num; ++i) {
+    v[i] = v[i - num_read];
+  }
+}
+
+}  // namespace detail
+
+// Transforms the kUniform32 values in `v` according to `dist`. Note that this
+// operates on lanes, not keys: for 128-bit and K64V64 keys, the lanes of each
+// key are shaped independently, hence kSorted etc. are only approximately
+// ordered by key, and kFewUnique yields up to 16 * 16 distinct keys.
+template <typename T>
+void ShapeInput(const Dist dist, T* v, size_t num) {
+  if (num == 0) return;
+  uint64_t state = 0x243F6A8885A308D3ull;
+  switch (dist) {
+    case Dist::kSorted:
+      std::sort(v, v + num, std::less<T>());
+      break;
+    case Dist::kReverse:
+      std::sort(v, v + num, std::greater<T>());
+      break;
+    case Dist::kOrganPipe:
+      std::sort(v, v + num / 2, std::less<T>());
+      std::sort(v + num / 2, v + num, std::greater<T>());
+      break;
+    case Dist::kZipf:
+      // Ranks are log-uniform in [1, 1024), which has density 1/r.
+      for (size_t i = 0; i < num; ++i) {
+        const double u = static_cast<double>(detail::NextSplitMix64(state) >>
+                                             11) /
+                         9007199254740992.0;  // 2^53
+        const double rank = floor(exp2(10.0 * u));
+        v[i] = ConvertScalarTo<T>(rank);
+      }
+      break;
+    case Dist::kFewUnique: {
+      const size_t num_unique = HWY_MIN(num, size_t{16});
+      for (size_t i = num_unique; i < num; ++i) {
+        v[i] = v[detail::NextSplitMix64(state) % num_unique];
+      }
+      break;
+    }
+    case Dist::kAllEqual:
+      for (size_t i = 1; i < num; ++i) {
+        v[i] = v[0];
+      }
+      break;
+    case Dist::kFile:
+#ifdef SORT_BENCH_INPUT
+      detail::ReadInputFile(SORT_BENCH_INPUT, v, num);
+#else
+      HWY_ABORT("Dist::kFile requires SORT_BENCH_INPUT\n");
+#endif
+      break;
+    default:  // uniform; already generated
+      break;
+  }
+}
+
+// Scalar LSD radix sort with 8-bit digits, a non-comparison baseline for keys
+// of up to 64 bits. Keys are first mapped to unsigned integers with the same
+// order; passes in which all keys have the same digit are skipped.
+template <typename T>
+class RadixSorter {
+  using TU = MakeUnsigned<T>;
+  static constexpr TU kSign = static_cast<TU>(TU{1} << (sizeof(TU) * 8 - 1));
+
+  static TU ToBits(T key, bool is_ascending) {
+    TU bits = BitCastScalar<TU>(key);
+    if (IsFloat<T>()) {
+      bits = (bits & kSign) ? static_cast<TU>(~bits) : (bits | kSign);
+    } else if (IsSigned<T>()) {
+      bits ^= kSign;
+    }
+    return is_ascending ? bits : static_cast<TU>(~bits);
+  }
+
+  static T FromBits(TU bits, bool is_ascending) {
+    if (!is_ascending) bits = static_cast<TU>(~bits);
+    if (IsFloat<T>()) {
+      bits = (bits & kSign) ? (bits ^ kSign) : static_cast<TU>(~bits);
+    } else if (IsSigned<T>()) {
+      bits ^= kSign;
+    }
+    return BitCastScalar<T>(bits);
+  }
+
+ public:
+  static void Sort(T* HWY_RESTRICT keys, size_t num, bool is_ascending) {
+    if (num < 2) return;
+    auto storage = hwy::AllocateAligned<TU>(2 * num);
+    HWY_ASSERT(storage);
+    TU* HWY_RESTRICT from = storage.get();
+    TU* HWY_RESTRICT to = from + num;
+    for (size_t i = 0; i < num; ++i) {
+      from[i] = ToBits(keys[i], is_ascending);
+    }
+
+    for (size_t shift = 0; shift < sizeof(TU) * 8; shift += 8) {
+      size_t counts[256] = {0};
+      for (size_t i = 0; i < num; ++i) {
+        ++counts[(from[i] >> shift) & 0xFF];
+      }
+      if (counts[(from[0] >> shift) & 0xFF] == num) continue;
+
+      size_t sum = 0;
+      for (size_t& count : counts) {
+        const size_t prev = count;
+        count = sum;
+        sum += prev;
+      }
+      for (size_t i = 0; i < num; ++i) {
+        to[counts[(from[i] >> shift) & 0xFF]++] = from[i];
+      }
+      std::swap(from, to);
+    }
+
+    for (size_t i = 0; i < num; ++i) {
+      keys[i] = FromBits(from[i], is_ascending);
+    }
+  }
+};
+
 template <typename T>
 class InputStats {
  public:
@@ -196,6 +380,15 @@ enum class Algo {
   kStd,
   kVQSort,
   kHeap,
+  kRadix,
+  // Converts keys to a wider type, sorts those with VQSort and converts back.
+  // Baseline for key types that VQSort did not support.
+  kVQSortWiden,
+  // Partial sort and selection (nth_element). These require Run's `k_keys`.
+  kStdPartialSort,
+  kStdSelect,
+  kVQPartialSort,
+  kVQSelect,
 };
 
 static inline const char* AlgoName(Algo algo) {
@@ -234,6 +427,18 @@ static inline const char* AlgoName(Algo algo) {
       return "vq";
     case Algo::kHeap:
       return "heap";
+    case Algo::kRadix:
+      return "radix";
+    case Algo::kVQSortWiden:
+      return "vq_widen";
+    case Algo::kStdPartialSort:
+      return "std_partial";
+    case Algo::kStdSelect:
+      return "std_select";
+    case Algo::kVQPartialSort:
+      return "vq_partial";
+    case Algo::kVQSelect:
+      return "vq_select";
   }
   return "unreachable";
 }
@@ -338,6 +543,8 @@ Vec<DF> RandomValues(DF df, VU64& s0, VU64& s1, const VU64 mask) {
 template <class DU64>
 Vec<DU64> MaskForDist(DU64 du64, const Dist dist, size_t sizeof_t) {
   switch (sizeof_t) {
+    case 1:
+      return Set(du64, 0xFFFFFFFFFFFFFFFFull);
     case 2:
       return Set(du64, (dist == Dist::kUniform8) ? 0x00FF00FF00FF00FFull
                                                  : 0xFFFFFFFFFFFFFFFFull);
@@ -386,6 +593,8 @@ InputStats<T> GenerateInput(const Dist dist, T* v, size_t num) {
     CopyBytes(buf.get(), v + i, (num - i) * sizeof(T));
   }
 
+  ShapeInput(dist, v, num);
+
   InputStats<T> input_stats;
   for (size_t i = 0; i < num; ++i) {
     input_stats.Notify(v[i]);
@@ -464,9 +673,29 @@ void CallHeapSort(K32V32* HWY_RESTRICT keys, const size_t num_keys) {
 
 #endif  // VQSORT_ENABLED
 
+// Bridge from keys (passed to Run) to RadixSorter, which requires integer or
+// floating-point keys of at most 64 bits.
+template <class Order, typename KeyType, HWY_IF_NOT_T_SIZE(KeyType, 16)>
+void CallRadixSort(KeyType* HWY_RESTRICT keys, const size_t num_keys) {
+  RadixSorter<KeyType>::Sort(keys, num_keys, Order().IsAscending());
+}
+
+// The key occupies the upper half, hence u64 order is consistent with the key.
+template <class Order>
+void CallRadixSort(K32V32* HWY_RESTRICT keys, const size_t num_keys) {
+  RadixSorter<uint64_t>::Sort(reinterpret_cast<uint64_t*>(keys), num_keys,
+                              Order().IsAscending());
+}
+
+template <class Order, typename KeyType, HWY_IF_T_SIZE(KeyType, 16)>
+void CallRadixSort(KeyType* HWY_RESTRICT, const size_t) {
+  HWY_ABORT("Radix sort does not support 128-bit keys");
+}
+
+// `k_keys` is only used by the partial sort and selection algorithms.
 template <class Order, typename KeyType>
 void Run(Algo algo, KeyType* HWY_RESTRICT inout, size_t num,
-         SharedState& shared, size_t /*thread*/) {
+         SharedState& shared, size_t /*thread*/, size_t k_keys = 0) {
   const std::less<KeyType> less;
   const std::greater<KeyType> greater;
 
@@ -554,6 +783,31 @@ void Run(Algo algo, KeyType* HWY_RESTRICT inout, size_t num,
     case Algo::kHeap:
       return CallHeapSort<Order>(inout, num);
 
+    case Algo::kRadix:
+      return CallRadixSort<Order>(inout, num);
+
+    case Algo::kStdPartialSort:
+      k_keys = HWY_MIN(k_keys, num);
+      if (Order().IsAscending()) {
+        return std::partial_sort(inout, inout + k_keys, inout + num, less);
+      } else {
+        return std::partial_sort(inout, inout + k_keys, inout + num, greater);
+      }
+
+    case Algo::kStdSelect:
+      if (k_keys >= num) return;
+      if (Order().IsAscending()) {
+        return std::nth_element(inout, inout + k_keys, inout + num, less);
+      } else {
+        return std::nth_element(inout, inout + k_keys, inout + num, greater);
+      }
+
+    case Algo::kVQPartialSort:
+      return VQPartialSort(inout, num, k_keys, Order());
+
+    case Algo::kVQSelect:
+      return VQSelect(inout, num, k_keys, Order());
+
     default:
       HWY_ABORT("Not implemented");
   }
@@ -35,6 +35,8 @@
 // After foreach_target
 #include "hwy/contrib/sort/algo-inl.h"
 #include "hwy/contrib/sort/result-inl.h"
+#include "hwy/contrib/sort/vqsort.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
 #include "hwy/aligned_allocator.h"
 // Last
 #include "hwy/tests/test_util-inl.h"
@@ -221,6 +223,44 @@ void BenchParallel() {
   }
 }
 
+// Unlike BenchParallel, all threads cooperate on sorting a single array.
+void BenchParallelSort() {
+  // Not interested in benchmark results for other targets on x86
+  if (HWY_ARCH_X86 &&
+      (HWY_TARGET != HWY_AVX2 && HWY_TARGET != HWY_AVX3 &&
+       HWY_TARGET != HWY_AVX3_ZEN4 && HWY_TARGET != HWY_AVX3_SPR)) {
+    return;
+  }
+
+  detail::SharedTraits<detail::TraitsLane<detail::OrderAscending<uint64_t>>>
+      st;
+  using KeyType = typename decltype(st)::KeyType;
+  const size_t num_keys = size_t{100} * 1000 * 1000;
+  auto aligned = hwy::AllocateAligned<KeyType>(num_keys);
+  HWY_ASSERT(aligned);
+  const Dist dist = Dist::kUniform32;
+
+  const size_t max_threads = HWY_MAX(size_t{1}, hwy::ThreadPool::MaxThreads());
+  for (size_t nt = 1; nt <= max_threads; nt += HWY_MAX(1, max_threads / 16)) {
+    hwy::ThreadPool pool(nt);
+    const InputStats<KeyType> input_stats =
+        GenerateInput(dist, aligned.get(), num_keys);
+
+    const Timestamp t0;
+    VQSort(aligned.get(), num_keys, SortAscending(), pool);
+    const double sec = SecondsSince(t0);
+    HWY_ASSERT(VerifySort(st, input_stats, aligned.get(), num_keys,
+                          "BenchParallelSort"));
+
+    // Not Result::Print because that reports the total of independent sorts.
+    const double bytes = static_cast<double>(num_keys * sizeof(KeyType));
+    printf("%10s: %12s: %7s: %9s: %05g %4.0f MB/s (%2zu workers)\n",
+           hwy::TargetName(HWY_TARGET), "vq_parallel", st.KeyString(),
+           DistName(dist), static_cast<double>(num_keys), bytes * 1E-6 / sec,
+           pool.NumWorkers());
+  }
+}
+
 }  // namespace
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
@@ -233,6 +273,7 @@ namespace hwy {
 namespace {
 HWY_BEFORE_TEST(BenchParallel);
 HWY_EXPORT_AND_TEST_P(BenchParallel, BenchParallel);
+HWY_EXPORT_AND_TEST_P(BenchParallel, BenchParallelSort);
 }  // namespace
 }  // namespace hwy
 
@@ -0,0 +1,186 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks set operations on sorted posting lists, as produced by VQSort and
+// Unique, versus their std:: equivalents.
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>  // std::set_intersection
+#include <vector>
+
+// clang-format off
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "hwy/contrib/sort/bench_set_ops.cc"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+
+// After foreach_target
+#include "hwy/contrib/algo/set_ops-inl.h"
+#include "hwy/contrib/algo/unique-inl.h"
+#include "hwy/contrib/sort/result-inl.h"  // SummarizeMeasurements
+#include "hwy/contrib/sort/vqsort.h"
+#include "hwy/tests/test_util-inl.h"
+#include "hwy/timer.h"
+// clang-format on
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+// Defined within HWY_ONCE, used by BenchAllSetOps.
+extern int64_t first_set_ops_target;
+
+namespace HWY_NAMESPACE {
+namespace {
+
+enum class SetOp { kIntersection, kUnion, kDifference };
+
+const char* SetOpName(SetOp op) {
+  switch (op) {
+    case SetOp::kIntersection:
+      return "intersection";
+    case SetOp::kUnion:
+      return "union";
+    case SetOp::kDifference:
+      return "difference";
+  }
+  return "?";
+}
+
+// Returns a sorted set of at most `num` values in [0, `range`).
+template <typename T>
+std::vector<T> RandomPostingList(RandomState& rng, size_t num, uint64_t range) {
+  std::vector<T> list(num);
+  for (T& x : list) {
+    x = static_cast<T>(Random64(&rng) % range);
+  }
+  VQSort(list.data(), num, SortAscending());
+  const ScalableTag<T> d;
+  list.resize(Unique(d, list.data(), num));
+  return list;
+}
+
+template <typename T>
+size_t RunStd(SetOp op, const std::vector<T>& a, const std::vector<T>& b,
+              T* out) {
+  switch (op) {
+    case SetOp::kIntersection:
+      return static_cast<size_t>(
+          std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), out) -
+          out);
+    case SetOp::kUnion:
+      return static_cast<size_t>(
+          std::set_union(a.begin(), a.end(), b.begin(), b.end(), out) - out);
+    case SetOp::kDifference:
+      return static_cast<size_t>(
+          std::set_difference(a.begin(), a.end(), b.begin(), b.end(), out) -
+          out);
+  }
+  return 0;
+}
+
+template <typename T>
+size_t RunVQ(SetOp op, const std::vector<T>& a, const std::vector<T>& b,
+             T* out) {
+  const ScalableTag<T> d;
+  switch (op) {
+    case SetOp::kIntersection:
+      return SetIntersection(d, a.data(), a.size(), b.data(), b.size(), out);
+    case SetOp::kUnion:
+      return SetUnion(d, a.data(), a.size(), b.data(), b.size(), out);
+    case SetOp::kDifference:
+      return SetDifference(d, a.data(), a.size(), b.data(), b.size(), out);
+  }
+  return 0;
+}
+
+// `density` is the expected fraction of the value range present in the
+// larger list; higher values result in more matches.
+template <typename T>
+HWY_NOINLINE void BenchSetOps(size_t num_a, size_t num_b, double density) {
+  if (first_set_ops_target == 0) first_set_ops_target = HWY_TARGET;
+
+  RandomState rng;
+  const uint64_t range =
+      static_cast<uint64_t>(static_cast<double>(HWY_MAX(num_a, num_b)) /
+                            density) +
+      1;
+  const std::vector<T> a = RandomPostingList<T>(rng, num_a, range);
+  const std::vector<T> b = RandomPostingList<T>(rng, num_b, range);
+  std::vector<T> out(a.size() + b.size());
+  std::vector<T> expected(a.size() + b.size());
+  const size_t reps = AdjustedReps(30);
+
+  for (SetOp op : {SetOp::kIntersection, SetOp::kUnion, SetOp::kDifference}) {
+    const size_t num_expected = RunStd(op, a, b, expected.data());
+    for (bool is_vq : {false, true}) {
+      // std:: algorithms don't depend on the vector instructions, so only run
+      // them for the first target.
+      if (!is_vq && HWY_TARGET != first_set_ops_target) continue;
+
+      std::vector<double> seconds;
+      for (size_t rep = 0; rep < reps; ++rep) {
+        const Timestamp t0;
+        const size_t num_out = is_vq ? RunVQ(op, a, b, out.data())
+                                     : RunStd(op, a, b, out.data());
+        seconds.push_back(SecondsSince(t0));
+        HWY_ASSERT_EQ(num_expected, num_out);
+      }
+      HWY_ASSERT_ARRAY_EQ(expected.data(), out.data(), num_expected);
+
+      const double bytes =
+          static_cast<double>((a.size() + b.size()) * sizeof(T));
+      printf("%10s: %12s: %4s: %8zu %8zu (density %.2f): %7.0f MB/s\n",
+             is_vq ? hwy::TargetName(HWY_TARGET) : "std", SetOpName(op),
+             TypeName(T(), 1).c_str(), a.size(), b.size(), density,
+             bytes * 1E-6 / SummarizeMeasurements(seconds));
+    }
+  }
+}
+
+HWY_NOINLINE void BenchAllSetOps() {
+  // Not interested in benchmark results for these targets. Note that SSE4 is
+  // numerically less than SSE2, hence it is the lower bound.
+  if (HWY_SSE4 <= HWY_TARGET && HWY_TARGET <= HWY_SSE2) {
+    return;
+  }
+
+  const size_t num = AdjustedReps(1000 * 1000);
+  for (double density : {0.1, 0.5}) {
+    // Similar sizes: vector-at-a-time comparisons.
+    BenchSetOps<uint32_t>(num, num, density);
+    BenchSetOps<uint64_t>(num, num, density);
+    // Skewed sizes: galloping.
+    BenchSetOps<uint32_t>(num / 1000, num, density);
+    BenchSetOps<uint64_t>(num / 1000, num, density);
+  }
+}
+
+}  // namespace
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+
+namespace hwy {
+int64_t first_set_ops_target = 0;  // none run yet
+namespace {
+HWY_BEFORE_TEST(BenchSetOps);
+HWY_EXPORT_AND_TEST_P(BenchSetOps, BenchAllSetOps);
+}  // namespace
+}  // namespace hwy
+
+#endif  // HWY_ONCE
@@ -47,6 +47,22 @@
 #ifndef SORT_ONLY_COLD
 #define SORT_ONLY_COLD 0
 #endif
+
+// Benchmarks a x4 geometric sequence of sizes from 16 to SORT_BENCH_MAX_KEYS
+// and also compares with std::sort and a radix sort. Set SORT_BENCH_FORMAT
+// (see result-inl.h) to obtain CSV or JSON output, and SORT_BENCH_INPUT to the
+// path of a file with raw keys to additionally benchmark real data.
+#ifndef SORT_BENCH_SWEEP
+#define SORT_BENCH_SWEEP 0
+#endif
+// Whether BenchSort covers all of BenchDist() rather than only AllDist().
+#ifndef SORT_BENCH_ALL_DIST
+#define SORT_BENCH_ALL_DIST SORT_BENCH_SWEEP
+#endif
+#ifndef SORT_BENCH_MAX_KEYS
+#define SORT_BENCH_MAX_KEYS (1000 * 1000 * size_t{1000})
+#endif
+
 #ifndef SORT_BENCH_BASE_AND_PARTITION
 #define SORT_BENCH_BASE_AND_PARTITION (!SORT_ONLY_COLD && 0)
 #endif
@@ -292,7 +308,9 @@ std::vector<Algo> AlgoForBench() {
 #endif
 
 #if !HAVE_PARALLEL_IPS4O
-#if !SORT_100M
+#if SORT_BENCH_SWEEP
+    Algo::kStd, Algo::kRadix,
+#elif !SORT_100M
     // 10-20x slower, but that's OK for the default size when we are not
     // testing the parallel nor 100M modes.
     // Algo::kStd,
@@ -305,6 +323,30 @@ std::vector<Algo> AlgoForBench() {
   };
 }
 
+// Prints the counters of `reps` sorts, if the library was compiled with
+// VQSORT_STATS=1.
+void MaybePrintStats(const SortStats& stats, size_t reps) {
+  // Would interfere with machine-readable output.
+  if (stats.num_sorts == 0 || SORT_BENCH_FORMAT != 0) return;
+  const double mul = 1.0 / static_cast<double>(reps);
+  const double ms_per_tick = 1E3 / platform::InvariantTicksPerSecond();
+  printf(
+      "  per sort: depth %2d partitions %6.0f (%6.1f MB) two-key %4.0f "
+      "all-equal %4.0f base %6.0f heap %.0f counting %.0f; "
+      "ms pivot %.3f partition %.3f base %.3f\n",
+      static_cast<int>(stats.max_depth),
+      static_cast<double>(stats.num_partitions) * mul,
+      static_cast<double>(stats.bytes_partitioned) * mul * 1E-6,
+      static_cast<double>(stats.num_two_key_partitions) * mul,
+      static_cast<double>(stats.num_all_equal) * mul,
+      static_cast<double>(stats.num_base_cases) * mul,
+      static_cast<double>(stats.num_heap_sorts) * mul,
+      static_cast<double>(stats.num_counting_sorts) * mul,
+      static_cast<double>(stats.pivot_ticks) * mul * ms_per_tick,
+      static_cast<double>(stats.partition_ticks) * mul * ms_per_tick,
+      static_cast<double>(stats.base_case_ticks) * mul * ms_per_tick);
+}
+
 template <class Traits>
 HWY_NOINLINE void BenchSort(size_t num_keys) {
   if (first_sort_target == 0) first_sort_target = HWY_TARGET;
@@ -317,9 +359,13 @@ HWY_NOINLINE void BenchSort(size_t num_keys) {
   const size_t num_lanes = num_keys * st.LanesPerKey();
   auto aligned = hwy::AllocateAligned<LaneType>(num_lanes);
 
-  const size_t reps = num_keys > 1000 * 1000 ? 10 : 30;
+  const size_t reps = num_keys > 100 * 1000 * 1000 ? 3
+                      : num_keys > 1000 * 1000      ? 10
+                                                    : 30;
 
   for (Algo algo : AlgoForBench()) {
+    // Radix sort only supports keys of up to 64 bits.
+    if (algo == Algo::kRadix && sizeof(KeyType) > 8) continue;
     // Other algorithms don't depend on the vector instructions, so only run
     // them for the first target.
 #if !HAVE_VXSORT
@@ -328,8 +374,9 @@ HWY_NOINLINE void BenchSort(size_t num_keys) {
     }
 #endif
 
-    for (Dist dist : AllDist()) {
+    for (Dist dist : SORT_BENCH_ALL_DIST ? BenchDist() : AllDist()) {
       std::vector<double> seconds;
+      ResetVQSortStats();
       for (size_t rep = 0; rep < reps; ++rep) {
         InputStats<LaneType> input_stats =
             GenerateInput(dist, aligned.get(), num_lanes);
@@ -346,6 +393,84 @@ HWY_NOINLINE void BenchSort(size_t num_keys) {
       Result(algo, dist, num_keys, 1, SummarizeMeasurements(seconds),
              sizeof(KeyType), st.KeyString())
           .Print();
+      MaybePrintStats(GetVQSortStats(), reps);
+    }  // dist
+  }    // algo
+}
+
+// Returns a key from random lane bits. bf16 keys are finite, and ordered
+// consistently with `lane` so that sorted inputs remain sorted.
+template <typename KeyType, HWY_IF_BF16(KeyType)>
+KeyType KeyFromLane(uint16_t lane) {
+  return ConvertScalarTo<KeyType>(static_cast<float>(lane) - 32768.0f);
+}
+template <typename KeyType, HWY_IF_NOT_BF16(KeyType)>
+KeyType KeyFromLane(MakeUnsigned<KeyType> lane) {
+  return BitCastScalar<KeyType>(lane);
+}
+
+// For 8-bit and bf16 keys, compares VQSort with widening them to `Wide` and
+// sorting those, which was previously required.
+template <typename KeyType, typename Wide, class Order>
+HWY_NOINLINE void BenchSortNarrow(size_t num_keys) {
+  if (first_sort_target == 0) first_sort_target = HWY_TARGET;
+  // VQSort dispatches to the best target regardless of HWY_TARGET, so only
+  // measure it once rather than mislabeling the same results per target.
+  if (HWY_TARGET != first_sort_target) return;
+
+  using TU = MakeUnsigned<KeyType>;
+  auto lanes = hwy::AllocateAligned<TU>(num_keys);
+  auto keys = hwy::AllocateAligned<KeyType>(num_keys);
+  auto wide = hwy::AllocateAligned<Wide>(num_keys);
+  HWY_ASSERT(lanes && keys && wide);
+  const char* key_name = IsSame<KeyType, bfloat16_t>() ? "bf16"
+                         : IsSigned<KeyType>()         ? "i8"
+                                                       : "u8";
+
+  const size_t reps = num_keys > 100 * 1000 * 1000 ? 3
+                      : num_keys > 1000 * 1000      ? 10
+                                                    : 30;
+
+  for (Algo algo : {Algo::kVQSort, Algo::kVQSortWiden}) {
+    for (Dist dist : SORT_BENCH_ALL_DIST ? BenchDist() : AllDist()) {
+      std::vector<double> seconds;
+      for (size_t rep = 0; rep < reps; ++rep) {
+        (void)GenerateInput(dist, lanes.get(), num_keys);
+        InputStats<TU> input_stats;
+        for (size_t i = 0; i < num_keys; ++i) {
+          keys[i] = KeyFromLane<KeyType>(lanes[i]);
+          input_stats.Notify(BitCastScalar<TU>(keys[i]));
+        }
+
+        const Timestamp t0;
+        if (algo == Algo::kVQSort) {
+          VQSort(keys.get(), num_keys, Order());
+        } else {
+          for (size_t i = 0; i < num_keys; ++i) {
+            wide[i] = ConvertScalarTo<Wide>(keys[i]);
+          }
+          VQSort(wide.get(), num_keys, Order());
+          for (size_t i = 0; i < num_keys; ++i) {
+            keys[i] = ConvertScalarTo<KeyType>(wide[i]);
+          }
+        }
+        seconds.push_back(SecondsSince(t0));
+
+        InputStats<TU> output_stats;
+        for (size_t i = 0; i < num_keys; ++i) {
+          output_stats.Notify(BitCastScalar<TU>(keys[i]));
+          if (i == 0) continue;
+          const float prev = ConvertScalarTo<float>(keys[i - 1]);
+          const float cur = ConvertScalarTo<float>(keys[i]);
+          if (Order().IsAscending() ? (cur < prev) : (cur > prev)) {
+            HWY_ABORT("%s sort is incorrect at %zu\n", key_name, i);
+          }
+        }
+        HWY_ASSERT(input_stats == output_stats);
+      }
+      Result(algo, dist, num_keys, 1, SummarizeMeasurements(seconds),
+             sizeof(KeyType), key_name)
+          .Print();
     }  // dist
   }    // algo
 }
@@ -358,7 +483,8 @@ enum class BenchmarkModes {
   kSmallPow2,
   kSmallPow2Between,  // includes padding
   kPow4,
-  kPow10
+  kPow10,
+  kSweep,  // x4 from 16 to SORT_BENCH_MAX_KEYS
 };
 
 std::vector<size_t> SizesToBenchmark(BenchmarkModes mode) {
@@ -407,6 +533,15 @@ std::vector<size_t> SizesToBenchmark(BenchmarkModes mode) {
         sizes.push_back(size);
       }
       break;
+
+    case BenchmarkModes::kSweep: {
+      const size_t max_keys = SORT_BENCH_MAX_KEYS;
+      for (size_t size = 16; size <= max_keys; size *= 4) {
+        sizes.push_back(size);
+      }
+      if (sizes.empty() || sizes.back() != max_keys) sizes.push_back(max_keys);
+      break;
+    }
   }
   return sizes;
 }
@@ -421,7 +556,9 @@ HWY_NOINLINE void BenchAllSort() {
   if (HWY_TARGET > HWY_AVX3) return;
 #endif
 
-  for (size_t num_keys : SizesToBenchmark(BenchmarkModes::kSmallPow2)) {
+  const BenchmarkModes mode =
+      SORT_BENCH_SWEEP ? BenchmarkModes::kSweep : BenchmarkModes::kSmallPow2;
+  for (size_t num_keys : SizesToBenchmark(mode)) {
 #if !HAVE_INTEL
 #if HWY_HAVE_FLOAT16
     if (hwy::HaveFloat16()) {
@@ -441,6 +578,9 @@ HWY_NOINLINE void BenchAllSort() {
     // BenchSort<TraitsLane<OtherOrder<uint16_t>>>(num_keys);
     // BenchSort<TraitsLane<OtherOrder<uint32_t>>>(num_keys);
     // BenchSort<TraitsLane<OrderAscending<uint64_t>>>(num_keys);
+    BenchSortNarrow<uint8_t, uint16_t, SortAscending>(num_keys);
+    BenchSortNarrow<int8_t, int16_t, SortDescending>(num_keys);
+    BenchSortNarrow<bfloat16_t, float, SortAscending>(num_keys);
 
 #if !HAVE_VXSORT && !HAVE_INTEL && VQSORT_ENABLED
     BenchSort<Traits128<OrderAscending128>>(num_keys);
@@ -449,6 +589,78 @@ HWY_NOINLINE void BenchAllSort() {
   }
 }
 
+#if VQSORT_ENABLED
+
+// Compares VQSelect/VQPartialSort with std::nth_element/std::partial_sort for
+// the first `k_keys` of `num_keys`.
+template <class Traits>
+HWY_NOINLINE void BenchSelect(size_t num_keys, size_t k_keys) {
+  if (first_sort_target == 0) first_sort_target = HWY_TARGET;
+
+  SharedState shared;
+  detail::SharedTraits<Traits> st;
+  using Order = typename Traits::Order;
+  using LaneType = typename Traits::LaneType;
+  using KeyType = typename Traits::KeyType;
+  const size_t num_lanes = num_keys * st.LanesPerKey();
+  const size_t k_lanes = k_keys * st.LanesPerKey();
+  auto aligned = hwy::AllocateAligned<LaneType>(num_lanes);
+
+  const size_t reps = num_keys > 1000 * 1000 ? 10 : 30;
+
+  for (Algo algo : {Algo::kStdSelect, Algo::kVQSelect, Algo::kStdPartialSort,
+                    Algo::kVQPartialSort}) {
+    // std:: algorithms don't depend on the vector instructions, so only run
+    // them for the first target.
+    const bool is_vq = algo == Algo::kVQSelect || algo == Algo::kVQPartialSort;
+    if (!is_vq && HWY_TARGET != first_sort_target) continue;
+
+    for (Dist dist : AllDist()) {
+      std::vector<double> seconds;
+      for (size_t rep = 0; rep < reps; ++rep) {
+        InputStats<LaneType> input_stats =
+            GenerateInput(dist, aligned.get(), num_lanes);
+
+        const Timestamp t0;
+        Run<Order>(algo, reinterpret_cast<KeyType*>(aligned.get()), num_keys,
+                   shared, /*thread=*/0, k_keys);
+        seconds.push_back(SecondsSince(t0));
+
+        if (algo == Algo::kStdSelect || algo == Algo::kVQSelect) {
+          HWY_ASSERT(VerifySelect(st, input_stats, aligned.get(), num_lanes,
+                                  k_lanes, "BenchSelect"));
+        } else {
+          HWY_ASSERT(VerifyPartialSort(st, input_stats, aligned.get(),
+                                       num_lanes, k_lanes, "BenchPartialSort"));
+        }
+      }
+      if (SORT_BENCH_FORMAT == 0) printf("k=%6zu ", k_keys);
+      Result(algo, dist, num_keys, 1, SummarizeMeasurements(seconds),
+             sizeof(KeyType), st.KeyString())
+          .Print();
+    }  // dist
+  }    // algo
+}
+
+#endif  // VQSORT_ENABLED
+
+HWY_NOINLINE void BenchAllSelect() {
+  // Not interested in benchmark results for these targets.
+  if (HWY_SSE4 <= HWY_TARGET && HWY_TARGET <= HWY_SSE2) {
+    return;
+  }
+#if VQSORT_ENABLED && !HAVE_INTEL
+  const size_t num_keys = AdjustedReps(100 * 1000);
+  // Top 1% and median.
+  for (size_t k_keys : {num_keys / 100, num_keys / 2}) {
+    BenchSelect<TraitsLane<OrderAscending<float>>>(num_keys, k_keys);
+    BenchSelect<TraitsLane<OtherOrder<int32_t>>>(num_keys, k_keys);
+    BenchSelect<TraitsLane<OrderAscending<int64_t>>>(num_keys, k_keys);
+    BenchSelect<Traits128<OrderAscending128>>(num_keys, k_keys);
+  }
+#endif
+}
+
 }  // namespace
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
@@ -470,6 +682,7 @@ HWY_EXPORT_AND_TEST_P(BenchSort, BenchAllBase);
 
 #if !SORT_ONLY_COLD  // skip (warms up vector unit for next run)
 HWY_EXPORT_AND_TEST_P(BenchSort, BenchAllSort);
+HWY_EXPORT_AND_TEST_P(BenchSort, BenchAllSelect);
 #endif
 }  // namespace
 }  // namespace hwy
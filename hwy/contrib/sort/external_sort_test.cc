@@ -0,0 +1,101 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hwy/contrib/sort/vqsort_external.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>  // std::sort
+#include <functional>  // std::greater
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "hwy/base.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
+#include "hwy/tests/test_util-inl.h"  // RandomState
+
+namespace hwy {
+namespace {
+
+template <typename T>
+std::vector<T> RandomKeys(size_t num) {
+  RandomState rng;
+  std::vector<T> keys(num);
+  for (T& key : keys) {
+    // Few distinct values so that there are many duplicates across runs.
+    key = static_cast<T>(Random64(&rng) % (num / 4 + 1));
+  }
+  return keys;
+}
+
+// Writes `keys` to a temporary file, sorts it into another and returns the
+// result.
+template <typename T, class Order>
+std::vector<T> SortViaFiles(const std::vector<T>& keys, size_t max_bytes,
+                            Order order, ThreadPool* pool) {
+  FILE* in = tmpfile();
+  FILE* out = tmpfile();
+  HWY_ASSERT(in && out);
+  HWY_ASSERT(fwrite(keys.data(), sizeof(T), keys.size(), in) == keys.size());
+  HWY_ASSERT(fseek(in, 0, SEEK_SET) == 0);
+
+  HWY_ASSERT(VQSortExternal<T>(in, out, max_bytes, order, pool));
+
+  std::vector<T> sorted(keys.size() + 1);
+  HWY_ASSERT(fseek(out, 0, SEEK_SET) == 0);
+  // Also verifies there is no extra output.
+  HWY_ASSERT(fread(sorted.data(), sizeof(T), sorted.size(), out) ==
+             keys.size());
+  sorted.pop_back();
+  fclose(in);
+  fclose(out);
+  return sorted;
+}
+
+template <typename T>
+void TestExternal(ThreadPool* pool) {
+  // Fits into a single chunk, or requires merging several runs (and one
+  // partial run).
+  for (size_t num : {size_t{0}, size_t{1000}, size_t{100 * 1000 + 3}}) {
+    const std::vector<T> keys = RandomKeys<T>(num);
+
+    std::vector<T> expected = keys;
+    std::sort(expected.begin(), expected.end());
+    std::vector<T> actual =
+        SortViaFiles(keys, 64 * 1024, SortAscending(), pool);
+    HWY_ASSERT(expected == actual);
+
+    std::sort(expected.begin(), expected.end(), std::greater<T>());
+    actual = SortViaFiles(keys, 64 * 1024, SortDescending(), pool);
+    HWY_ASSERT(expected == actual);
+  }
+}
+
+TEST(VQSortExternalTest, TestSerial) {
+  TestExternal<uint32_t>(nullptr);
+  TestExternal<int64_t>(nullptr);
+  TestExternal<uint16_t>(nullptr);
+}
+
+TEST(VQSortExternalTest, TestParallel) {
+  ThreadPool pool(HWY_MIN(4, ThreadPool::MaxThreads()));
+  TestExternal<uint32_t>(&pool);
+  TestExternal<double>(&pool);
+}
+
+}  // namespace
+}  // namespace hwy
@@ -29,6 +29,19 @@ struct SortDescending {
   constexpr bool IsAscending() const { return false; }
 };
 
+// Optional argument when sorting floating-point keys. By default, NaN are
+// ordered last and replaced with a canonical NaN, and -0.0 and +0.0 are
+// equivalent. With any of the following, keys are instead ordered according to
+// their bit representation, so all NaN payloads are preserved and -0.0 is
+// ordered before +0.0 (or after, if descending), in a single pass.
+enum class FloatOrder {
+  kNaNFirst,  // NaN precede all other keys, regardless of the sort direction.
+  kNaNLast,   // NaN follow all other keys, regardless of the sort direction.
+  // IEEE 754 totalOrder: -NaN < -inf < .. < -0.0 < +0.0 < .. < +inf < +NaN,
+  // also ordering NaN by their payload. Reversed if descending.
+  kTotalOrder,
+};
+
 }  // namespace hwy
 
 #endif  // HIGHWAY_HWY_CONTRIB_SORT_ORDER_H_
@@ -28,6 +28,13 @@
 #include "hwy/nanobenchmark.h"
 #include "hwy/timer.h"
 
+// Output format of Result::Print: 0 = human-readable text, 1 = CSV (with a
+// header before the first row), 2 = one JSON object per line. The latter two
+// are intended for tracking results across releases and targets.
+#ifndef SORT_BENCH_FORMAT
+#define SORT_BENCH_FORMAT 0
+#endif
+
 namespace hwy {
 
 // Returns trimmed mean (we don't want to run an out-of-L3-cache sort often
@@ -44,6 +51,14 @@ static inline double SummarizeMeasurements(std::vector<double>& seconds) {
   return sum / count;
 }
 
+// Returns true only on the first call, used for printing the CSV header.
+static inline bool IsFirstResult() {
+  static bool first = true;
+  const bool ret = first;
+  first = false;
+  return ret;
+}
+
 }  // namespace hwy
 #endif  // HIGHWAY_HWY_CONTRIB_SORT_RESULT_INL_H_
 
@@ -56,6 +71,9 @@ static inline double SummarizeMeasurements(std::vector<double>& seconds) {
 #define HIGHWAY_HWY_CONTRIB_SORT_RESULT_TOGGLE
 #endif
 
+#include "hwy/contrib/algo/sorted-inl.h"
+#include "hwy/contrib/sort/shared-inl.h"  // SortTag
+
 HWY_BEFORE_NAMESPACE();
 namespace hwy {
 namespace HWY_NAMESPACE {
@@ -77,10 +95,26 @@ struct Result {
     const double bytes = static_cast<double>(num_keys) *
                          static_cast<double>(num_threads) *
                          static_cast<double>(sizeof_key);
-    printf("%10s: %12s: %7s: %9s: %05g %4.0f MB/s (%2zu threads)\n",
-           hwy::TargetName(target), AlgoName(algo), key_name.c_str(),
-           DistName(dist), static_cast<double>(num_keys), bytes * 1E-6 / sec,
-           num_threads);
+    const double mbps = bytes * 1E-6 / sec;
+    if (SORT_BENCH_FORMAT == 1) {
+      if (IsFirstResult()) {
+        printf("target,algo,key,dist,num_keys,num_threads,sec,mbps\n");
+      }
+      printf("%s,%s,%s,%s,%zu,%zu,%.9g,%.1f\n", hwy::TargetName(target),
+             AlgoName(algo), key_name.c_str(), DistName(dist), num_keys,
+             num_threads, sec, mbps);
+    } else if (SORT_BENCH_FORMAT == 2) {
+      printf(
+          "{\"target\":\"%s\",\"algo\":\"%s\",\"key\":\"%s\",\"dist\":"
+          "\"%s\",\"num_keys\":%zu,\"num_threads\":%zu,\"sec\":%.9g,"
+          "\"mbps\":%.1f}\n",
+          hwy::TargetName(target), AlgoName(algo), key_name.c_str(),
+          DistName(dist), num_keys, num_threads, sec, mbps);
+    } else {
+      printf("%10s: %12s: %7s: %9s: %05g %4.0f MB/s (%2zu threads)\n",
+             hwy::TargetName(target), AlgoName(algo), key_name.c_str(),
+             DistName(dist), static_cast<double>(num_keys), mbps, num_threads);
+    }
   }
 
   int64_t target;
@@ -93,32 +127,123 @@ struct Result {
   std::string key_name;
 };
 
+// Adapter for IsSortedUntil: returns the lanes whose key `cur` is ordered
+// before the key `prev` according to the traits.
+template <class Traits>
+class TraitsOutOfOrder {
+ public:
+  explicit TraitsOutOfOrder(Traits st) : st_(st) {}
+  template <class D, class V>
+  Mask<D> operator()(D d, V cur, V prev) const {
+    return st_.Compare(d, cur, prev);
+  }
+
+ private:
+  mutable Traits st_;  // Compare is not const for all traits.
+};
+
+// Returns the index of the first lane of the first key that is ordered before
+// its predecessor, or `num_lanes`.
+template <class Traits, typename LaneType>
+size_t FirstUnsortedLane(Traits st, const LaneType* out, size_t num_lanes,
+                         hwy::SizeTag<1> /*lanes_per_key*/) {
+  const SortTag<LaneType> d;
+  return IsSortedUntil(d, out, num_lanes, TraitsOutOfOrder<Traits>(st));
+}
+
+#if VQSORT_ENABLED
+template <class Traits, typename LaneType>
+size_t FirstUnsortedLane(Traits st, const LaneType* out, size_t num_lanes,
+                         hwy::SizeTag<2> /*lanes_per_key*/) {
+  const SortTag<LaneType> d;
+  return 2 * IsSortedUntil128(d, out, num_lanes / 2,
+                              TraitsOutOfOrder<Traits>(st));
+}
+#endif
+
 template <class Traits, typename LaneType>
 bool VerifySort(Traits st, const InputStats<LaneType>& input_stats,
                 const LaneType* out, size_t num_lanes, const char* caller) {
   constexpr size_t N1 = st.LanesPerKey();
   HWY_ASSERT(num_lanes >= N1);
 
+  // Ensure it matches the sort order. This accepts equal keys.
+  const size_t first_unsorted =
+      FirstUnsortedLane(st, out, num_lanes, hwy::SizeTag<N1>());
+  if (first_unsorted != num_lanes) {
+    const size_t i = first_unsorted - N1;
+    fprintf(stderr, "%s: i=%d of %d lanes: N1=%d", caller, static_cast<int>(i),
+            static_cast<int>(num_lanes), static_cast<int>(N1));
+    fprintf(stderr, "%5.0f %5.0f vs. %5.0f %5.0f\n\n",
+            static_cast<double>(out[i + 1]), static_cast<double>(out[i + 0]),
+            static_cast<double>(out[i + N1 + 1]),
+            static_cast<double>(out[i + N1]));
+    HWY_ABORT("%d-bit sort is incorrect\n",
+              static_cast<int>(sizeof(LaneType) * 8 * N1));
+  }
+
+  InputStats<LaneType> output_stats;
+  for (size_t i = 0; i < num_lanes; ++i) {
+    output_stats.Notify(out[i]);
+  }
+
+  return input_stats == output_stats;
+}
+
+// Verifies the output of Select: no key before `k_lanes` is ordered after the
+// key at `k_lanes`, and no key after it is ordered before it.
+template <class Traits, typename LaneType>
+bool VerifySelect(Traits st, const InputStats<LaneType>& input_stats,
+                  const LaneType* out, size_t num_lanes, size_t k_lanes,
+                  const char* caller) {
+  constexpr size_t N1 = st.LanesPerKey();
+  HWY_ASSERT(k_lanes < num_lanes);
+
+  InputStats<LaneType> output_stats;
+  for (size_t i = 0; i < num_lanes; i += N1) {
+    output_stats.Notify(out[i]);
+    if (N1 == 2) output_stats.Notify(out[i + 1]);
+    const bool wrong_side = (i < k_lanes) ? st.Compare1(out + k_lanes, out + i)
+                                          : st.Compare1(out + i, out + k_lanes);
+    if (wrong_side) {
+      fprintf(stderr, "%s: i=%d k=%d of %d lanes: N1=%d\n", caller,
+              static_cast<int>(i), static_cast<int>(k_lanes),
+              static_cast<int>(num_lanes), static_cast<int>(N1));
+      HWY_ABORT("%d-bit select is incorrect\n",
+                static_cast<int>(sizeof(LaneType) * 8 * N1));
+    }
+  }
+
+  return input_stats == output_stats;
+}
+
+// Verifies the output of PartialSort: the first `k_lanes` are sorted, and no
+// key after them is ordered before the last of them.
+template <class Traits, typename LaneType>
+bool VerifyPartialSort(Traits st, const InputStats<LaneType>& input_stats,
+                       const LaneType* out, size_t num_lanes, size_t k_lanes,
+                       const char* caller) {
+  constexpr size_t N1 = st.LanesPerKey();
+  if (k_lanes >= num_lanes) {
+    return VerifySort(st, input_stats, out, num_lanes, caller);
+  }
+
   InputStats<LaneType> output_stats;
-  // Ensure it matches the sort order
-  for (size_t i = 0; i < num_lanes - N1; i += N1) {
+  for (size_t i = 0; i < num_lanes; i += N1) {
     output_stats.Notify(out[i]);
     if (N1 == 2) output_stats.Notify(out[i + 1]);
-    // Reverse order instead of checking !Compare1 so we accept equal keys.
-    if (st.Compare1(out + i + N1, out + i)) {
-      fprintf(stderr, "%s: i=%d of %d lanes: N1=%d", caller,
-              static_cast<int>(i), static_cast<int>(num_lanes),
-              static_cast<int>(N1));
-      fprintf(stderr, "%5.0f %5.0f vs. %5.0f %5.0f\n\n",
-              static_cast<double>(out[i + 1]), static_cast<double>(out[i + 0]),
-              static_cast<double>(out[i + N1 + 1]),
-              static_cast<double>(out[i + N1]));
-      HWY_ABORT("%d-bit sort is incorrect\n",
+    if (i == 0) continue;
+    // Within the prefix, compare with the previous key; afterwards, with the
+    // last key of the prefix (if any).
+    const size_t prev = (i < k_lanes) ? i - N1 : k_lanes - N1;
+    if (k_lanes != 0 && st.Compare1(out + i, out + prev)) {
+      fprintf(stderr, "%s: i=%d k=%d of %d lanes: N1=%d\n", caller,
+              static_cast<int>(i), static_cast<int>(k_lanes),
+              static_cast<int>(num_lanes), static_cast<int>(N1));
+      HWY_ABORT("%d-bit partial sort is incorrect\n",
                 static_cast<int>(sizeof(LaneType) * 8 * N1));
     }
   }
-  output_stats.Notify(out[num_lanes - N1]);
-  if (N1 == 2) output_stats.Notify(out[num_lanes - N1 + 1]);
 
   return input_stats == output_stats;
 }
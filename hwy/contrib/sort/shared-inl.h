@@ -57,6 +57,11 @@ struct SortConstants {
   // To change, must also update left + 3 * N etc. in the loop.
   static constexpr size_t kPartitionUnroll = 4;
 
+  // Introspection: Recurse switches to worst-case N*logN heapsort after this
+  // many levels. Should never be reached, so computing log2 exactly does not
+  // help.
+  static constexpr size_t kMaxLevels = 50;
+
   // Chunk := group of keys loaded for sampling a pivot. Matches the typical
   // cache line size of 64 bytes to get maximum benefit per L2 miss. Sort()
   // ensures vectors are no larger than that, so this can be independent of the
@@ -0,0 +1,74 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Counters describing what vqsort did, for diagnosing unexpectedly slow sorts.
+// Only updated if vqsort-inl.h is compiled with VQSORT_STATS=1. Used by both
+// vqsort.h and VQSortStatic, hence a separate header as for order.h.
+
+#ifndef HIGHWAY_HWY_CONTRIB_SORT_SORT_STATS_H_
+#define HIGHWAY_HWY_CONTRIB_SORT_SORT_STATS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hwy/base.h"
+
+namespace hwy {
+
+struct SortStats {
+  // Adds the counters of `other`, e.g. to aggregate over threads or calls.
+  void Add(const SortStats& other) {
+    num_sorts += other.num_sorts;
+    max_depth = HWY_MAX(max_depth, other.max_depth);
+    num_partitions += other.num_partitions;
+    bytes_partitioned += other.bytes_partitioned;
+    num_two_key_partitions += other.num_two_key_partitions;
+    num_all_equal += other.num_all_equal;
+    num_base_cases += other.num_base_cases;
+    num_heap_sorts += other.num_heap_sorts;
+    num_counting_sorts += other.num_counting_sorts;
+    pivot_ticks += other.pivot_ticks;
+    partition_ticks += other.partition_ticks;
+    base_case_ticks += other.base_case_ticks;
+  }
+
+  // Calls to Sort, i.e. VQSort or VQSortStatic.
+  uint64_t num_sorts = 0;
+  // Deepest recursion level reached by Recurse, starting at 1. Values much
+  // larger than log2(num / 256) indicate poor pivots.
+  uint64_t max_depth = 0;
+  // Calls to Partition and the number of bytes they read and wrote. The latter
+  // includes the bytes moved via the buffer.
+  uint64_t num_partitions = 0;
+  uint64_t bytes_partitioned = 0;
+  // Subarrays that were done after partitioning into two keys, or found to
+  // contain only one key. Many of these indicate low-entropy input.
+  uint64_t num_two_key_partitions = 0;
+  uint64_t num_all_equal = 0;
+  // Subarrays sorted by sorting networks, HeapSort (which is only expected if
+  // the recursion depth limit was reached), or counting sort.
+  uint64_t num_base_cases = 0;
+  uint64_t num_heap_sorts = 0;
+  uint64_t num_counting_sorts = 0;
+  // Elapsed timer ticks (see hwy::timer and InvariantTicksPerSecond) spent
+  // choosing pivots, partitioning, and in base cases.
+  uint64_t pivot_ticks = 0;
+  uint64_t partition_ticks = 0;
+  uint64_t base_case_ticks = 0;
+};
+
+}  // namespace hwy
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_SORT_STATS_H_
@@ -15,6 +15,10 @@
 
 #include <stdio.h>
 
+#include <algorithm>  // std::stable_sort, std::rotate
+#include <functional>  // std::less
+#include <limits>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -30,6 +34,7 @@
 #include "hwy/contrib/sort/traits128-inl.h"
 #include "hwy/contrib/sort/vqsort-inl.h"  // BaseCase
 #include "hwy/contrib/sort/vqsort.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
 #include "hwy/highway.h"
 #include "hwy/per_target.h"
 #include "hwy/tests/test_util-inl.h"
@@ -732,6 +737,920 @@ void TestAllSort() {
   }
 }
 
+template <class Traits>
+void TestPartialSortAndSelect(size_t num_lanes) {
+#if VQSORT_ENABLED
+  using Order = typename Traits::Order;
+  using LaneType = typename Traits::LaneType;
+  using KeyType = typename Traits::KeyType;
+  SharedState shared;
+  SharedTraits<Traits> st;
+  constexpr size_t kLPK = st.LanesPerKey();
+
+  // Round up to a whole number of keys.
+  num_lanes += (st.Is128() && (num_lanes & 1));
+  const size_t num_keys = num_lanes / kLPK;
+
+  auto lanes = hwy::AllocateAligned<LaneType>(num_lanes);
+  auto expected = hwy::AllocateAligned<LaneType>(num_lanes);
+  HWY_ASSERT(lanes && expected);
+  for (Algo algo : {Algo::kVQSelect, Algo::kVQPartialSort}) {
+    for (Dist dist : AllDist()) {
+      for (size_t k_keys : {size_t{0}, size_t{1}, num_keys / 3, num_keys - 1,
+                            num_keys}) {
+        InputStats<LaneType> input_stats =
+            GenerateInput(dist, lanes.get(), num_lanes);
+        CopyBytes(lanes.get(), expected.get(), num_lanes * sizeof(LaneType));
+        Run<Order>(Algo::kStd, reinterpret_cast<KeyType*>(expected.get()),
+                   num_keys, shared, /*thread=*/0);
+
+        Run<Order>(algo, reinterpret_cast<KeyType*>(lanes.get()), num_keys,
+                   shared, /*thread=*/0, k_keys);
+        const size_t k_lanes = k_keys * kLPK;
+        size_t end_lanes = k_lanes;
+        if (algo == Algo::kVQSelect) {
+          if (k_keys == num_keys) continue;  // Nothing to select.
+          HWY_ASSERT(VerifySelect(st, input_stats, lanes.get(), num_lanes,
+                                  k_lanes, "TestSelect"));
+          end_lanes += kLPK;  // Only the selected key is defined.
+        } else {
+          HWY_ASSERT(VerifyPartialSort(st, input_stats, lanes.get(), num_lanes,
+                                       k_lanes, "TestPartialSort"));
+        }
+
+        // The selected (or sorted) keys match those of a full sort.
+        const size_t begin_lanes =
+            (algo == Algo::kVQSelect) ? k_lanes : size_t{0};
+        for (size_t i = begin_lanes; i < HWY_MIN(end_lanes, num_lanes);
+             i += kLPK) {
+          if (st.Compare1(&expected[i], &lanes[i]) ||
+              st.Compare1(&lanes[i], &expected[i])) {
+            HWY_ABORT("Type %s %s mismatch at %d, k=%d of %d\n",
+                      st.KeyString(), AlgoName(algo), static_cast<int>(i),
+                      static_cast<int>(k_lanes), static_cast<int>(num_lanes));
+          }
+        }
+      }  // k_keys
+    }    // dist
+  }      // algo
+#else
+  (void)num_lanes;
+#endif  // VQSORT_ENABLED
+}
+
+void TestAllPartialSortAndSelect() {
+  for (int num : {129, 3 * 1000, 34567}) {
+    const size_t num_lanes = AdjustedReps(static_cast<size_t>(num));
+    TestPartialSortAndSelect<TraitsLane<OrderAscending<int16_t> > >(num_lanes);
+    TestPartialSortAndSelect<TraitsLane<OtherOrder<uint32_t> > >(num_lanes);
+    TestPartialSortAndSelect<TraitsLane<OrderAscending<int64_t> > >(num_lanes);
+    TestPartialSortAndSelect<TraitsLane<OtherOrder<float> > >(num_lanes);
+#if HWY_HAVE_FLOAT64  // #if protects algo-inl's GenerateRandom
+    if (hwy::HaveFloat64()) {
+      TestPartialSortAndSelect<TraitsLane<OrderAscending<double> > >(
+          num_lanes);
+    }
+#endif
+
+#if !HAVE_VXSORT && !HAVE_INTEL && VQSORT_ENABLED
+    TestPartialSortAndSelect<Traits128<OrderAscending128> >(num_lanes);
+    TestPartialSortAndSelect<Traits128<OrderDescending128> >(num_lanes);
+    TestPartialSortAndSelect<TraitsLane<OrderAscendingKV64> >(num_lanes);
+    TestPartialSortAndSelect<Traits128<OrderDescendingKV128> >(num_lanes);
+#endif
+  }
+}
+
+template <class Traits>
+void TestParallelSort(ThreadPool& pool, size_t num_lanes) {
+  using Order = typename Traits::Order;
+  using LaneType = typename Traits::LaneType;
+  using KeyType = typename Traits::KeyType;
+  SharedTraits<Traits> st;
+
+  // Round up to a whole number of keys.
+  num_lanes += (st.Is128() && (num_lanes & 1));
+  const size_t num_keys = num_lanes / st.LanesPerKey();
+
+  auto lanes = hwy::AllocateAligned<LaneType>(num_lanes);
+  HWY_ASSERT(lanes);
+  for (Dist dist : AllDist()) {
+    InputStats<LaneType> input_stats =
+        GenerateInput(dist, lanes.get(), num_lanes);
+    CompareResults<Traits> compare(lanes.get(), num_lanes);
+    VQSort(reinterpret_cast<KeyType*>(lanes.get()), num_keys, Order(), pool);
+    HWY_ASSERT(compare.Verify(lanes.get()));
+    HWY_ASSERT(VerifySort(st, input_stats, lanes.get(), num_lanes,
+                          "TestParallelSort"));
+  }
+}
+
+void TestAllParallelSort() {
+  // More workers than cores is fine; this also exercises the parallel
+  // partitioning on machines with few cores.
+  ThreadPool pool(4);
+  for (int num : {1000, 100 * 1000, 345 * 1000}) {
+    const size_t num_lanes = AdjustedReps(static_cast<size_t>(num));
+    TestParallelSort<TraitsLane<OrderAscending<int32_t> > >(pool, num_lanes);
+    TestParallelSort<TraitsLane<OtherOrder<uint64_t> > >(pool, num_lanes);
+    TestParallelSort<TraitsLane<OrderAscending<float> > >(pool, num_lanes);
+
+#if !HAVE_VXSORT && !HAVE_INTEL && VQSORT_ENABLED
+    TestParallelSort<Traits128<OrderAscending128> >(pool, num_lanes);
+    TestParallelSort<TraitsLane<OrderDescendingKV64> >(pool, num_lanes);
+    TestParallelSort<Traits128<OrderAscendingKV128> >(pool, num_lanes);
+#endif
+  }
+}
+
+// Whether VQSort orders `a` before `b`. NaN are ordered last.
+template <typename T, class Order>
+bool OrderedBefore(T a, T b, Order order) {
+  const bool nan_a = !(a == a);
+  const bool nan_b = !(b == b);
+  if (nan_a || nan_b) return nan_b && !nan_a;
+  return order.IsAscending() ? (a < b) : (b < a);
+}
+
+// Permutes a column of type TC according to `indices`.
+template <typename TC, typename TI>
+void VerifyApplyPermutation(const std::vector<TI>& indices) {
+  const size_t num = indices.size();
+  std::vector<TC> column(num), out(num);
+  for (size_t i = 0; i < num; ++i) {
+    column[i] = static_cast<TC>(i * 0x9E3779B97F4A7C15ull);
+  }
+  VQApplyPermutation(indices.data(), num, column.data(), out.data());
+  for (size_t i = 0; i < num; ++i) {
+    HWY_ASSERT(out[i] == column[indices[i]]);
+  }
+}
+
+template <typename T, typename TI, class Order>
+void TestArgsort(RandomState& rng, size_t num, Order order) {
+  std::vector<T> keys(num), permuted(num);
+  std::vector<TI> indices(num);
+  for (size_t i = 0; i < num; ++i) {
+    // Also include duplicate keys.
+    keys[i] = (i & 3) ? RandomFiniteValue<T>(&rng)
+                      : static_cast<T>(Random32(&rng) & 7);
+  }
+  if (hwy::IsFloat<T>() && num >= 4) {
+    keys[0] = std::numeric_limits<T>::quiet_NaN();
+    keys[1] = -std::numeric_limits<T>::infinity();
+    keys[2] = static_cast<T>(-0.0);
+    keys[num - 1] = -std::numeric_limits<T>::quiet_NaN();
+  }
+
+  VQArgsort(keys.data(), num, indices.data(), order);
+  VQApplyPermutation(indices.data(), num, keys.data(), permuted.data());
+
+  std::vector<bool> seen(num);
+  for (size_t i = 0; i < num; ++i) {
+    HWY_ASSERT(indices[i] < num && !seen[indices[i]]);
+    seen[indices[i]] = true;
+    HWY_ASSERT(BytesEqual(&permuted[i], &keys[indices[i]], sizeof(T)));
+    if (i != 0 && OrderedBefore(permuted[i], permuted[i - 1], order)) {
+      HWY_ABORT("Argsort %s asc %d: misordered at %d of %d\n",
+                TypeName(T(), 1).c_str(), order.IsAscending(),
+                static_cast<int>(i), static_cast<int>(num));
+    }
+    // Stable: equivalent keys remain in their original order.
+    if (i != 0 && !OrderedBefore(permuted[i - 1], permuted[i], order)) {
+      HWY_ASSERT(indices[i - 1] < indices[i]);
+    }
+  }
+
+  VerifyApplyPermutation<uint8_t>(indices);
+  VerifyApplyPermutation<uint16_t>(indices);
+  VerifyApplyPermutation<uint32_t>(indices);
+  VerifyApplyPermutation<int64_t>(indices);
+}
+
+void TestAllArgsort() {
+  RandomState rng;
+  for (size_t num : {size_t{0}, size_t{1}, size_t{7}, size_t{1000},
+                     AdjustedReps(34567)}) {
+    TestArgsort<uint32_t, uint32_t>(rng, num, SortAscending());
+    TestArgsort<int32_t, uint32_t>(rng, num, SortDescending());
+    TestArgsort<float, uint32_t>(rng, num, SortAscending());
+    TestArgsort<float, uint32_t>(rng, num, SortDescending());
+    TestArgsort<uint64_t, uint64_t>(rng, num, SortDescending());
+    TestArgsort<int64_t, uint64_t>(rng, num, SortAscending());
+#if HWY_HAVE_FLOAT64
+    if (hwy::HaveFloat64()) {
+      TestArgsort<double, uint64_t>(rng, num, SortAscending());
+      TestArgsort<double, uint64_t>(rng, num, SortDescending());
+    }
+#endif
+  }
+}
+
+// Records are filled with a pattern that depends on their original index, plus
+// a possibly unaligned key at `key_offset`.
+template <typename TKey, class Order>
+void TestSortRecords(RandomState& rng, size_t num, size_t record_bytes,
+                     size_t key_offset, Order order) {
+  std::vector<uint8_t> records(num * record_bytes);
+  std::vector<TKey> keys(num);
+  for (size_t i = 0; i < num; ++i) {
+    uint8_t* record = records.data() + i * record_bytes;
+    for (size_t b = 0; b < record_bytes; ++b) {
+      record[b] = static_cast<uint8_t>(i * 31 + b);
+    }
+    // Few distinct keys, so that stability is observable.
+    keys[i] = static_cast<TKey>(Random32(&rng) % 50);
+    CopyBytes<sizeof(TKey)>(&keys[i], record + key_offset);
+  }
+  std::vector<uint8_t> expected(num * record_bytes);
+  {
+    std::vector<size_t> indices(num);
+    for (size_t i = 0; i < num; ++i) indices[i] = i;
+    std::stable_sort(indices.begin(), indices.end(), [&](size_t a, size_t b) {
+      return OrderedBefore(keys[a], keys[b], order);
+    });
+    for (size_t i = 0; i < num; ++i) {
+      CopyBytes(records.data() + indices[i] * record_bytes,
+                expected.data() + i * record_bytes, record_bytes);
+    }
+  }
+
+  VQSortRecords<TKey>(records.data(), num, record_bytes, key_offset, order);
+  HWY_ASSERT(records == expected);
+}
+
+void TestAllSortRecords() {
+  RandomState rng;
+  for (size_t num : {size_t{0}, size_t{1}, size_t{3}, size_t{1000},
+                     AdjustedReps(23456)}) {
+    TestSortRecords<uint32_t>(rng, num, 16, 4, SortAscending());
+    TestSortRecords<int32_t>(rng, num, 20, 13, SortDescending());
+    TestSortRecords<float>(rng, num, 8, 0, SortDescending());
+    TestSortRecords<uint64_t>(rng, num, 64, 56, SortDescending());
+    TestSortRecords<int64_t>(rng, num, 48, 3, SortAscending());
+#if HWY_HAVE_FLOAT64
+    if (hwy::HaveFloat64()) {
+      TestSortRecords<double>(rng, num, 32, 8, SortAscending());
+    }
+#endif
+  }
+}
+
+// Strings with long common prefixes, zero bytes, and some duplicates.
+template <typename TI, class Order>
+void TestSortStrings(RandomState& rng, size_t num, Order order) {
+  const std::string prefixes[3] = {"", "https://www.example.com/",
+                                   std::string("a\0b\0", 4)};
+  std::vector<std::string> strings(num);
+  for (std::string& str : strings) {
+    str = prefixes[Random32(&rng) % 3];
+    const size_t len = Random32(&rng) % 30;
+    for (size_t i = 0; i < len; ++i) {
+      // Small alphabet including zero and bytes >= 0x80.
+      const char alphabet[4] = {'\0', 'a', 'z', '\xF0'};
+      str.push_back(alphabet[Random32(&rng) & 3]);
+    }
+  }
+  std::vector<const char*> pointers(num);
+  std::vector<size_t> lengths(num);
+  for (size_t i = 0; i < num; ++i) {
+    pointers[i] = strings[i].data();
+    lengths[i] = strings[i].size();
+  }
+
+  std::vector<TI> indices(num);
+  VQSortStrings(pointers.data(), lengths.data(), num, indices.data(), order);
+
+  std::vector<std::string> expected = strings;
+  std::sort(expected.begin(), expected.end(),
+            [](const std::string& a, const std::string& b) {
+              return Order().IsAscending() ? a < b : b < a;
+            });
+  std::vector<bool> seen(num);
+  for (size_t i = 0; i < num; ++i) {
+    HWY_ASSERT(indices[i] < num && !seen[indices[i]]);
+    seen[indices[i]] = true;
+    HWY_ASSERT(strings[indices[i]] == expected[i]);
+  }
+}
+
+void TestAllSortStrings() {
+  RandomState rng;
+  for (size_t num : {size_t{0}, size_t{1}, size_t{5}, size_t{100},
+                     AdjustedReps(12345)}) {
+    TestSortStrings<uint32_t>(rng, num, SortAscending());
+    TestSortStrings<uint32_t>(rng, num, SortDescending());
+    TestSortStrings<uint64_t>(rng, num, SortAscending());
+  }
+}
+
+// Few distinct keys, including -0.0 and +0.0 and NaN with various payloads,
+// so that the order of equivalent keys is observable.
+template <typename T>
+T StableSortKey(RandomState& rng) {
+  const uint32_t bits = Random32(&rng);
+  switch (bits & 7) {
+    case 0:
+      return static_cast<T>(0.0);
+    case 1:
+      return static_cast<T>(-0.0);
+    case 2: {
+      using TU = MakeUnsigned<T>;
+      TU nan_bits;
+      const T nan = std::numeric_limits<T>::quiet_NaN();
+      CopySameSize(&nan, &nan_bits);
+      nan_bits |= static_cast<TU>((bits >> 3) & 0xFF);
+      nan_bits ^= (bits & 8) ? static_cast<TU>(0) : SignMask<T>();
+      T ret;
+      CopySameSize(&nan_bits, &ret);
+      return ret;
+    }
+    default:
+      return static_cast<T>(static_cast<int>((bits >> 3) & 15) - 8);
+  }
+}
+
+template <typename T, class Order>
+void TestStableSortFloat(RandomState& rng, size_t num, Order order) {
+  std::vector<T> keys(num);
+  for (size_t i = 0; i < num; ++i) {
+    keys[i] = StableSortKey<T>(rng);
+  }
+  std::vector<T> expected = keys;
+  std::stable_sort(expected.begin(), expected.end(), [order](T a, T b) {
+    return OrderedBefore(a, b, order);
+  });
+
+  VQStableSort(keys.data(), num, order);
+  for (size_t i = 0; i < num; ++i) {
+    if (!BytesEqual(&keys[i], &expected[i], sizeof(T))) {
+      HWY_ABORT("StableSort %s asc %d: mismatch at %d of %d\n",
+                TypeName(T(), 1).c_str(), order.IsAscending(),
+                static_cast<int>(i), static_cast<int>(num));
+    }
+  }
+}
+
+// Values are the original positions, hence must be ascending for equal keys.
+template <class KV, class Order>
+void TestStableSortKV(RandomState& rng, size_t num, Order order) {
+  std::vector<KV> kv(num);
+  for (size_t i = 0; i < num; ++i) {
+    kv[i].key = Random32(&rng) & 15;
+    kv[i].value = static_cast<decltype(kv[i].value)>(i);
+  }
+  VQStableSort(kv.data(), num, order);
+  for (size_t i = 1; i < num; ++i) {
+    const bool before = order.IsAscending() ? (kv[i].key < kv[i - 1].key)
+                                            : (kv[i - 1].key < kv[i].key);
+    HWY_ASSERT(!before);
+    if (kv[i].key == kv[i - 1].key) {
+      HWY_ASSERT(kv[i - 1].value < kv[i].value);
+    }
+  }
+}
+
+void TestAllStableSort() {
+  RandomState rng;
+  for (size_t num : {size_t{0}, size_t{1}, size_t{7}, size_t{1000},
+                     AdjustedReps(34567)}) {
+    TestStableSortFloat<float>(rng, num, SortAscending());
+    TestStableSortFloat<float>(rng, num, SortDescending());
+#if HWY_HAVE_FLOAT64
+    if (hwy::HaveFloat64()) {
+      TestStableSortFloat<double>(rng, num, SortAscending());
+      TestStableSortFloat<double>(rng, num, SortDescending());
+    }
+#endif
+    TestStableSortKV<K32V32>(rng, num, SortAscending());
+    TestStableSortKV<K32V32>(rng, num, SortDescending());
+    TestStableSortKV<K64V64>(rng, num, SortAscending());
+    TestStableSortKV<K64V64>(rng, num, SortDescending());
+  }
+}
+
+// Keys with many duplicates, and for floats also NaN.
+template <typename T, hwy::EnableIf<IsInteger<T>()>* = nullptr>
+T RandomMergeKey(RandomState& rng) {
+  return (Random32(&rng) & 3) ? RandomFiniteValue<T>(&rng)
+                              : static_cast<T>(Random32(&rng) & 15);
+}
+template <typename T, HWY_IF_FLOAT(T)>
+T RandomMergeKey(RandomState& rng) {
+  const uint32_t bits = Random32(&rng);
+  if ((bits & 63) == 0) return std::numeric_limits<T>::quiet_NaN();
+  return (bits & 3) ? RandomFiniteValue<T>(&rng)
+                    : static_cast<T>(static_cast<int>((bits >> 2) & 15) - 8);
+}
+template <typename T, HWY_IF_SAME(T, uint128_t)>
+T RandomMergeKey(RandomState& rng) {
+  return uint128_t{Random64(&rng), Random64(&rng) & 0xFF};
+}
+template <typename T, HWY_IF_SAME(T, K64V64)>
+T RandomMergeKey(RandomState& rng) {
+  return K64V64{Random64(&rng), Random64(&rng) & 0xFFF};
+}
+template <typename T, HWY_IF_SAME(T, K32V32)>
+T RandomMergeKey(RandomState& rng) {
+  return K32V32{Random32(&rng), Random32(&rng) & 0xFFF};
+}
+
+template <typename T, HWY_IF_FLOAT(T)>
+bool EquivalentKeys(T a, T b) {
+  return (ScalarIsNaN(a) && ScalarIsNaN(b)) || a == b;
+}
+template <typename T, HWY_IF_NOT_FLOAT(T)>
+bool EquivalentKeys(const T& a, const T& b) {
+  return !(a < b) && !(b < a);
+}
+
+// Equivalent keys are unordered, so check the values of key-value pairs via
+// their sum.
+template <typename T>
+uint64_t SumOfValues(const std::vector<T>&) {
+  return 0;
+}
+uint64_t SumOfValues(const std::vector<K64V64>& kv) {
+  uint64_t sum = 0;
+  for (const K64V64& x : kv) sum += x.value;
+  return sum;
+}
+uint64_t SumOfValues(const std::vector<K32V32>& kv) {
+  uint64_t sum = 0;
+  for (const K32V32& x : kv) sum += x.value;
+  return sum;
+}
+uint64_t SumOfValues(const std::vector<KI32V32>& kv) {
+  uint64_t sum = 0;
+  for (const KI32V32& x : kv) sum += x.value;
+  return sum;
+}
+uint64_t SumOfValues(const std::vector<KF32V32>& kv) {
+  uint64_t sum = 0;
+  for (const KF32V32& x : kv) sum += x.value;
+  return sum;
+}
+uint64_t SumOfValues(const std::vector<KI64V64>& kv) {
+  uint64_t sum = 0;
+  for (const KI64V64& x : kv) sum += x.value;
+  return sum;
+}
+uint64_t SumOfValues(const std::vector<KF64V64>& kv) {
+  uint64_t sum = 0;
+  for (const KF64V64& x : kv) sum += x.value;
+  return sum;
+}
+
+template <typename T>
+void VerifyMerged(const std::vector<T>& expected, const std::vector<T>& actual,
+                  const char* caller) {
+  HWY_ASSERT(expected.size() == actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    if (!EquivalentKeys(expected[i], actual[i])) {
+      HWY_ABORT("%s: mismatch at %d of %d, key size %d\n", caller,
+                static_cast<int>(i), static_cast<int>(expected.size()),
+                static_cast<int>(sizeof(T)));
+    }
+  }
+  HWY_ASSERT(SumOfValues(expected) == SumOfValues(actual));
+}
+
+template <typename T, class Order>
+void TestMerge(RandomState& rng, Order order) {
+  const size_t kSizes[][2] = {{0, 0},     {0, 5},      {1, 1},
+                              {7, 3},     {8, 8},      {33, 100},
+                              {1000, 1},  {999, 1001}, {17, 3333},
+                              {AdjustedReps(20000), 4567}};
+  for (const auto& sizes : kSizes) {
+    const size_t num_a = sizes[0];
+    const size_t num_b = sizes[1];
+    std::vector<T> keys(num_a + num_b);
+    for (T& key : keys) key = RandomMergeKey<T>(rng);
+    VQSort(keys.data(), num_a, order);
+    VQSort(keys.data() + num_a, num_b, order);
+
+    std::vector<T> merged(num_a + num_b);
+    VQMerge(keys.data(), num_a, keys.data() + num_a, num_b, merged.data(),
+            order);
+    VQSort(keys.data(), keys.size(), order);
+    VerifyMerged(keys, merged, "Merge");
+  }
+
+  // All small sizes, with one input consisting of equal keys within the range
+  // of the other. This covers either input falling below one vector (at most
+  // eight keys) while the other still has keys left in its pending buffer.
+  const size_t kMaxSmall = 4 * 8 + 4;
+  for (size_t num_a = 0; num_a <= kMaxSmall; ++num_a) {
+    for (size_t num_b = 0; num_b <= kMaxSmall; ++num_b) {
+      for (size_t quarter = 0; quarter <= 4; ++quarter) {
+        std::vector<T> keys(num_a + num_b);
+        for (T& key : keys) key = RandomMergeKey<T>(rng);
+        VQSort(keys.data(), keys.size(), order);
+        const size_t begin_b = num_a * quarter / 4;
+        for (size_t i = 1; i < num_b; ++i) keys[begin_b + i] = keys[begin_b];
+        // Move the `num_b` keys starting at `begin_b` to the end.
+        std::rotate(keys.begin() + static_cast<ptrdiff_t>(begin_b),
+                    keys.begin() + static_cast<ptrdiff_t>(begin_b + num_b),
+                    keys.end());
+        const T* a = keys.data();
+        const T* b = keys.data() + num_a;
+
+        std::vector<T> merged_ab(num_a + num_b);
+        std::vector<T> merged_ba(num_a + num_b);
+        VQMerge(a, num_a, b, num_b, merged_ab.data(), order);
+        VQMerge(b, num_b, a, num_a, merged_ba.data(), order);
+        VQSort(keys.data(), keys.size(), order);
+        VerifyMerged(keys, merged_ab, "MergeSmall");
+        VerifyMerged(keys, merged_ba, "MergeSmall");
+      }
+    }
+  }
+
+  // Runs of random length, including empty.
+  for (size_t num_runs : {size_t{0}, size_t{1}, size_t{2}, size_t{5},
+                          size_t{16}, size_t{63}}) {
+    std::vector<size_t> run_lengths(num_runs);
+    size_t num = 0;
+    for (size_t& len : run_lengths) {
+      len = (Random32(&rng) & 7) == 0 ? 0 : Random32(&rng) % 700;
+      num += len;
+    }
+    std::vector<T> keys(num);
+    for (T& key : keys) key = RandomMergeKey<T>(rng);
+    std::vector<const T*> runs(num_runs);
+    size_t pos = 0;
+    for (size_t i = 0; i < num_runs; ++i) {
+      runs[i] = keys.data() + pos;
+      VQSort(keys.data() + pos, run_lengths[i], order);
+      pos += run_lengths[i];
+    }
+
+    std::vector<T> merged(num);
+    VQMergeRuns(runs.data(), run_lengths.data(), num_runs, merged.data(),
+                order);
+    VQSort(keys.data(), num, order);
+    VerifyMerged(keys, merged, "MergeRuns");
+  }
+}
+
+void TestAllMerge() {
+  RandomState rng;
+  TestMerge<uint16_t>(rng, SortAscending());
+  TestMerge<int16_t>(rng, SortDescending());
+  TestMerge<uint32_t>(rng, SortDescending());
+  TestMerge<int32_t>(rng, SortAscending());
+  TestMerge<uint64_t>(rng, SortAscending());
+  TestMerge<int64_t>(rng, SortDescending());
+  TestMerge<float>(rng, SortAscending());
+  TestMerge<float>(rng, SortDescending());
+#if HWY_HAVE_FLOAT64
+  if (hwy::HaveFloat64()) {
+    TestMerge<double>(rng, SortAscending());
+    TestMerge<double>(rng, SortDescending());
+  }
+#endif
+  TestMerge<uint128_t>(rng, SortAscending());
+  TestMerge<uint128_t>(rng, SortDescending());
+  TestMerge<K64V64>(rng, SortAscending());
+  TestMerge<K64V64>(rng, SortDescending());
+  TestMerge<K32V32>(rng, SortAscending());
+  TestMerge<K32V32>(rng, SortDescending());
+}
+
+template <typename T, class Order>
+void TestSortSegments(RandomState& rng, Order order, ThreadPool& pool) {
+  for (size_t num_segments :
+       {size_t{0}, size_t{1}, size_t{7}, AdjustedReps(300)}) {
+    // Mostly small segments, some empty, and occasionally a large one. Keys
+    // before the first offset must not be modified.
+    std::vector<size_t> offsets(num_segments + 1);
+    offsets[0] = 3;
+    for (size_t i = 0; i < num_segments; ++i) {
+      const uint32_t bits = Random32(&rng);
+      const size_t len = (bits & 31) == 0 ? 3000 + (bits >> 5) % 3000
+                         : (bits & 7) == 0 ? 0
+                                           : (bits >> 5) % 513;
+      offsets[i + 1] = offsets[i] + len;
+    }
+    std::vector<T> keys(offsets[num_segments] + 2);
+    for (T& key : keys) key = RandomMergeKey<T>(rng);
+
+    std::vector<T> expected = keys;
+    for (size_t i = 0; i < num_segments; ++i) {
+      VQSort(expected.data() + offsets[i], offsets[i + 1] - offsets[i], order);
+    }
+
+    std::vector<T> actual = keys;
+    VQSortSegments(actual.data(), offsets.data(), num_segments, order);
+    VerifyMerged(expected, actual, "SortSegments");
+
+    actual = keys;
+    VQSortSegments(actual.data(), offsets.data(), num_segments, order, pool);
+    VerifyMerged(expected, actual, "ParallelSortSegments");
+  }
+}
+
+void TestAllSortSegments() {
+  RandomState rng;
+  ThreadPool pool(4);
+  TestSortSegments<uint16_t>(rng, SortAscending(), pool);
+  TestSortSegments<int32_t>(rng, SortDescending(), pool);
+  TestSortSegments<uint64_t>(rng, SortAscending(), pool);
+  TestSortSegments<float>(rng, SortAscending(), pool);
+  TestSortSegments<float>(rng, SortDescending(), pool);
+#if HWY_HAVE_FLOAT64
+  if (hwy::HaveFloat64()) {
+    TestSortSegments<double>(rng, SortDescending(), pool);
+  }
+#endif
+  TestSortSegments<uint128_t>(rng, SortDescending(), pool);
+  TestSortSegments<K64V64>(rng, SortAscending(), pool);
+  TestSortSegments<K32V32>(rng, SortDescending(), pool);
+}
+
+template <class KV>
+KV RandomSignedKV(RandomState& rng) {
+  using TK = decltype(KV::key);
+  using TV = decltype(KV::value);
+  const uint32_t bits = Random32(&rng);
+  KV kv;
+  kv.value = static_cast<TV>(Random64(&rng));
+  if ((bits & 7) == 0) {
+    // Many duplicates, including -0.0 and +0.0 for floats.
+    kv.key = static_cast<TK>(static_cast<int>((bits >> 3) & 7) - 4);
+    if (IsFloat<TK>() && (bits & 0x800)) kv.key = -kv.key;
+  } else if ((bits & 63) == 1 && IsFloat<TK>()) {
+    kv.key = std::numeric_limits<TK>::infinity();
+    if (bits & 64) kv.key = -kv.key;
+  } else {
+    kv.key = RandomFiniteValue<TK>(&rng);
+  }
+  return kv;
+}
+
+template <class KV, class Order>
+void TestSortSignedKV(RandomState& rng, Order order) {
+  using TK = decltype(KV::key);
+  for (size_t num : {size_t{0}, size_t{1}, size_t{9}, size_t{100},
+                     AdjustedReps(3000), AdjustedReps(40000)}) {
+    std::vector<KV> keys(num);
+    for (KV& kv : keys) kv = RandomSignedKV<KV>(rng);
+
+    std::vector<KV> expected = keys;
+    if (Order().IsAscending()) {
+      std::sort(expected.begin(), expected.end(), std::less<KV>());
+    } else {
+      std::sort(expected.begin(), expected.end(), std::greater<KV>());
+    }
+
+    std::vector<KV> actual = keys;
+    VQSort(actual.data(), num, order);
+    VerifyMerged(expected, actual, "SortSignedKV");
+#if VQSORT_ENABLED
+    actual = keys;
+    VQSortStatic(actual.data(), num, order);  // for the current target
+    VerifyMerged(expected, actual, "SortSignedKVStatic");
+#endif
+    // Equivalent floating-point zeros are ordered by their sign bit.
+    for (size_t i = 1; i < num; ++i) {
+      if (actual[i - 1].key != TK{0} || actual[i].key != TK{0}) continue;
+      const bool neg_before = ScalarSignBit(actual[i - 1].key);
+      const bool neg_after = ScalarSignBit(actual[i].key);
+      HWY_ASSERT(Order().IsAscending() ? (neg_before || !neg_after)
+                                       : (neg_after || !neg_before));
+    }
+
+    if (num == 0) continue;
+    const size_t k = num / 3;
+    actual = keys;
+    VQSelect(actual.data(), num, k, order);
+    HWY_ASSERT(EquivalentKeys(expected[k], actual[k]));
+    actual = keys;
+    VQPartialSort(actual.data(), num, k, order);
+    for (size_t i = 0; i < k; ++i) {
+      HWY_ASSERT(EquivalentKeys(expected[i], actual[i]));
+    }
+  }
+}
+
+void TestAllSortSignedKV() {
+  RandomState rng;
+  TestSortSignedKV<KI32V32>(rng, SortAscending());
+  TestSortSignedKV<KI32V32>(rng, SortDescending());
+  TestSortSignedKV<KF32V32>(rng, SortAscending());
+  TestSortSignedKV<KF32V32>(rng, SortDescending());
+  TestSortSignedKV<KI64V64>(rng, SortAscending());
+  TestSortSignedKV<KI64V64>(rng, SortDescending());
+  TestSortSignedKV<KF64V64>(rng, SortAscending());
+  TestSortSignedKV<KF64V64>(rng, SortDescending());
+}
+
+// Keys in [base, base + range), which are sorted by counting if the range is
+// small enough relative to their number.
+template <typename T, class Order>
+void TestNarrowRange(RandomState& rng, T base, uint64_t range, size_t num,
+                     Order order) {
+  std::vector<T> keys(num);
+  for (T& key : keys) {
+    key = static_cast<T>(static_cast<uint64_t>(base) + Random64(&rng) % range);
+  }
+  std::vector<T> expected = keys;
+  if (Order().IsAscending()) {
+    std::sort(expected.begin(), expected.end(), std::less<T>());
+  } else {
+    std::sort(expected.begin(), expected.end(), std::greater<T>());
+  }
+
+  VQSort(keys.data(), num, order);
+  HWY_ASSERT(expected == keys);
+}
+
+void TestAllNarrowRange() {
+  RandomState rng;
+  const size_t num = AdjustedReps(20000);
+  for (uint64_t range : {uint64_t{1}, uint64_t{2}, uint64_t{512},
+                         uint64_t{513}, uint64_t{1000}, num / 2,
+                         uint64_t{num}, 4 * uint64_t{num}}) {
+    TestNarrowRange<int16_t>(rng, -700, range, num, SortAscending());
+    TestNarrowRange<uint16_t>(rng, 60000, HWY_MIN(range, 5535), num,
+                              SortDescending());
+    TestNarrowRange<int32_t>(rng, -500, range, num, SortDescending());
+    TestNarrowRange<uint32_t>(rng, 0xFFFF0000u, range, num, SortAscending());
+    // Signed range spanning zero and the unsigned wraparound.
+    TestNarrowRange<int64_t>(rng, -3, range, num, SortAscending());
+    TestNarrowRange<uint64_t>(rng, ~uint64_t{0} - range + 1, range, num,
+                              SortDescending());
+  }
+}
+
+// Returns a u64 whose unsigned order matches IEEE 754 totalOrder of `bits`.
+template <typename TF, typename TU = MakeUnsigned<TF>>
+uint64_t TotalOrderKey(TU bits) {
+  const TU sign = static_cast<TU>(TU{1} << (sizeof(TU) * 8 - 1));
+  return static_cast<TU>((bits & sign) ? ~bits : (bits | sign));
+}
+
+template <typename TF, typename TU = MakeUnsigned<TF>>
+bool IsNaNBits(TU bits) {
+  return static_cast<TU>(bits & ~SignMask<TF>()) > ExponentMask<TF>();
+}
+
+// Returns the bits of floating-point keys, including NaN, zeros and infinities.
+template <typename TF, typename TU = MakeUnsigned<TF>>
+std::vector<TU> RandomFloatBits(RandomState& rng, size_t num) {
+  const TU sign = SignMask<TF>();
+  const TU exp = ExponentMask<TF>();
+  std::vector<TU> bits(num);
+  for (TU& b : bits) {
+    const uint32_t r = Random32(&rng);
+    const TU random = static_cast<TU>(Random64(&rng));
+    switch (r & 7) {
+      case 0:  // NaN with random sign and nonzero payload
+        b = static_cast<TU>((random & (sign | MantissaMask<TF>())) | exp);
+        if (b == exp || b == (exp | sign)) b |= 1;
+        break;
+      case 1:  // +/- 0
+        b = static_cast<TU>(random & sign);
+        break;
+      case 2:  // +/- inf
+        b = static_cast<TU>((random & sign) | exp);
+        break;
+      default:  // any finite value
+        b = random;
+        if ((b & exp) == exp) b = static_cast<TU>(b & ~exp);
+        break;
+    }
+  }
+  return bits;
+}
+
+// Verifies that `actual` is a permutation of `bits` ordered by `float_order`.
+template <typename TF, typename TU = MakeUnsigned<TF>>
+void VerifyFloatOrder(const std::vector<TU>& bits,
+                      const std::vector<TU>& actual, bool is_ascending,
+                      FloatOrder float_order) {
+  const size_t num = bits.size();
+  HWY_ASSERT_EQ(num, actual.size());
+
+  // All bit patterns, including NaN payloads, are preserved.
+  std::vector<TU> expected_bits = bits;
+  std::vector<TU> actual_bits = actual;
+  std::sort(expected_bits.begin(), expected_bits.end());
+  std::sort(actual_bits.begin(), actual_bits.end());
+  HWY_ASSERT(expected_bits == actual_bits);
+
+  size_t begin = 0;
+  size_t end = num;
+  if (float_order != FloatOrder::kTotalOrder) {
+    const bool nan_first = float_order == FloatOrder::kNaNFirst;
+    const size_t num_nan = static_cast<size_t>(
+        std::count_if(bits.begin(), bits.end(), IsNaNBits<TF>));
+    for (size_t i = 0; i < num; ++i) {
+      const bool in_nan_range =
+          nan_first ? (i < num_nan) : (i >= num - num_nan);
+      HWY_ASSERT_EQ(in_nan_range, IsNaNBits<TF>(actual[i]));
+    }
+    begin = nan_first ? num_nan : 0;
+    end = nan_first ? num : num - num_nan;
+  }
+
+  // The remaining keys are in totalOrder (which orders -0.0 before +0.0).
+  for (size_t i = begin + 1; i < end; ++i) {
+    const uint64_t prev = TotalOrderKey<TF>(actual[i - 1]);
+    const uint64_t cur = TotalOrderKey<TF>(actual[i]);
+    HWY_ASSERT(is_ascending ? (prev <= cur) : (prev >= cur));
+  }
+}
+
+template <typename TF>
+void TestFloatOrder(RandomState& rng, bool is_ascending,
+                    FloatOrder float_order) {
+  using TU = MakeUnsigned<TF>;
+  for (size_t num : {size_t{0}, size_t{1}, size_t{9}, size_t{100},
+                     AdjustedReps(3000)}) {
+    const std::vector<TU> bits = RandomFloatBits<TF>(rng, num);
+    std::vector<TF> keys(num);
+    for (size_t i = 0; i < num; ++i) keys[i] = BitCastScalar<TF>(bits[i]);
+    if (is_ascending) {
+      VQSort(keys.data(), num, SortAscending(), float_order);
+    } else {
+      VQSort(keys.data(), num, SortDescending(), float_order);
+    }
+
+    std::vector<TU> actual(num);
+    for (size_t i = 0; i < num; ++i) actual[i] = BitCastScalar<TU>(keys[i]);
+    VerifyFloatOrder<TF>(bits, actual, is_ascending, float_order);
+  }
+}
+
+void TestAllFloatOrder() {
+  RandomState rng;
+  for (FloatOrder float_order : {FloatOrder::kNaNFirst, FloatOrder::kNaNLast,
+                                 FloatOrder::kTotalOrder}) {
+    for (bool is_ascending : {true, false}) {
+      TestFloatOrder<float16_t>(rng, is_ascending, float_order);
+      TestFloatOrder<float>(rng, is_ascending, float_order);
+      TestFloatOrder<double>(rng, is_ascending, float_order);
+    }
+  }
+}
+
+template <typename T>
+void TestSort8(RandomState& rng) {
+  for (size_t num : {size_t{0}, size_t{1}, size_t{3}, size_t{100},
+                     AdjustedReps(5000)}) {
+    // Narrow ranges result in many duplicates.
+    for (uint32_t mask : {0x03u, 0x3Fu, 0xFFu}) {
+      std::vector<T> keys(num);
+      for (T& key : keys) {
+        key = static_cast<T>(Random32(&rng) & mask);
+        if (IsSigned<T>() && (Random32(&rng) & 1)) key = static_cast<T>(~key);
+      }
+
+      std::vector<T> expected = keys;
+      std::sort(expected.begin(), expected.end(), std::less<T>());
+      std::vector<T> actual = keys;
+      VQSort(actual.data(), num, SortAscending());
+      HWY_ASSERT(expected == actual);
+
+      std::sort(expected.begin(), expected.end(), std::greater<T>());
+      actual = keys;
+      VQSort(actual.data(), num, SortDescending());
+      HWY_ASSERT(expected == actual);
+    }
+  }
+}
+
+void TestAllSortNarrowTypes() {
+  RandomState rng;
+  TestSort8<uint8_t>(rng);
+  TestSort8<int8_t>(rng);
+
+  // bf16 NaN are ordered last in both directions, and -0.0 precedes +0.0 if
+  // ascending.
+  using TU = uint16_t;
+  for (size_t num : {size_t{0}, size_t{1}, size_t{9}, size_t{100},
+                     AdjustedReps(3000)}) {
+    for (bool is_ascending : {true, false}) {
+      const std::vector<TU> bits = RandomFloatBits<bfloat16_t>(rng, num);
+      std::vector<bfloat16_t> keys(num);
+      for (size_t i = 0; i < num; ++i) {
+        keys[i] = BitCastScalar<bfloat16_t>(bits[i]);
+      }
+      if (is_ascending) {
+        VQSort(keys.data(), num, SortAscending());
+      } else {
+        VQSort(keys.data(), num, SortDescending());
+      }
+
+      std::vector<TU> actual(num);
+      for (size_t i = 0; i < num; ++i) actual[i] = BitCastScalar<TU>(keys[i]);
+      VerifyFloatOrder<bfloat16_t>(bits, actual, is_ascending,
+                                   FloatOrder::kNaNLast);
+    }
+  }
+}
+
 }  // namespace
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
@@ -750,6 +1669,18 @@ HWY_EXPORT_AND_TEST_P(SortTest, TestAllBaseCase);
 HWY_EXPORT_AND_TEST_P(SortTest, TestAllPartition);
 HWY_EXPORT_AND_TEST_P(SortTest, TestAllGenerator);
 HWY_EXPORT_AND_TEST_P(SortTest, TestAllSort);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllPartialSortAndSelect);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllParallelSort);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllArgsort);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllSortRecords);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllSortStrings);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllStableSort);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllMerge);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllSortSegments);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllSortSignedKV);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllNarrowRange);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllFloatOrder);
+HWY_EXPORT_AND_TEST_P(SortTest, TestAllSortNarrowTypes);
 }  // namespace
 }  // namespace hwy
 
@@ -0,0 +1,153 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Per-target include guard
+#if defined(HIGHWAY_HWY_CONTRIB_SORT_TOPK_TOGGLE) == \
+    defined(HWY_TARGET_TOGGLE)  // NOLINT
+#ifdef HIGHWAY_HWY_CONTRIB_SORT_TOPK_TOGGLE
+#undef HIGHWAY_HWY_CONTRIB_SORT_TOPK_TOGGLE
+#else
+#define HIGHWAY_HWY_CONTRIB_SORT_TOPK_TOGGLE
+#endif
+
+#include <stddef.h>
+
+#include <algorithm>   // std::nth_element
+#include <functional>  // std::less
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+// Streaming top-k: accumulates batches of keys of unbounded total size and
+// returns the first `k` of them in sort order `Order`, i.e. the smallest for
+// SortAscending and the largest for SortDescending.
+//
+// Once `k` keys have been seen, the k-th of them is a threshold: keys not
+// ordered before it cannot be in the result. Each vector of input is compared
+// once with the threshold and the remaining lanes are appended to a candidate
+// buffer with CompressBlendedStore. When the buffer is full, VQSelectStatic
+// moves the best `k` candidates to its front, which tightens the threshold.
+// Thus for long streams, most vectors are discarded after a single compare.
+//
+// Supports 16-64 bit integer, float and double keys (the latter only #if
+// HWY_HAVE_FLOAT64). NaN are ignored. Not thread-safe.
+template <typename T, class Order>
+class TopK {
+  using D = ScalableTag<T>;
+
+ public:
+  // `k` must be nonzero.
+  explicit TopK(size_t k)
+      : k_(k), capacity_(2 * k + 4 * Lanes(D())) {
+    HWY_ASSERT(k != 0);
+    candidates_ = AllocateAligned<T>(capacity_);
+    HWY_ASSERT(candidates_);
+  }
+
+  size_t K() const { return k_; }
+
+  // Adds keys[0, num), which may be called any number of times.
+  void Update(const T* HWY_RESTRICT keys, size_t num) {
+    const D d;
+    const size_t N = Lanes(d);
+    size_t i = 0;
+    if (num >= N) {
+      for (; i <= num - N; i += N) {
+        const Vec<D> v = LoadU(d, keys + i);
+        Append(d, v, Keep(d, v));
+      }
+    }
+    const size_t remaining = num - i;
+    if (remaining != 0) {
+      const Vec<D> v = LoadN(d, keys + i, remaining);
+      Append(d, v, And(FirstN(d, remaining), Keep(d, v)));
+    }
+  }
+
+  // Writes the min(k, number of non-NaN keys seen) first keys in sort order to
+  // `out` and returns their number. May compact the candidates, but does not
+  // change the result, hence Update may be called afterwards.
+  size_t Get(T* HWY_RESTRICT out) {
+    Compact();
+    const size_t num = HWY_MIN(k_, size_);
+    CopyBytes(candidates_.get(), out, num * sizeof(T));
+#if VQSORT_ENABLED
+    VQSortStatic(out, num, Order());
+#else
+    std::sort(out, out + num, Less);
+#endif
+    return num;
+  }
+
+ private:
+  // Whether `a` is ordered before `b`, for the std:: fallback.
+  static bool Less(const T& a, const T& b) {
+    return Order().IsAscending() ? a < b : b < a;
+  }
+
+  // Returns which lanes might belong to the top k.
+  Mask<D> Keep(D d, Vec<D> v) const {
+    Mask<D> keep = Eq(v, v);  // false for NaN
+    if (has_threshold_) {
+      const Vec<D> threshold = Set(d, threshold_);
+      keep = And(keep, Order().IsAscending() ? Lt(v, threshold)
+                                             : Gt(v, threshold));
+    }
+    return keep;
+  }
+
+  void Append(D d, Vec<D> v, Mask<D> keep) {
+    // Fast path: the entire vector is discarded.
+    if (!AllFalse(d, keep)) {
+      if (HWY_UNLIKELY(size_ + Lanes(d) > capacity_)) Compact();
+      size_ += CompressBlendedStore(v, keep, d, candidates_.get() + size_);
+    }
+  }
+
+  // Moves the first k candidates in sort order to the front and discards the
+  // others, which ensures there is space for at least one more vector.
+  void Compact() {
+    if (size_ <= k_) return;
+    T* HWY_RESTRICT candidates = candidates_.get();
+#if VQSORT_ENABLED
+    VQSelectStatic(candidates, size_, k_ - 1, Order());
+#else
+    std::nth_element(candidates, candidates + k_ - 1, candidates + size_,
+                     Less);
+#endif
+    size_ = k_;
+    threshold_ = candidates[k_ - 1];
+    has_threshold_ = true;
+  }
+
+  const size_t k_;
+  const size_t capacity_;
+  AlignedFreeUniquePtr<T[]> candidates_;
+  size_t size_ = 0;
+  T threshold_ = T();
+  bool has_threshold_ = false;
+};
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_TOPK_TOGGLE
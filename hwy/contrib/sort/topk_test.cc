@@ -0,0 +1,112 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>   // std::sort
+#include <functional>  // std::greater
+#include <limits>
+#include <vector>
+
+#include "hwy/base.h"
+
+// clang-format off
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "hwy/contrib/sort/topk_test.cc"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+#include "hwy/highway.h"
+#include "hwy/contrib/sort/topk-inl.h"
+#include "hwy/tests/test_util-inl.h"
+// clang-format on
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace {
+
+template <typename T, class Order>
+void TestTopK(RandomState& rng, size_t k, size_t num_batches, Order) {
+  TopK<T, Order> top(k);
+  std::vector<T> all;
+  for (size_t batch = 0; batch < num_batches; ++batch) {
+    // Batches of varying size, including empty, with many duplicates.
+    const size_t num = Random32(&rng) % 600;
+    std::vector<T> keys(num);
+    for (T& key : keys) {
+      key = ConvertScalarTo<T>(Random32(&rng) % 2000);
+      if (IsFloat<T>() && (Random32(&rng) & 255) == 0) {
+        key = ConvertScalarTo<T>(std::numeric_limits<double>::quiet_NaN());
+      }
+    }
+    top.Update(keys.data(), num);
+    for (T key : keys) {
+      if (key == key) all.push_back(key);  // skip NaN
+    }
+  }
+
+  if (Order().IsAscending()) {
+    std::sort(all.begin(), all.end());
+  } else {
+    std::sort(all.begin(), all.end(), std::greater<T>());
+  }
+  all.resize(HWY_MIN(k, all.size()));
+
+  std::vector<T> actual(k);
+  const size_t num = top.Get(actual.data());
+  HWY_ASSERT_EQ(all.size(), num);
+  HWY_ASSERT(std::equal(all.begin(), all.end(), actual.begin()));
+}
+
+// TopK always uses full vectors, hence there is no need for ForPartialVectors.
+template <typename T>
+void TestTopKType() {
+  RandomState rng;
+  for (size_t k : {size_t{1}, size_t{7}, size_t{100}, size_t{3000}}) {
+    for (size_t num_batches : {size_t{0}, size_t{1}, size_t{50}}) {
+      TestTopK<T>(rng, k, num_batches, SortAscending());
+      TestTopK<T>(rng, k, num_batches, SortDescending());
+    }
+  }
+}
+
+}  // namespace
+
+void TestAllTopK() {
+  TestTopKType<uint16_t>();
+  TestTopKType<int16_t>();
+  TestTopKType<uint32_t>();
+  TestTopKType<int32_t>();
+  TestTopKType<uint64_t>();
+  TestTopKType<int64_t>();
+  TestTopKType<float>();
+#if HWY_HAVE_FLOAT64
+  TestTopKType<double>();
+#endif
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+
+namespace hwy {
+HWY_BEFORE_TEST(TopKTest);
+HWY_EXPORT_AND_TEST_P(TopKTest, TestAllTopK);
+}  // namespace hwy
+
+#endif
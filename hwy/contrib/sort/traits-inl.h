@@ -537,6 +537,177 @@ struct OrderDescendingKV64 : public KeyValue64 {
   }
 };
 
+// Key-value types with signed or floating-point keys (KI32V32, KF32V32,
+// KI64V64, KF64V64) reuse the traits for unsigned keys. Their u64 lanes are
+// encoded such that unsigned comparisons match the order of the original keys:
+// the key's sign bit `kSign` is flipped, and for negative floating-point keys
+// also the other key bits `kMagnitude`. Encoding happens in registers within
+// Compare/First/Last, so there is no separate pass over the keys. Each lane is
+// encoded independently, which also changes the order of values (in the lower
+// lane of 128-bit keys) but remains a strict weak ordering.
+template <typename KeyTypeArg, uint64_t kSign, uint64_t kMagnitude>
+struct KeyCodec {
+  using KeyType = KeyTypeArg;
+
+  template <class D>
+  static HWY_INLINE Vec<D> Encode(D d, Vec<D> v) {
+    if (kMagnitude == 0) return Xor(v, Set(d, kSign));
+    const RebindToSigned<D> di;
+    const Vec<D> negative = BitCast(d, BroadcastSignBit(BitCast(di, v)));
+    return Xor(v, OrAnd(Set(d, kSign), negative, Set(d, kMagnitude)));
+  }
+
+  // Inverse of Encode. Encoded negative keys have a cleared sign bit.
+  template <class D>
+  static HWY_INLINE Vec<D> Decode(D d, Vec<D> v) {
+    if (kMagnitude == 0) return Xor(v, Set(d, kSign));
+    const RebindToSigned<D> di;
+    const Vec<D> positive = BitCast(d, BroadcastSignBit(BitCast(di, v)));
+    return Xor(v, Or(Set(d, kSign), AndNot(positive, Set(d, kMagnitude))));
+  }
+
+  static HWY_INLINE uint64_t Encode1(uint64_t lane) {
+    return lane ^ (kSign | ((lane >> 63) ? kMagnitude : 0));
+  }
+
+  static const char* KeyString() {
+    return IsSame<KeyType, hwy::KI32V32>()   ? "i32+v=64"
+           : IsSame<KeyType, hwy::KF32V32>() ? "f32+v=64"
+           : IsSame<KeyType, hwy::KI64V64>() ? "i64+v=128"
+           : IsSame<KeyType, hwy::KF64V64>() ? "f64+v=128"
+                                             : "?";
+  }
+};
+
+using CodecKI32 = KeyCodec<hwy::KI32V32, 0x8000000000000000ull, 0>;
+using CodecKF32 =
+    KeyCodec<hwy::KF32V32, 0x8000000000000000ull, 0x7FFFFFFF00000000ull>;
+using CodecKI64 = KeyCodec<hwy::KI64V64, 0x8000000000000000ull, 0>;
+using CodecKF64 =
+    KeyCodec<hwy::KF64V64, 0x8000000000000000ull, 0x7FFFFFFFFFFFFFFFull>;
+
+// Floating-point keys (see FloatOrder) are sorted as unsigned lanes of the same
+// size. Flipping the sign bit, and for negative keys also all other bits,
+// results in IEEE 754 totalOrder. For kNaN > 0, the encoding is additionally
+// rotated such that negative NaN wrap around to after the positive NaN, hence
+// all NaN are ordered after +inf. For kNaN < 0, positive NaN wrap around to
+// before the negative NaN, which are ordered before -inf. This only requires
+// integer operations, hence also works for f16/f64 without native support.
+template <typename KeyTypeArg, int kNaN>
+struct FloatCodec {
+  using KeyType = KeyTypeArg;
+  using TU = MakeUnsigned<KeyType>;
+  static constexpr TU kSign = static_cast<TU>(TU{1} << (sizeof(TU) * 8 - 1));
+  // Number of NaN encodings with the same sign.
+  static constexpr TU kNumNaN = MantissaMask<KeyType>();
+  static constexpr TU kRotate = (kNaN > 0)   ? static_cast<TU>(0u - kNumNaN)
+                                : (kNaN < 0) ? kNumNaN
+                                             : TU{0};
+
+  template <class D>
+  static HWY_INLINE Vec<D> Encode(D d, Vec<D> v) {
+    const RebindToSigned<D> di;
+    const Vec<D> negative = BitCast(d, BroadcastSignBit(BitCast(di, v)));
+    const Vec<D> total = Xor(v, Or(negative, Set(d, kSign)));
+    return kRotate == 0 ? total : Add(total, Set(d, kRotate));
+  }
+
+  // Inverse of Encode. Encoded negative keys have a cleared sign bit.
+  template <class D>
+  static HWY_INLINE Vec<D> Decode(D d, Vec<D> v) {
+    if (kRotate != 0) v = Sub(v, Set(d, kRotate));
+    const RebindToSigned<D> di;
+    const Vec<D> positive = BitCast(d, BroadcastSignBit(BitCast(di, v)));
+    return Xor(v, Or(Not(positive), Set(d, kSign)));
+  }
+
+  static HWY_INLINE TU Encode1(TU lane) {
+    const TU flip = (lane & kSign) ? static_cast<TU>(~TU{0}) : kSign;
+    return static_cast<TU>((lane ^ flip) + kRotate);
+  }
+
+  static const char* KeyString() {
+    return sizeof(KeyType) == 2 ? (IsSame<KeyType, bfloat16_t>() ? "bf16"
+                                                                  : "f16")
+           : sizeof(KeyType) == 4 ? "f32"
+                                  : "f64";
+  }
+};
+
+// Wraps an Order* for unsigned keys (Base) such that it applies to lanes whose
+// keys are encoded by Codec. Used for both TraitsLane and Traits128.
+template <class Base, class Codec>
+struct OrderEncoded : public Base {
+  using LaneType = typename Base::LaneType;
+  using KeyType = typename Codec::KeyType;
+  using OrderForSortingNetwork =
+      OrderEncoded<typename Base::OrderForSortingNetwork, Codec>;
+
+  const char* KeyString() const { return Codec::KeyString(); }
+
+  HWY_INLINE bool Compare1(const LaneType* a, const LaneType* b) const {
+    LaneType encoded_a[2];
+    LaneType encoded_b[2];
+    for (size_t i = 0; i < this->LanesPerKey(); ++i) {
+      encoded_a[i] = Codec::Encode1(a[i]);
+      encoded_b[i] = Codec::Encode1(b[i]);
+    }
+    return Base::Compare1(encoded_a, encoded_b);
+  }
+
+  template <class D>
+  HWY_INLINE Mask<D> Compare(D d, Vec<D> a, Vec<D> b) const {
+    return Base::Compare(d, Codec::Encode(d, a), Codec::Encode(d, b));
+  }
+
+  // Used by Traits128's CompareTop.
+  template <class V>
+  HWY_INLINE Mask<DFromV<V>> CompareLanes(V a, V b) const {
+    const DFromV<V> d;
+    return Base::CompareLanes(Codec::Encode(d, a), Codec::Encode(d, b));
+  }
+
+  template <class D>
+  HWY_INLINE Vec<D> First(D d, const Vec<D> a, const Vec<D> b) const {
+    return Codec::Decode(
+        d, Base::First(d, Codec::Encode(d, a), Codec::Encode(d, b)));
+  }
+
+  template <class D>
+  HWY_INLINE Vec<D> Last(D d, const Vec<D> a, const Vec<D> b) const {
+    return Codec::Decode(
+        d, Base::Last(d, Codec::Encode(d, a), Codec::Encode(d, b)));
+  }
+
+  // Only for TraitsLane; Traits128 implements these via First/Last.
+  template <class D>
+  HWY_INLINE Vec<D> FirstOfLanes(D d, Vec<D> v,
+                                 LaneType* HWY_RESTRICT buf) const {
+    return Codec::Decode(d, Base::FirstOfLanes(d, Codec::Encode(d, v), buf));
+  }
+
+  template <class D>
+  HWY_INLINE Vec<D> LastOfLanes(D d, Vec<D> v,
+                                LaneType* HWY_RESTRICT buf) const {
+    return Codec::Decode(d, Base::LastOfLanes(d, Codec::Encode(d, v), buf));
+  }
+
+  template <class D>
+  HWY_INLINE Vec<D> FirstValue(D d) const {
+    return Codec::Decode(d, Base::FirstValue(d));
+  }
+
+  template <class D>
+  HWY_INLINE Vec<D> LastValue(D d) const {
+    return Codec::Decode(d, Base::LastValue(d));
+  }
+
+  template <class D>
+  HWY_INLINE Vec<D> PrevValue(D d, Vec<D> v) const {
+    return Codec::Decode(d, Base::PrevValue(d, Codec::Encode(d, v)));
+  }
+};
+
 // Shared code that depends on Order.
 template <class Base>
 struct TraitsLane : public Base {
@@ -25,10 +25,12 @@
 // IWYU pragma: begin_exports
 #include "hwy/base.h"
 #include "hwy/contrib/sort/order.h"  // SortAscending
+#include "hwy/contrib/sort/sort_stats.h"  // SortStats
 // IWYU pragma: end_exports
 
-#include "hwy/cache_control.h"  // Prefetch
-#include "hwy/print.h"          // unconditional, see above.
+#include "hwy/aligned_allocator.h"  // AllocateAligned
+#include "hwy/cache_control.h"      // Prefetch
+#include "hwy/print.h"              // unconditional, see above.
 
 // If 1, VQSortStatic can be called without including vqsort.h, and we avoid
 // any DLLEXPORT. This simplifies integration into other build systems, but
@@ -42,6 +44,19 @@
 #define VQSORT_PRINT 0
 #endif
 
+// If 1, Sort updates the thread-local SortStats returned by
+// detail::GetSortStatsStatic. This adds a few increments per recursion plus
+// timer reads, hence is disabled by default.
+#ifndef VQSORT_STATS
+#define VQSORT_STATS 0
+#endif
+
+// If 1, Sort uses a counting sort for integer keys whose range is small
+// relative to their number. This uses 8 KiB of stack for the histograms.
+#ifndef VQSORT_COUNTING_SORT
+#define VQSORT_COUNTING_SORT 1
+#endif
+
 #if !VQSORT_ONLY_STATIC
 #include "hwy/contrib/sort/vqsort.h"  // Fill16BytesSecure
 #endif
@@ -77,6 +92,14 @@ HWY_INLINE uint64_t* GetGeneratorStateStatic() {
   return state;
 }
 
+// Only updated if VQSORT_STATS. Per-thread, hence sorts on other threads update
+// their own. Sorts with a ThreadPool add the counters of their workers to the
+// calling thread.
+HWY_INLINE SortStats& GetSortStatsStatic() {
+  thread_local SortStats stats;
+  return stats;
+}
+
 }  // namespace detail
 }  // namespace hwy
 
@@ -95,6 +118,10 @@ HWY_INLINE uint64_t* GetGeneratorStateStatic() {
 #include "hwy/print-inl.h"
 #endif
 
+#if VQSORT_STATS
+#include "hwy/timer-inl.h"
+#endif
+
 #include "hwy/contrib/algo/copy-inl.h"
 #include "hwy/contrib/sort/shared-inl.h"
 #include "hwy/contrib/sort/sorting_networks-inl.h"
@@ -125,6 +152,18 @@ HWY_INLINE void MaybePrintVector(D d, const char* label, Vec<D> v,
 #endif
 }
 
+// Returns the current timer ticks if VQSORT_STATS, otherwise zero. Wrapper
+// avoids #if in callers, as for MaybePrintVector.
+HWY_INLINE uint64_t StatsTicks() {
+#if VQSORT_STATS
+  return timer::Start();
+#else
+  return 0;
+#endif
+}
+
+HWY_INLINE SortStats& Stats() { return hwy::detail::GetSortStatsStatic(); }
+
 // ------------------------------ HeapSort
 
 template <class Traits, typename T>
@@ -1689,36 +1728,23 @@ HWY_NOINLINE void PrintMinMax(D d, Traits st, const T* HWY_RESTRICT keys,
   }
 }
 
+// Draws samples and chooses a pivot for partitioning `keys`. Returns kDone if
+// `keys` are all equal or were already partitioned into two all-equal sides,
+// in which case the caller has nothing more to do.
 template <class D, class Traits, typename T>
-HWY_NOINLINE void Recurse(D d, Traits st, T* HWY_RESTRICT keys,
-                          const size_t num, T* HWY_RESTRICT buf,
-                          uint64_t* HWY_RESTRICT state,
-                          const size_t remaining_levels) {
-  HWY_DASSERT(num != 0);
-
-  const size_t N = Lanes(d);
-  constexpr size_t kLPK = st.LanesPerKey();
-  if (HWY_UNLIKELY(num <= Constants::BaseCaseNumLanes<kLPK>(N))) {
-    BaseCase(d, st, keys, num, buf);
-    return;
-  }
-
-  // Move after BaseCase so we skip printing for small subarrays.
-  if (VQSORT_PRINT >= 1) {
-    fprintf(stderr, "\n\n=== Recurse depth=%zu len=%zu\n", remaining_levels,
-            num);
-    PrintMinMax(d, st, keys, num, buf);
-  }
-
+HWY_INLINE PivotResult ChoosePivot(D d, Traits st, T* HWY_RESTRICT keys,
+                                   const size_t num, T* HWY_RESTRICT buf,
+                                   uint64_t* HWY_RESTRICT state,
+                                   Vec<D>& pivot) {
   DrawSamples(d, st, keys, num, buf, state);
 
-  Vec<D> pivot;
   PivotResult result = PivotResult::kNormal;
   if (HWY_UNLIKELY(UnsortedSampleEqual(d, st, buf))) {
     pivot = st.SetKey(d, buf);
     size_t idx_second = 0;
     if (HWY_UNLIKELY(AllEqual(d, st, pivot, keys, num, &idx_second))) {
-      return;
+      if (VQSORT_STATS) ++Stats().num_all_equal;
+      return PivotResult::kDone;
     }
     HWY_DASSERT(idx_second % st.LanesPerKey() == 0);
     // Must capture the value before PartitionIfTwoKeys may overwrite it.
@@ -1732,7 +1758,9 @@ HWY_NOINLINE void Recurse(D d, Traits st, T* HWY_RESTRICT keys,
     if (HWY_UNLIKELY(!st.IsKV() &&
                      PartitionIfTwoKeys(d, st, pivot, keys, num, idx_second,
                                         second, third, buf))) {
-      return;  // Done, skip recursion because each side has all-equal keys.
+      // Done, skip recursion because each side has all-equal keys.
+      if (VQSORT_STATS) ++Stats().num_two_key_partitions;
+      return PivotResult::kDone;
     }
 
     // We can no longer start scanning from idx_second because
@@ -1749,11 +1777,52 @@ HWY_NOINLINE void Recurse(D d, Traits st, T* HWY_RESTRICT keys,
     // but not interchangeable (their values may differ).
     if (HWY_UNLIKELY(!st.IsKV() &&
                      PartitionIfTwoSamples(d, st, keys, num, buf))) {
-      return;
+      if (VQSORT_STATS) ++Stats().num_two_key_partitions;
+      return PivotResult::kDone;
     }
 
     pivot = ChoosePivotByRank(d, st, buf);
   }
+  return result;
+}
+
+template <class D, class Traits, typename T>
+HWY_NOINLINE void Recurse(D d, Traits st, T* HWY_RESTRICT keys,
+                          const size_t num, T* HWY_RESTRICT buf,
+                          uint64_t* HWY_RESTRICT state,
+                          const size_t remaining_levels) {
+  HWY_DASSERT(num != 0);
+
+  const size_t N = Lanes(d);
+  constexpr size_t kLPK = st.LanesPerKey();
+  if (HWY_UNLIKELY(num <= Constants::BaseCaseNumLanes<kLPK>(N))) {
+    const uint64_t t0 = StatsTicks();
+    BaseCase(d, st, keys, num, buf);
+    if (VQSORT_STATS) {
+      ++Stats().num_base_cases;
+      Stats().base_case_ticks += StatsTicks() - t0;
+    }
+    return;
+  }
+
+  // Move after BaseCase so we skip printing for small subarrays.
+  if (VQSORT_PRINT >= 1) {
+    fprintf(stderr, "\n\n=== Recurse depth=%zu len=%zu\n", remaining_levels,
+            num);
+    PrintMinMax(d, st, keys, num, buf);
+  }
+  if (VQSORT_STATS) {
+    SortStats& stats = Stats();
+    const uint64_t depth = Constants::kMaxLevels - remaining_levels + 1;
+    stats.max_depth = HWY_MAX(stats.max_depth, depth);
+  }
+
+  Vec<D> pivot;
+  const uint64_t t0 = StatsTicks();
+  const PivotResult result = ChoosePivot(d, st, keys, num, buf, state, pivot);
+  const uint64_t t1 = StatsTicks();
+  if (VQSORT_STATS) Stats().pivot_ticks += t1 - t0;
+  if (result == PivotResult::kDone) return;
 
   // Too many recursions. This is unlikely to happen because we select pivots
   // from large (though still O(1)) samples.
@@ -1761,11 +1830,19 @@ HWY_NOINLINE void Recurse(D d, Traits st, T* HWY_RESTRICT keys,
     if (VQSORT_PRINT >= 1) {
       fprintf(stderr, "HeapSort reached, size=%zu\n", num);
     }
+    if (VQSORT_STATS) ++Stats().num_heap_sorts;
     HeapSort(st, keys, num);  // Slow but N*logN.
     return;
   }
 
   const size_t bound = Partition(d, st, keys, num, pivot, buf);
+  if (VQSORT_STATS) {
+    SortStats& stats = Stats();
+    ++stats.num_partitions;
+    // Partition reads and writes each key once.
+    stats.bytes_partitioned += 2 * num * sizeof(T);
+    stats.partition_ticks += StatsTicks() - t1;
+  }
   if (VQSORT_PRINT >= 2) {
     fprintf(stderr, "bound %zu num %zu result %s\n", bound, num,
             PivotResultString(result));
@@ -1790,6 +1867,68 @@ HWY_NOINLINE void Recurse(D d, Traits st, T* HWY_RESTRICT keys,
   }
 }
 
+// Quickselect: same pivot selection and Partition as Recurse, but only
+// continues with the side containing lane index `k`. Afterwards, `keys[k]`
+// (the key starting at that lane) is the one that would be there after
+// sorting, all keys before it are not after it in sort order, and all keys
+// after it are not before it.
+template <class D, class Traits, typename T>
+HWY_NOINLINE void RecurseSelect(D d, Traits st, T* HWY_RESTRICT keys,
+                                size_t num, size_t k, T* HWY_RESTRICT buf,
+                                uint64_t* HWY_RESTRICT state,
+                                size_t remaining_levels) {
+  const size_t N = Lanes(d);
+  constexpr size_t kLPK = st.LanesPerKey();
+  for (;;) {
+    HWY_DASSERT(k < num);
+    if (HWY_UNLIKELY(num <= Constants::BaseCaseNumLanes<kLPK>(N))) {
+      BaseCase(d, st, keys, num, buf);
+      return;
+    }
+
+    if (VQSORT_PRINT >= 1) {
+      fprintf(stderr, "\n\n=== Select depth=%zu len=%zu k=%zu\n",
+              remaining_levels, num, k);
+      PrintMinMax(d, st, keys, num, buf);
+    }
+
+    Vec<D> pivot;
+    const PivotResult result =
+        ChoosePivot(d, st, keys, num, buf, state, pivot);
+    if (result == PivotResult::kDone) return;
+
+    if (HWY_UNLIKELY(remaining_levels == 0)) {
+      if (VQSORT_PRINT >= 1) {
+        fprintf(stderr, "HeapSort reached, size=%zu\n", num);
+      }
+      HeapSort(st, keys, num);
+      return;
+    }
+    --remaining_levels;
+
+    const size_t bound = Partition(d, st, keys, num, pivot, buf);
+    if (VQSORT_PRINT >= 2) {
+      fprintf(stderr, "bound %zu num %zu k %zu result %s\n", bound, num, k,
+              PivotResultString(result));
+    }
+    // See the comments in Recurse.
+    HWY_DASSERT(bound != 0);
+    HWY_DASSERT(bound != num || result == PivotResult::kWasLast);
+
+    if (k < bound) {
+      // kIsFirst: the left side is all-equal, hence already in order.
+      if (result == PivotResult::kIsFirst) return;
+      num = bound;
+    } else {
+      // kWasLast: the right side is all-equal.
+      if (result == PivotResult::kWasLast) return;
+      keys += bound;
+      num -= bound;
+      k -= bound;
+    }
+  }
+}
+
 // Returns true if sorting is finished.
 template <class D, class Traits, typename T>
 HWY_INLINE bool HandleSpecialCases(D d, Traits st, T* HWY_RESTRICT keys,
@@ -1835,6 +1974,122 @@ HWY_INLINE bool HandleSpecialCases(D d, Traits st, T* HWY_RESTRICT keys,
   return false;  // not finished sorting
 }
 
+// ------------------------------ Counting sort
+
+// Integer keys with only a few significant bits (relative to their number) are
+// faster to sort by counting how often each value occurs, which requires only
+// two linear passes, than by partitioning O(log num) times.
+struct CountingSortConstants {
+  // Bins per histogram. There are kHistograms interleaved histograms so that
+  // runs of equal keys do not serialize on store-to-load forwarding of a single
+  // counter, as in CountingSort8. Together, they occupy 8 KiB of stack, which
+  // is the same as CountingSort8, and avoids allocating.
+  static constexpr size_t kMaxBins = 512;
+  static constexpr size_t kHistograms = 4;
+  // Below this, drawing samples to detect a small range is not worthwhile.
+  static constexpr size_t kMinKeys = 4096;
+};
+
+// Returns the minimum and maximum of keys[0, num), which is at least one
+// vector.
+template <class D, typename T = TFromD<D>>
+HWY_INLINE void MinMax(D d, const T* HWY_RESTRICT keys, size_t num, T& min,
+                       T& max) {
+  const size_t N = Lanes(d);
+  HWY_DASSERT(num >= N);
+  // The last vector may overlap the previous one; this does not affect the
+  // result.
+  Vec<D> vmin = LoadU(d, keys + num - N);
+  Vec<D> vmax = vmin;
+  for (size_t i = 0; i + N <= num; i += N) {
+    const Vec<D> v = LoadU(d, keys + i);
+    vmin = Min(vmin, v);
+    vmax = Max(vmax, v);
+  }
+  min = ReduceMin(d, vmin);
+  max = ReduceMax(d, vmax);
+}
+
+// Returns true if keys[0, num) are single-lane integers with a small enough
+// range, in which case they are now sorted. Not inlined to avoid enlarging the
+// stack frame of Sort by the histograms.
+template <class D, class Traits, typename T, HWY_IF_NOT_FLOAT(T)>
+HWY_NOINLINE bool MaybeCountingSort(D d, Traits st, T* HWY_RESTRICT keys,
+                                  size_t num, T* HWY_RESTRICT buf,
+                                  uint64_t* HWY_RESTRICT state) {
+  using TU = MakeUnsigned<T>;
+  constexpr size_t kMaxBins = CountingSortConstants::kMaxBins;
+  constexpr size_t kHistograms = CountingSortConstants::kHistograms;
+  // Also skip encoded keys (e.g. FloatCodec), whose lane order differs.
+  if (!VQSORT_COUNTING_SORT || st.IsKV() || st.Is128() ||
+      !IsSame<T, typename Traits::KeyType>() ||
+      num < CountingSortConstants::kMinKeys || num > 0xFFFFFFFFu) {
+    return false;
+  }
+  static_assert(CountingSortConstants::kMinKeys >= kMaxBins,
+                "Histogram must not be larger than the keys");
+
+  // The samples are medians of three, hence their range is a lower bound; this
+  // rejects most large ranges without inspecting all keys.
+  constexpr size_t kSampleLanes = Constants::SampleLanes<T>();
+  DrawSamples(d, st, keys, num, buf, state);
+  SortSamples(d, st, buf);
+  const T first = buf[0];
+  const T last = buf[kSampleLanes - 1];
+  const TU sample_range = static_cast<TU>(
+      static_cast<TU>(HWY_MAX(first, last)) -
+      static_cast<TU>(HWY_MIN(first, last)));
+  if (sample_range >= kMaxBins) return false;
+
+  T min, max;
+  MinMax(d, keys, num, min, max);
+  const TU range = static_cast<TU>(static_cast<TU>(max) - static_cast<TU>(min));
+  if (range >= kMaxBins) return false;
+  const size_t num_bins = static_cast<size_t>(range) + 1;
+  if (VQSORT_PRINT >= 1) {
+    fprintf(stderr, "Counting sort: %zu bins\n", num_bins);
+  }
+
+  // There is no vector op for incrementing counters at data-dependent indices,
+  // hence the histogram updates are scalar.
+  uint32_t counts[kHistograms][kMaxBins];
+  for (size_t h = 0; h < kHistograms; ++h) {
+    ZeroBytes(counts[h], num_bins * sizeof(uint32_t));
+  }
+  const TU umin = static_cast<TU>(min);
+  size_t i = 0;
+  for (; i + kHistograms <= num; i += kHistograms) {
+    for (size_t h = 0; h < kHistograms; ++h) {
+      ++counts[h][static_cast<TU>(static_cast<TU>(keys[i + h]) - umin)];
+    }
+  }
+  for (; i < num; ++i) {
+    ++counts[0][static_cast<TU>(static_cast<TU>(keys[i]) - umin)];
+  }
+
+  // Overwrite the keys with runs of each value.
+  const bool is_ascending = typename Traits::Order().IsAscending();
+  size_t pos = 0;
+  for (size_t b = 0; b < num_bins; ++b) {
+    const size_t bin = is_ascending ? b : num_bins - 1 - b;
+    size_t count = 0;
+    for (size_t h = 0; h < kHistograms; ++h) count += counts[h][bin];
+    if (count == 0) continue;
+    const T value = static_cast<T>(umin + static_cast<TU>(bin));
+    Fill(d, value, count, keys + pos);
+    pos += count;
+  }
+  HWY_DASSERT(pos == num);
+  if (VQSORT_STATS) ++Stats().num_counting_sorts;
+  return true;
+}
+
+template <class D, class Traits, typename T, HWY_IF_FLOAT(T)>
+HWY_INLINE bool MaybeCountingSort(D, Traits, T* HWY_RESTRICT, size_t,
+                                  T* HWY_RESTRICT, uint64_t* HWY_RESTRICT) {
+  return false;
+}
+
 #endif  // VQSORT_ENABLED
 
 template <class D, class Traits, typename T, HWY_IF_FLOAT(T)>
@@ -1868,6 +2123,47 @@ HWY_INLINE size_t CountAndReplaceNaN(D, Traits, T* HWY_RESTRICT, size_t) {
   return 0;
 }
 
+// 8-bit keys have at most 256 distinct values, hence counting is cheaper than
+// partitioning unless there are only a few keys, and the sorting networks need
+// not support 8-bit lanes. Uses four histograms so that runs of equal keys do
+// not serialize on store-to-load forwarding of a single counter.
+template <typename T>
+HWY_INLINE void CountingSort8(T* HWY_RESTRICT keys, size_t num,
+                              bool is_ascending) {
+  static_assert(sizeof(T) == 1, "Only for 8-bit keys");
+  if (num < 2) return;
+  // Signed keys: flipping the sign bit maps them to bins in ascending order.
+  constexpr uint8_t kFlip = IsSigned<T>() ? 0x80 : 0;
+  const uint8_t* HWY_RESTRICT bytes = reinterpret_cast<const uint8_t*>(keys);
+
+  size_t counts[4][256] = {};
+  size_t i = 0;
+  for (; i + 4 <= num; i += 4) {
+    ++counts[0][bytes[i + 0] ^ kFlip];
+    ++counts[1][bytes[i + 1] ^ kFlip];
+    ++counts[2][bytes[i + 2] ^ kFlip];
+    ++counts[3][bytes[i + 3] ^ kFlip];
+  }
+  for (; i < num; ++i) {
+    ++counts[0][bytes[i] ^ kFlip];
+  }
+
+  // Overwrite the keys with runs of each value.
+  const SortTag<T> d;
+  size_t pos = 0;
+  for (size_t b = 0; b < 256; ++b) {
+    const size_t bin = is_ascending ? b : 255 - b;
+    const size_t count =
+        counts[0][bin] + counts[1][bin] + counts[2][bin] + counts[3][bin];
+    if (count == 0) continue;
+    const T value = BitCastScalar<T>(static_cast<uint8_t>(bin ^ kFlip));
+    Fill(d, value, count, keys + pos);
+    pos += count;
+  }
+  HWY_DASSERT(pos == num);
+  if (VQSORT_STATS) ++Stats().num_counting_sorts;
+}
+
 }  // namespace detail
 
 // Old interface with user-specified buffer, retained for compatibility. Called
@@ -1889,15 +2185,16 @@ void Sort(D d, Traits st, T* HWY_RESTRICT keys, size_t num,
   }
 #endif  // HWY_MAX_BYTES > 64
 
+  if (VQSORT_STATS) ++detail::Stats().num_sorts;
   const size_t num_nan = detail::CountAndReplaceNaN(d, st, keys, num);
 
 #if VQSORT_ENABLED || HWY_IDE
   if (!detail::HandleSpecialCases(d, st, keys, num, buf)) {
     uint64_t* HWY_RESTRICT state = hwy::detail::GetGeneratorStateStatic();
-    // Introspection: switch to worst-case N*logN heapsort after this many.
-    // Should never be reached, so computing log2 exactly does not help.
-    const size_t max_levels = 50;
-    detail::Recurse(d, st, keys, num, buf, state, max_levels);
+    if (!detail::MaybeCountingSort(d, st, keys, num, buf, state)) {
+      detail::Recurse(d, st, keys, num, buf, state,
+                      detail::Constants::kMaxLevels);
+    }
   }
 #else   // !VQSORT_ENABLED
   (void)d;
@@ -1932,6 +2229,160 @@ HWY_API void Sort(D d, Traits st, T* HWY_RESTRICT keys, size_t num) {
   return Sort(d, st, keys, num, buf);
 }
 
+// Moves the key at lane index `k` (a multiple of `st.LanesPerKey()`) of
+// `keys[0..num-1]` to where it would be if sorted, and partitions the others
+// around it: none before `k` are ordered after it, and none after `k` are
+// ordered before it. Expected O(num) time; otherwise as for Sort. Any NaN are
+// treated as ordered after all other keys. Does nothing if `k >= num`.
+template <class D, class Traits, typename T>
+void Select(D d, Traits st, T* HWY_RESTRICT keys, size_t num, const size_t k,
+            T* HWY_RESTRICT buf) {
+  if (VQSORT_PRINT >= 1) {
+    fprintf(stderr, "=============== Select num %zu k %zu is128 %d isKV %d\n",
+            num, k, st.Is128(), st.IsKV());
+  }
+  if (HWY_UNLIKELY(k >= num)) return;
+  HWY_DASSERT(k % st.LanesPerKey() == 0);
+
+#if HWY_MAX_BYTES > 64
+  // sorting_networks-inl and traits assume no more than 512 bit vectors.
+  if (HWY_UNLIKELY(Lanes(d) > 64 / sizeof(T))) {
+    return Select(CappedTag<T, 64 / sizeof(T)>(), st, keys, num, k, buf);
+  }
+#endif  // HWY_MAX_BYTES > 64
+
+  const size_t num_nan = detail::CountAndReplaceNaN(d, st, keys, num);
+
+#if VQSORT_ENABLED || HWY_IDE
+  if (!detail::HandleSpecialCases(d, st, keys, num, buf)) {
+    uint64_t* HWY_RESTRICT state = hwy::detail::GetGeneratorStateStatic();
+    const size_t max_levels = detail::Constants::kMaxLevels;
+    if (num_nan != 0) {
+      // NaN were replaced with LastValue, but unlike Sort, Select does not
+      // move them all to the back. First select the boundary so that they are,
+      // then continue with the remaining keys.
+      num -= num_nan;
+      detail::RecurseSelect(d, st, keys, num + num_nan, num, buf, state,
+                            max_levels);
+    }
+    if (k < num) {
+      detail::RecurseSelect(d, st, keys, num, k, buf, state, max_levels);
+    }
+  } else {
+    num -= num_nan;  // HandleSpecialCases sorted all keys.
+  }
+#else   // !VQSORT_ENABLED
+  (void)buf;
+  if (VQSORT_PRINT >= 1) {
+    fprintf(stderr, "WARNING: using slow HeapSort because vqsort disabled\n");
+  }
+  detail::HeapSort(st, keys, num);
+  num -= num_nan;
+#endif  // VQSORT_ENABLED
+
+  if (num_nan != 0) {
+    Fill(d, GetLane(NaN(d)), num_nan, keys + num);
+  }
+}
+
+template <class D, class Traits, typename T>
+HWY_API void Select(D d, Traits st, T* HWY_RESTRICT keys, size_t num,
+                    const size_t k) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  HWY_ALIGN T buf[SortConstants::BufBytes<T, kLPK>(HWY_MAX_BYTES) / sizeof(T)];
+  return Select(d, st, keys, num, k, buf);
+}
+
+// Sorts the first `k` lanes (a multiple of `st.LanesPerKey()`) of
+// `keys[0..num-1]` such that they are the first `k` in sort order. The order of
+// the remaining keys is unspecified. Sorts all keys if `k >= num`.
+template <class D, class Traits, typename T>
+void PartialSort(D d, Traits st, T* HWY_RESTRICT keys, size_t num, size_t k,
+                 T* HWY_RESTRICT buf) {
+  if (k < num) {
+    Select(d, st, keys, num, k, buf);
+  } else {
+    k = num;
+  }
+  Sort(d, st, keys, k, buf);
+}
+
+template <class D, class Traits, typename T>
+HWY_API void PartialSort(D d, Traits st, T* HWY_RESTRICT keys, size_t num,
+                         size_t k) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  HWY_ALIGN T buf[SortConstants::BufBytes<T, kLPK>(HWY_MAX_BYTES) / sizeof(T)];
+  return PartialSort(d, st, keys, num, k, buf);
+}
+
+namespace detail {
+
+// Sorts segments [first_segment, end_segment) independently. Segment i is
+// keys[offsets[i] * kLPK, offsets[i + 1] * kLPK), i.e. offsets are in units of
+// keys. Unlike calling Sort for each segment, the generator state is fetched at
+// most once, and only if a segment is too large for BaseCase.
+template <class D, class Traits, typename T>
+HWY_NOINLINE void SortSegmentRange(D d, Traits st, T* HWY_RESTRICT keys,
+                                   const size_t* HWY_RESTRICT offsets,
+                                   size_t first_segment, size_t end_segment,
+                                   T* HWY_RESTRICT buf) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  uint64_t* HWY_RESTRICT state = nullptr;
+  for (size_t i = first_segment; i < end_segment; ++i) {
+    HWY_DASSERT(offsets[i] <= offsets[i + 1]);
+    const size_t num = (offsets[i + 1] - offsets[i]) * kLPK;
+    if (num <= kLPK) continue;  // Already sorted.
+    T* HWY_RESTRICT segment = keys + offsets[i] * kLPK;
+
+    const size_t num_nan = CountAndReplaceNaN(d, st, segment, num);
+#if VQSORT_ENABLED || HWY_IDE
+    // Small segments go straight to BaseCase.
+    if (!HandleSpecialCases(d, st, segment, num, buf)) {
+      if (!state) state = hwy::detail::GetGeneratorStateStatic();
+      Recurse(d, st, segment, num, buf, state, Constants::kMaxLevels);
+    }
+#else   // !VQSORT_ENABLED
+    (void)buf;
+    (void)state;
+    HeapSort(st, segment, num);
+#endif  // VQSORT_ENABLED
+
+    if (num_nan != 0) {
+      Fill(d, GetLane(NaN(d)), num_nan, segment + num - num_nan);
+    }
+  }
+}
+
+}  // namespace detail
+
+// Segmented sort: same result as calling Sort for each of the `num_segments`
+// segments keys[offsets[i] * st.LanesPerKey(), offsets[i + 1] *
+// st.LanesPerKey()), but with less per-segment overhead, which is helpful for
+// many small segments. `offsets` has `num_segments + 1` non-decreasing entries.
+template <class D, class Traits, typename T>
+void SortSegments(D d, Traits st, T* HWY_RESTRICT keys,
+                  const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                  T* HWY_RESTRICT buf) {
+#if HWY_MAX_BYTES > 64
+  // sorting_networks-inl and traits assume no more than 512 bit vectors.
+  if (HWY_UNLIKELY(Lanes(d) > 64 / sizeof(T))) {
+    return SortSegments(CappedTag<T, 64 / sizeof(T)>(), st, keys, offsets,
+                        num_segments, buf);
+  }
+#endif  // HWY_MAX_BYTES > 64
+
+  detail::SortSegmentRange(d, st, keys, offsets, 0, num_segments, buf);
+}
+
+template <class D, class Traits, typename T>
+HWY_API void SortSegments(D d, Traits st, T* HWY_RESTRICT keys,
+                          const size_t* HWY_RESTRICT offsets,
+                          size_t num_segments) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  HWY_ALIGN T buf[SortConstants::BufBytes<T, kLPK>(HWY_MAX_BYTES) / sizeof(T)];
+  return SortSegments(d, st, keys, offsets, num_segments, buf);
+}
+
 #if VQSORT_ENABLED
 // Adapter from VQSort[Static] to SortTag and Traits*/Order*.
 namespace detail {
@@ -1973,13 +2424,50 @@ struct KeyAdapter<hwy::K32V32> {
   using Traits = TraitsLane<Order>;
 };
 
+template <>
+struct KeyAdapter<hwy::KI32V32> {
+  using Ascending = OrderEncoded<OrderAscendingKV64, CodecKI32>;
+  using Descending = OrderEncoded<OrderDescendingKV64, CodecKI32>;
+
+  template <class Order>
+  using Traits = TraitsLane<Order>;
+};
+
+template <>
+struct KeyAdapter<hwy::KF32V32> {
+  using Ascending = OrderEncoded<OrderAscendingKV64, CodecKF32>;
+  using Descending = OrderEncoded<OrderDescendingKV64, CodecKF32>;
+
+  template <class Order>
+  using Traits = TraitsLane<Order>;
+};
+
+template <>
+struct KeyAdapter<hwy::KI64V64> {
+  using Ascending = OrderEncoded<OrderAscendingKV128, CodecKI64>;
+  using Descending = OrderEncoded<OrderDescendingKV128, CodecKI64>;
+
+  template <class Order>
+  using Traits = Traits128<Order>;
+};
+
+template <>
+struct KeyAdapter<hwy::KF64V64> {
+  using Ascending = OrderEncoded<OrderAscendingKV128, CodecKF64>;
+  using Descending = OrderEncoded<OrderDescendingKV128, CodecKF64>;
+
+  template <class Order>
+  using Traits = Traits128<Order>;
+};
+
 }  // namespace detail
 #endif  // VQSORT_ENABLED
 
 // Simpler interface matching VQSort(), but without dynamic dispatch. Uses the
 // instructions available in the current target (HWY_NAMESPACE). Supported key
 // types: 16-64 bit unsigned/signed/floating-point (but float64 only #if
-// HWY_HAVE_FLOAT64), uint128_t, K64V64, K32V32.
+// HWY_HAVE_FLOAT64), uint128_t, K64V64, K32V32, KI32V32, KF32V32, KI64V64,
+// KF64V64. bf16 and 8-bit keys are handled by the overloads below.
 template <typename T>
 void VQSortStatic(T* HWY_RESTRICT keys, size_t num, SortAscending) {
 #if VQSORT_ENABLED
@@ -2012,6 +2500,219 @@ void VQSortStatic(T* HWY_RESTRICT keys, size_t num, SortDescending) {
 #endif  // VQSORT_ENABLED
 }
 
+namespace detail {
+
+template <typename T, class Order>
+void Sort8(T* HWY_RESTRICT keys, size_t num, Order order) {
+#if VQSORT_ENABLED
+  // For few keys, initializing and scanning the histogram is slower than
+  // sorting 16-bit copies of the keys.
+  constexpr size_t kMaxWiden = 128;
+  if (num <= kMaxWiden) {
+    using TW = MakeWide<T>;
+    TW wide[kMaxWiden];
+    for (size_t i = 0; i < num; ++i) wide[i] = keys[i];
+    VQSortStatic(wide, num, order);
+    for (size_t i = 0; i < num; ++i) keys[i] = static_cast<T>(wide[i]);
+    return;
+  }
+#endif
+  CountingSort8(keys, num, order.IsAscending());
+}
+
+// Applies `Codec::Encode` or `Decode` to all lanes.
+template <class Codec, bool kEncode, typename T>
+void TransformLanes(T* HWY_RESTRICT lanes, size_t num) {
+  const SortTag<T> d;
+  const size_t N = Lanes(d);
+  size_t i = 0;
+  if (num >= N) {
+    for (; i <= num - N; i += N) {
+      const Vec<decltype(d)> v = LoadU(d, lanes + i);
+      StoreU(kEncode ? Codec::Encode(d, v) : Codec::Decode(d, v), d, lanes + i);
+    }
+  }
+  const size_t remaining = num - i;
+  if (remaining == 0) return;
+  const Vec<decltype(d)> v = LoadN(d, lanes + i, remaining);
+  StoreN(kEncode ? Codec::Encode(d, v) : Codec::Decode(d, v), d, lanes + i,
+         remaining);
+}
+
+// Most targets lack bf16 comparisons. Encoding the keys as u16 with the same
+// order in a separate pass, rather than within each comparison as for
+// FloatOrder, enables the cheaper integer sorting networks and counting sort.
+// As with other floating-point keys, NaN are ordered last in both directions,
+// but their payloads are preserved.
+template <class Order>
+void SortBF16(bfloat16_t* HWY_RESTRICT keys, size_t num, Order order) {
+  using Codec = FloatCodec<bfloat16_t, Order().IsAscending() ? 1 : -1>;
+  uint16_t* HWY_RESTRICT lanes = reinterpret_cast<uint16_t*>(keys);
+  TransformLanes<Codec, /*kEncode=*/true>(lanes, num);
+  VQSortStatic(lanes, num, order);
+  TransformLanes<Codec, /*kEncode=*/false>(lanes, num);
+}
+
+}  // namespace detail
+
+// Overloads for bf16 and 8-bit keys, which KeyAdapter does not support. These
+// non-template functions take precedence over the templates above.
+inline void VQSortStatic(bfloat16_t* HWY_RESTRICT keys, size_t num,
+                         SortAscending order) {
+  detail::SortBF16(keys, num, order);
+}
+inline void VQSortStatic(bfloat16_t* HWY_RESTRICT keys, size_t num,
+                         SortDescending order) {
+  detail::SortBF16(keys, num, order);
+}
+inline void VQSortStatic(uint8_t* HWY_RESTRICT keys, size_t num,
+                         SortAscending order) {
+  detail::Sort8(keys, num, order);
+}
+inline void VQSortStatic(uint8_t* HWY_RESTRICT keys, size_t num,
+                         SortDescending order) {
+  detail::Sort8(keys, num, order);
+}
+inline void VQSortStatic(int8_t* HWY_RESTRICT keys, size_t num,
+                         SortAscending order) {
+  detail::Sort8(keys, num, order);
+}
+inline void VQSortStatic(int8_t* HWY_RESTRICT keys, size_t num,
+                         SortDescending order) {
+  detail::Sort8(keys, num, order);
+}
+
+#if VQSORT_ENABLED
+namespace detail {
+
+// Sorts floating-point keys as unsigned lanes encoded by FloatCodec.
+template <class Base, int kNaN, typename TF>
+void SortEncodedFloat(TF* HWY_RESTRICT keys, size_t num) {
+  using Order = OrderEncoded<Base, FloatCodec<TF, kNaN>>;
+  const SharedTraits<TraitsLane<Order>> st;
+  using LaneType = MakeUnsigned<TF>;
+  const SortTag<LaneType> d;
+  Sort(d, st, reinterpret_cast<LaneType*>(keys), num);
+}
+
+}  // namespace detail
+#endif  // VQSORT_ENABLED
+
+// Same as VQSortStatic, but for floating-point keys, which are ordered as
+// specified by `float_order` (see order.h).
+template <typename T, class Order>
+void VQSortStatic(T* HWY_RESTRICT keys, size_t num, Order /* order */,
+                  FloatOrder float_order) {
+  static_assert(IsFloat<T>(), "Only for floating-point keys");
+#if VQSORT_ENABLED
+  using TU = MakeUnsigned<T>;
+  using detail::SortEncodedFloat;
+  if (Order().IsAscending()) {
+    using Base = detail::OrderAscending<TU>;
+    switch (float_order) {
+      case FloatOrder::kNaNFirst:
+        return SortEncodedFloat<Base, -1>(keys, num);
+      case FloatOrder::kNaNLast:
+        return SortEncodedFloat<Base, 1>(keys, num);
+      case FloatOrder::kTotalOrder:
+        return SortEncodedFloat<Base, 0>(keys, num);
+    }
+  } else {
+    // Descending reverses the encoded order, hence also the NaN placement.
+    using Base = detail::OrderDescending<TU>;
+    switch (float_order) {
+      case FloatOrder::kNaNFirst:
+        return SortEncodedFloat<Base, 1>(keys, num);
+      case FloatOrder::kNaNLast:
+        return SortEncodedFloat<Base, -1>(keys, num);
+      case FloatOrder::kTotalOrder:
+        return SortEncodedFloat<Base, 0>(keys, num);
+    }
+  }
+  HWY_ABORT("Invalid FloatOrder %d", static_cast<int>(float_order));
+#else
+  (void)keys;
+  (void)num;
+  (void)float_order;
+  HWY_ASSERT(0);
+#endif  // VQSORT_ENABLED
+}
+
+// Simpler interface matching VQPartialSort(), but without dynamic dispatch.
+// Sorts the `k` first keys in sort order to the front; the order of the others
+// is unspecified. Supports the same key types as VQSortStatic.
+template <typename T, class Order>
+void VQPartialSortStatic(T* HWY_RESTRICT keys, size_t num, size_t k,
+                         Order /* order */) {
+#if VQSORT_ENABLED
+  using Adapter = detail::KeyAdapter<T>;
+  using AdapterOrder =
+      hwy::If<Order().IsAscending(), typename Adapter::Ascending,
+              typename Adapter::Descending>;
+  const detail::SharedTraits<typename Adapter::template Traits<AdapterOrder>>
+      st;
+  using LaneType = typename decltype(st)::LaneType;
+  const SortTag<LaneType> d;
+  PartialSort(d, st, reinterpret_cast<LaneType*>(keys), num * st.LanesPerKey(),
+              k * st.LanesPerKey());
+#else
+  (void)keys;
+  (void)num;
+  (void)k;
+  HWY_ASSERT(0);
+#endif  // VQSORT_ENABLED
+}
+
+// Simpler interface matching VQSelect(), but without dynamic dispatch. Moves
+// the key that would be at index `k` if sorted there, with no key ordered
+// after it in `keys[0, k)` and none ordered before it in `keys[k + 1, num)`.
+template <typename T, class Order>
+void VQSelectStatic(T* HWY_RESTRICT keys, size_t num, size_t k,
+                    Order /* order */) {
+#if VQSORT_ENABLED
+  using Adapter = detail::KeyAdapter<T>;
+  using AdapterOrder =
+      hwy::If<Order().IsAscending(), typename Adapter::Ascending,
+              typename Adapter::Descending>;
+  const detail::SharedTraits<typename Adapter::template Traits<AdapterOrder>>
+      st;
+  using LaneType = typename decltype(st)::LaneType;
+  const SortTag<LaneType> d;
+  Select(d, st, reinterpret_cast<LaneType*>(keys), num * st.LanesPerKey(),
+         k * st.LanesPerKey());
+#else
+  (void)keys;
+  (void)num;
+  (void)k;
+  HWY_ASSERT(0);
+#endif  // VQSORT_ENABLED
+}
+
+// Simpler interface matching VQSortSegments(), but without dynamic dispatch.
+// Sorts keys[offsets[i], offsets[i + 1]) for each i < num_segments.
+template <typename T, class Order>
+void VQSortSegmentsStatic(T* HWY_RESTRICT keys,
+                          const size_t* HWY_RESTRICT offsets,
+                          size_t num_segments, Order /* order */) {
+#if VQSORT_ENABLED
+  using Adapter = detail::KeyAdapter<T>;
+  using AdapterOrder =
+      hwy::If<Order().IsAscending(), typename Adapter::Ascending,
+              typename Adapter::Descending>;
+  const detail::SharedTraits<typename Adapter::template Traits<AdapterOrder>>
+      st;
+  using LaneType = typename decltype(st)::LaneType;
+  const SortTag<LaneType> d;
+  SortSegments(d, st, reinterpret_cast<LaneType*>(keys), offsets,
+               num_segments);
+#else
+  (void)keys;
+  (void)offsets;
+  (void)num_segments;
+  HWY_ASSERT(0);
+#endif  // VQSORT_ENABLED
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
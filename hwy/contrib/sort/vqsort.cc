@@ -213,4 +213,7 @@ Sorter::Sorter() {}
 void Sorter::Delete() {}
 uint64_t* GetGeneratorState() { return hwy::detail::GetGeneratorStateStatic(); }
 
+SortStats GetVQSortStats() { return hwy::detail::GetSortStatsStatic(); }
+void ResetVQSortStats() { hwy::detail::GetSortStatsStatic() = SortStats(); }
+
 }  // namespace hwy
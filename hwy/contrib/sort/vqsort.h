@@ -29,15 +29,28 @@
 
 // IWYU pragma: begin_exports
 #include "hwy/base.h"
-#include "hwy/contrib/sort/order.h"  // SortAscending
+#include "hwy/contrib/sort/order.h"       // SortAscending
+#include "hwy/contrib/sort/sort_stats.h"  // SortStats
 // IWYU pragma: end_exports
 
 namespace hwy {
 
+class ThreadPool;  // hwy/contrib/thread_pool/thread_pool.h
+
 // Vectorized Quicksort: sorts keys[0, n). Does not preserve the ordering of
 // equivalent keys (defined as: neither greater nor less than another).
 // Dispatches to the best available instruction set. Does not allocate memory.
 // Uses about 1.2 KiB stack plus an internal 3-word TLS cache for random state.
+// 8-bit keys, and integer keys with a range of at most 512 values, are instead
+// sorted by counting, which uses 8 KiB stack.
+HWY_CONTRIB_DLLEXPORT void VQSort(uint8_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSort(uint8_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSort(int8_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSort(int8_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending);
 HWY_CONTRIB_DLLEXPORT void VQSort(uint16_t* HWY_RESTRICT keys, size_t n,
                                   SortAscending);
 HWY_CONTRIB_DLLEXPORT void VQSort(uint16_t* HWY_RESTRICT keys, size_t n,
@@ -69,6 +82,14 @@ HWY_CONTRIB_DLLEXPORT void VQSort(float16_t* HWY_RESTRICT keys, size_t n,
 HWY_CONTRIB_DLLEXPORT void VQSort(float16_t* HWY_RESTRICT keys, size_t n,
                                   SortDescending);
 
+// These do not require native bf16 support. NaN are ordered last, but unlike
+// the other floating-point types, their payloads are preserved and -0.0 is
+// ordered before +0.0 (or after, if descending).
+HWY_CONTRIB_DLLEXPORT void VQSort(bfloat16_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSort(bfloat16_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending);
+
 HWY_CONTRIB_DLLEXPORT void VQSort(float* HWY_RESTRICT keys, size_t n,
                                   SortAscending);
 HWY_CONTRIB_DLLEXPORT void VQSort(float* HWY_RESTRICT keys, size_t n,
@@ -93,6 +114,863 @@ HWY_CONTRIB_DLLEXPORT void VQSort(K32V32* HWY_RESTRICT keys, size_t n,
 HWY_CONTRIB_DLLEXPORT void VQSort(K32V32* HWY_RESTRICT keys, size_t n,
                                   SortDescending);
 
+// Same as VQSort, but with the placement of NaN and -0.0 given by
+// `float_order`, see order.h. These do not require hwy::HaveFloat16() or
+// hwy::HaveFloat64() because they only use integer operations.
+HWY_CONTRIB_DLLEXPORT void VQSort(float16_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, FloatOrder float_order);
+HWY_CONTRIB_DLLEXPORT void VQSort(float16_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, FloatOrder float_order);
+HWY_CONTRIB_DLLEXPORT void VQSort(float* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, FloatOrder float_order);
+HWY_CONTRIB_DLLEXPORT void VQSort(float* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, FloatOrder float_order);
+HWY_CONTRIB_DLLEXPORT void VQSort(double* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, FloatOrder float_order);
+HWY_CONTRIB_DLLEXPORT void VQSort(double* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, FloatOrder float_order);
+
+// Same as VQSort, but uses all workers of `pool`: the top levels of the
+// recursion are partitioned in parallel, and the resulting subarrays are then
+// sorted concurrently. Falls back to the single-threaded VQSort for small n.
+// Must not be called from within `pool.Run`. Allocates only small bookkeeping
+// arrays; each worker uses about 1.2 KiB stack.
+HWY_CONTRIB_DLLEXPORT void VQSort(uint16_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(uint16_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(uint32_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(uint32_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(uint64_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(uint64_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(int16_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(int16_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(int32_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(int32_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(int64_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(int64_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+
+// These two must only be called if hwy::HaveFloat16() is true.
+HWY_CONTRIB_DLLEXPORT void VQSort(float16_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(float16_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+
+HWY_CONTRIB_DLLEXPORT void VQSort(float* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(float* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+
+// These two must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT void VQSort(double* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(double* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+
+HWY_CONTRIB_DLLEXPORT void VQSort(uint128_t* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(uint128_t* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(K64V64* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(K64V64* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(K32V32* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(K32V32* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+
+// Argsort: writes to indices[0, n) a permutation such that keys[indices[0]],
+// keys[indices[1]], ... are in sort order. Does not modify keys. Stable:
+// equivalent keys (including -0.0 and +0.0) remain in their original order.
+// As in VQSort, NaN are ordered last. Keys and indices are packed into the
+// K32V32 (32-bit keys, hence n < 2^32) or K64V64 layout, so this allocates 8
+// or 16 bytes per key.
+HWY_CONTRIB_DLLEXPORT void VQArgsort(const uint32_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgsort(const uint32_t* HWY_RESTRICT keys,
+                                     size_t n, uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgsort(const int32_t* HWY_RESTRICT keys, size_t n,
+                                     uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgsort(const int32_t* HWY_RESTRICT keys, size_t n,
+                                     uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgsort(const float* HWY_RESTRICT keys, size_t n,
+                                     uint32_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgsort(const float* HWY_RESTRICT keys, size_t n,
+                                     uint32_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgsort(const uint64_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgsort(const uint64_t* HWY_RESTRICT keys,
+                                     size_t n, uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQArgsort(const int64_t* HWY_RESTRICT keys, size_t n,
+                                     uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgsort(const int64_t* HWY_RESTRICT keys, size_t n,
+                                     uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+// These two must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT void VQArgsort(const double* HWY_RESTRICT keys, size_t n,
+                                     uint64_t* HWY_RESTRICT indices,
+                                     SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQArgsort(const double* HWY_RESTRICT keys, size_t n,
+                                     uint64_t* HWY_RESTRICT indices,
+                                     SortDescending);
+
+// Reorders a column according to the output of VQArgsort: out[i] =
+// in[indices[i]] for i < n. `indices` must be a permutation of [0, n), as
+// returned by VQArgsort. Uses vector gathers for 32 and 64-bit values. `in`
+// and `out` must not overlap.
+HWY_CONTRIB_DLLEXPORT void VQApplyPermutation(
+    const uint32_t* HWY_RESTRICT indices, size_t n,
+    const uint8_t* HWY_RESTRICT in, uint8_t* HWY_RESTRICT out);
+HWY_CONTRIB_DLLEXPORT void VQApplyPermutation(
+    const uint32_t* HWY_RESTRICT indices, size_t n,
+    const uint16_t* HWY_RESTRICT in, uint16_t* HWY_RESTRICT out);
+HWY_CONTRIB_DLLEXPORT void VQApplyPermutation(
+    const uint32_t* HWY_RESTRICT indices, size_t n,
+    const uint32_t* HWY_RESTRICT in, uint32_t* HWY_RESTRICT out);
+HWY_CONTRIB_DLLEXPORT void VQApplyPermutation(
+    const uint32_t* HWY_RESTRICT indices, size_t n,
+    const uint64_t* HWY_RESTRICT in, uint64_t* HWY_RESTRICT out);
+HWY_CONTRIB_DLLEXPORT void VQApplyPermutation(
+    const uint64_t* HWY_RESTRICT indices, size_t n,
+    const uint8_t* HWY_RESTRICT in, uint8_t* HWY_RESTRICT out);
+HWY_CONTRIB_DLLEXPORT void VQApplyPermutation(
+    const uint64_t* HWY_RESTRICT indices, size_t n,
+    const uint16_t* HWY_RESTRICT in, uint16_t* HWY_RESTRICT out);
+HWY_CONTRIB_DLLEXPORT void VQApplyPermutation(
+    const uint64_t* HWY_RESTRICT indices, size_t n,
+    const uint32_t* HWY_RESTRICT in, uint32_t* HWY_RESTRICT out);
+HWY_CONTRIB_DLLEXPORT void VQApplyPermutation(
+    const uint64_t* HWY_RESTRICT indices, size_t n,
+    const uint64_t* HWY_RESTRICT in, uint64_t* HWY_RESTRICT out);
+
+// Overload for other column types (signed, floating-point, or other types of
+// size 1, 2, 4 or 8 bytes), which are permuted as unsigned integers.
+template <typename TI, typename T>
+void VQApplyPermutation(const TI* HWY_RESTRICT indices, size_t n,
+                        const T* HWY_RESTRICT in, T* HWY_RESTRICT out) {
+  using TU = UnsignedFromSize<sizeof(T)>;
+  VQApplyPermutation(indices, n, reinterpret_cast<const TU*>(in),
+                     reinterpret_cast<TU*>(out));
+}
+
+// Stable sort: same order as VQSort, but equivalent keys remain in their
+// original order. This is observable for -0.0 and +0.0 and NaN with different
+// payloads, and for the values of K32V32 and K64V64, whose keys alone are
+// compared. Only the key types below are supported: 32 and 64-bit integers and
+// floating-point, K32V32 and K64V64. Integer keys are indistinguishable from
+// equivalent keys, hence those overloads are the same as VQSort. Otherwise,
+// uses VQArgsort and VQApplyPermutation, which are slower than VQSort and
+// allocate up to 32 bytes per key, but usually still much faster than
+// std::stable_sort.
+HWY_CONTRIB_DLLEXPORT void VQStableSort(uint32_t* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(uint32_t* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(int32_t* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(int32_t* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(uint64_t* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(uint64_t* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(int64_t* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(int64_t* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(float* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(float* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+// These two must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT void VQStableSort(double* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(double* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(K32V32* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(K32V32* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(K64V64* HWY_RESTRICT keys, size_t n,
+                                        SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQStableSort(K64V64* HWY_RESTRICT keys, size_t n,
+                                        SortDescending);
+
+// Sorts `n` records of `record_bytes` each by the key stored at byte offset
+// `key_offset` within each record, which need not be aligned. The type of the
+// key is that of `key_type`, which is not dereferenced and may be null. Same
+// order as VQArgsort, and likewise stable. Extracts the keys, sorts their
+// indices via VQArgsort, then gathers the records in blocks. Allocates a copy
+// of the records plus up to 32 bytes per record. For 32-bit keys, n must be
+// less than 2^32.
+HWY_CONTRIB_DLLEXPORT void VQSortRecords(void* HWY_RESTRICT records, size_t n,
+                                         size_t record_bytes, size_t key_offset,
+                                         const uint32_t* key_type,
+                                         SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortRecords(void* HWY_RESTRICT records, size_t n,
+                                         size_t record_bytes, size_t key_offset,
+                                         const uint32_t* key_type,
+                                         SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortRecords(void* HWY_RESTRICT records, size_t n,
+                                         size_t record_bytes, size_t key_offset,
+                                         const int32_t* key_type,
+                                         SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortRecords(void* HWY_RESTRICT records, size_t n,
+                                         size_t record_bytes, size_t key_offset,
+                                         const int32_t* key_type,
+                                         SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortRecords(void* HWY_RESTRICT records, size_t n,
+                                         size_t record_bytes, size_t key_offset,
+                                         const float* key_type, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortRecords(void* HWY_RESTRICT records, size_t n,
+                                         size_t record_bytes, size_t key_offset,
+                                         const float* key_type, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortRecords(void* HWY_RESTRICT records, size_t n,
+                                         size_t record_bytes, size_t key_offset,
+                                         const uint64_t* key_type,
+                                         SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortRecords(void* HWY_RESTRICT records, size_t n,
+                                         size_t record_bytes, size_t key_offset,
+                                         const uint64_t* key_type,
+                                         SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortRecords(void* HWY_RESTRICT records, size_t n,
+                                         size_t record_bytes, size_t key_offset,
+                                         const int64_t* key_type,
+                                         SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortRecords(void* HWY_RESTRICT records, size_t n,
+                                         size_t record_bytes, size_t key_offset,
+                                         const int64_t* key_type,
+                                         SortDescending);
+// These two must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT void VQSortRecords(void* HWY_RESTRICT records, size_t n,
+                                         size_t record_bytes, size_t key_offset,
+                                         const double* key_type, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortRecords(void* HWY_RESTRICT records, size_t n,
+                                         size_t record_bytes, size_t key_offset,
+                                         const double* key_type,
+                                         SortDescending);
+
+// Overload with the key type as a template argument, e.g.
+// VQSortRecords<float>(records, n, record_bytes, key_offset, SortAscending()).
+template <typename TKey, class Order>
+void VQSortRecords(void* HWY_RESTRICT records, size_t n, size_t record_bytes,
+                   size_t key_offset, Order order) {
+  VQSortRecords(records, n, record_bytes, key_offset,
+                static_cast<const TKey*>(nullptr), order);
+}
+
+// String sort: writes to indices[0, n) a permutation such that
+// strings[indices[0]], strings[indices[1]], ... are in lexicographic order of
+// their bytes (compared as unsigned, as by memcmp; a proper prefix is ordered
+// before the longer string). String i consists of lengths[i] bytes, which may
+// include zero bytes. Each pass sorts uint128_t keys holding the next 12 bytes
+// (8 if n > 2^32) and the index via VQSort; only strings with equal bytes so
+// far are considered in later passes, and small groups of them are compared
+// directly. The order of identical strings is unspecified. Allocates 16 bytes
+// per string. The uint32_t overloads require n <= 2^32.
+HWY_CONTRIB_DLLEXPORT void VQSortStrings(
+    const char* const* HWY_RESTRICT strings,
+    const size_t* HWY_RESTRICT lengths, size_t n,
+    uint32_t* HWY_RESTRICT indices, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortStrings(
+    const char* const* HWY_RESTRICT strings,
+    const size_t* HWY_RESTRICT lengths, size_t n,
+    uint32_t* HWY_RESTRICT indices, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortStrings(
+    const char* const* HWY_RESTRICT strings,
+    const size_t* HWY_RESTRICT lengths, size_t n,
+    uint64_t* HWY_RESTRICT indices, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortStrings(
+    const char* const* HWY_RESTRICT strings,
+    const size_t* HWY_RESTRICT lengths, size_t n,
+    uint64_t* HWY_RESTRICT indices, SortDescending);
+
+// Vectorized partial sort: rearranges keys[0, n) such that keys[0, k) are the
+// first k keys in sort order, sorted; the order of keys[k, n) is unspecified.
+// Sorts all keys if k >= n. Expected O(n + k log k) time. Otherwise the same
+// properties and supported types as VQSort, including equivalent keys being
+// unordered and NaN being ordered last.
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(uint16_t* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(uint16_t* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(uint32_t* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(uint32_t* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(uint64_t* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(uint64_t* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(int16_t* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(int16_t* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(int32_t* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(int32_t* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(int64_t* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(int64_t* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortDescending);
+
+// These two must only be called if hwy::HaveFloat16() is true.
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(float16_t* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(float16_t* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortDescending);
+
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(float* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(float* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortDescending);
+
+// These two must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(double* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(double* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortDescending);
+
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(uint128_t* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(uint128_t* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(K64V64* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(K64V64* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(K32V32* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(K32V32* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortDescending);
+
+// Vectorized selection (nth_element): moves the key that would be at keys[k]
+// if sorted to keys[k], with no key in keys[0, k) ordered after it and no key
+// in keys[k + 1, n) ordered before it. Does nothing if k >= n. Expected O(n)
+// time. Otherwise the same properties and supported types as VQSort.
+HWY_CONTRIB_DLLEXPORT void VQSelect(uint16_t* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(uint16_t* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(uint32_t* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(uint32_t* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(uint64_t* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(uint64_t* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(int16_t* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(int16_t* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(int32_t* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(int32_t* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(int64_t* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(int64_t* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortDescending);
+
+// These two must only be called if hwy::HaveFloat16() is true.
+HWY_CONTRIB_DLLEXPORT void VQSelect(float16_t* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(float16_t* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortDescending);
+
+HWY_CONTRIB_DLLEXPORT void VQSelect(float* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(float* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortDescending);
+
+// These two must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT void VQSelect(double* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(double* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortDescending);
+
+HWY_CONTRIB_DLLEXPORT void VQSelect(uint128_t* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(uint128_t* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(K64V64* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(K64V64* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(K32V32* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(K32V32* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortDescending);
+
+// Merges the sorted `a[0, num_a)` and `b[0, num_b)` into `out[0, num_a +
+// num_b)`, which must not overlap them. The inputs must be in the given sort
+// order, e.g. as produced by VQSort, including NaN being ordered last. Uses a
+// bitonic merge network on vectors of up to eight keys. Equivalent keys are
+// unordered. Supports the same types as VQSort.
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint16_t* HWY_RESTRICT a, size_t num_a,
+                                   const uint16_t* HWY_RESTRICT b, size_t num_b,
+                                   uint16_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint16_t* HWY_RESTRICT a, size_t num_a,
+                                   const uint16_t* HWY_RESTRICT b, size_t num_b,
+                                   uint16_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint32_t* HWY_RESTRICT a, size_t num_a,
+                                   const uint32_t* HWY_RESTRICT b, size_t num_b,
+                                   uint32_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint32_t* HWY_RESTRICT a, size_t num_a,
+                                   const uint32_t* HWY_RESTRICT b, size_t num_b,
+                                   uint32_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint64_t* HWY_RESTRICT a, size_t num_a,
+                                   const uint64_t* HWY_RESTRICT b, size_t num_b,
+                                   uint64_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint64_t* HWY_RESTRICT a, size_t num_a,
+                                   const uint64_t* HWY_RESTRICT b, size_t num_b,
+                                   uint64_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int16_t* HWY_RESTRICT a, size_t num_a,
+                                   const int16_t* HWY_RESTRICT b, size_t num_b,
+                                   int16_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int16_t* HWY_RESTRICT a, size_t num_a,
+                                   const int16_t* HWY_RESTRICT b, size_t num_b,
+                                   int16_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int32_t* HWY_RESTRICT a, size_t num_a,
+                                   const int32_t* HWY_RESTRICT b, size_t num_b,
+                                   int32_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int32_t* HWY_RESTRICT a, size_t num_a,
+                                   const int32_t* HWY_RESTRICT b, size_t num_b,
+                                   int32_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int64_t* HWY_RESTRICT a, size_t num_a,
+                                   const int64_t* HWY_RESTRICT b, size_t num_b,
+                                   int64_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const int64_t* HWY_RESTRICT a, size_t num_a,
+                                   const int64_t* HWY_RESTRICT b, size_t num_b,
+                                   int64_t* HWY_RESTRICT out, SortDescending);
+// These two must only be called if hwy::HaveFloat16() is true.
+HWY_CONTRIB_DLLEXPORT void VQMerge(const float16_t* HWY_RESTRICT a,
+                                   size_t num_a,
+                                   const float16_t* HWY_RESTRICT b,
+                                   size_t num_b, float16_t* HWY_RESTRICT out,
+                                   SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const float16_t* HWY_RESTRICT a,
+                                   size_t num_a,
+                                   const float16_t* HWY_RESTRICT b,
+                                   size_t num_b, float16_t* HWY_RESTRICT out,
+                                   SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const float* HWY_RESTRICT a, size_t num_a,
+                                   const float* HWY_RESTRICT b, size_t num_b,
+                                   float* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const float* HWY_RESTRICT a, size_t num_a,
+                                   const float* HWY_RESTRICT b, size_t num_b,
+                                   float* HWY_RESTRICT out, SortDescending);
+// These two must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT void VQMerge(const double* HWY_RESTRICT a, size_t num_a,
+                                   const double* HWY_RESTRICT b, size_t num_b,
+                                   double* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const double* HWY_RESTRICT a, size_t num_a,
+                                   const double* HWY_RESTRICT b, size_t num_b,
+                                   double* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint128_t* HWY_RESTRICT a,
+                                   size_t num_a,
+                                   const uint128_t* HWY_RESTRICT b,
+                                   size_t num_b, uint128_t* HWY_RESTRICT out,
+                                   SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const uint128_t* HWY_RESTRICT a,
+                                   size_t num_a,
+                                   const uint128_t* HWY_RESTRICT b,
+                                   size_t num_b, uint128_t* HWY_RESTRICT out,
+                                   SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const K64V64* HWY_RESTRICT a, size_t num_a,
+                                   const K64V64* HWY_RESTRICT b, size_t num_b,
+                                   K64V64* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const K64V64* HWY_RESTRICT a, size_t num_a,
+                                   const K64V64* HWY_RESTRICT b, size_t num_b,
+                                   K64V64* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const K32V32* HWY_RESTRICT a, size_t num_a,
+                                   const K32V32* HWY_RESTRICT b, size_t num_b,
+                                   K32V32* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMerge(const K32V32* HWY_RESTRICT a, size_t num_a,
+                                   const K32V32* HWY_RESTRICT b, size_t num_b,
+                                   K32V32* HWY_RESTRICT out, SortDescending);
+
+// Merges the sorted `runs[i][0, run_lengths[i])`, for i < num_runs, into
+// `out`, which must not overlap them and has space for the sum of
+// `run_lengths`. Uses a tree of VQMerge, hence O(log num_runs) passes over the
+// data. Allocates a buffer of the same size as `out` if num_runs > 2.
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const uint16_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    uint16_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const uint16_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    uint16_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const uint32_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    uint32_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const uint32_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    uint32_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const uint64_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    uint64_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const uint64_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    uint64_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const int16_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    int16_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const int16_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    int16_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const int32_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    int32_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const int32_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    int32_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const int64_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    int64_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const int64_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    int64_t* HWY_RESTRICT out, SortDescending);
+// These two must only be called if hwy::HaveFloat16() is true.
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const float16_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    float16_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const float16_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    float16_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const float* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    float* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const float* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    float* HWY_RESTRICT out, SortDescending);
+// These two must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const double* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    double* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const double* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    double* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const uint128_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    uint128_t* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const uint128_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    uint128_t* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const K64V64* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    K64V64* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const K64V64* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    K64V64* HWY_RESTRICT out, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const K32V32* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    K32V32* HWY_RESTRICT out, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQMergeRuns(
+    const K32V32* HWY_RESTRICT const* HWY_RESTRICT runs,
+    const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+    K32V32* HWY_RESTRICT out, SortDescending);
+
+// Segmented sort: sorts each of the `num_segments` segments keys[offsets[i],
+// offsets[i + 1]) independently, with the same properties and supported types
+// as VQSort. `offsets` has `num_segments + 1` non-decreasing entries; keys
+// before offsets[0] or after offsets[num_segments] are not modified. Faster
+// than calling VQSort for each segment when there are many small segments,
+// because per-call setup is only done once and small segments are sorted
+// directly by sorting networks.
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint32_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint32_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint64_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint64_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int32_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int32_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int64_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int64_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+// These two must only be called if hwy::HaveFloat16() is true.
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(float16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(float16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(float* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(float* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+// These two must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(double* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(double* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint128_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint128_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(K64V64* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(K64V64* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(K32V32* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(K32V32* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending);
+
+// Same as VQSortSegments, but sorts groups of consecutive segments with about
+// the same total size on all workers of `pool`. Individual segments are not
+// split, hence large segments are better sorted with the VQSort overload that
+// takes a ThreadPool. Must not be called from within `pool.Run`.
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint32_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint32_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint64_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint64_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int32_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int32_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int64_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(int64_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+// These two must only be called if hwy::HaveFloat16() is true.
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(float16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(float16_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(float* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(float* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+// These two must only be called if hwy::HaveFloat64() is true.
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(double* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(double* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint128_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(uint128_t* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(K64V64* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(K64V64* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(K32V32* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortAscending,
+                                          ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSortSegments(K32V32* HWY_RESTRICT keys,
+                                          const size_t* HWY_RESTRICT offsets,
+                                          size_t num_segments, SortDescending,
+                                          ThreadPool& pool);
+
+// Key-value pairs with signed or floating-point keys, see KI32V32 etc. in
+// base.h. Same as the overloads for K32V32 and K64V64, but keys are ordered
+// according to their type, without requiring callers to encode them. For
+// floating-point keys, -0.0 is ordered before +0.0, and NaN are ordered first
+// or last depending on their sign bit. The float64 overloads do not require
+// hwy::HaveFloat64().
+HWY_CONTRIB_DLLEXPORT void VQSort(KI32V32* HWY_RESTRICT keys, size_t n,
+                                  SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSort(KI32V32* HWY_RESTRICT keys, size_t n,
+                                  SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSort(KI32V32* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(KI32V32* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(KI32V32* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(KI32V32* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(KI32V32* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(KI32V32* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSort(KF32V32* HWY_RESTRICT keys, size_t n,
+                                  SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSort(KF32V32* HWY_RESTRICT keys, size_t n,
+                                  SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSort(KF32V32* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(KF32V32* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(KF32V32* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(KF32V32* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(KF32V32* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(KF32V32* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSort(KI64V64* HWY_RESTRICT keys, size_t n,
+                                  SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSort(KI64V64* HWY_RESTRICT keys, size_t n,
+                                  SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSort(KI64V64* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(KI64V64* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(KI64V64* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(KI64V64* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(KI64V64* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(KI64V64* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSort(KF64V64* HWY_RESTRICT keys, size_t n,
+                                  SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSort(KF64V64* HWY_RESTRICT keys, size_t n,
+                                  SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSort(KF64V64* HWY_RESTRICT keys, size_t n,
+                                  SortAscending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQSort(KF64V64* HWY_RESTRICT keys, size_t n,
+                                  SortDescending, ThreadPool& pool);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(KF64V64* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQPartialSort(KF64V64* HWY_RESTRICT keys, size_t n,
+                                         size_t k, SortDescending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(KF64V64* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortAscending);
+HWY_CONTRIB_DLLEXPORT void VQSelect(KF64V64* HWY_RESTRICT keys, size_t n,
+                                    size_t k, SortDescending);
+
 // User-level caching is no longer required, so this class is no longer
 // beneficial. We recommend using the simpler VQSort() interface instead, and
 // retain this class only for compatibility. It now just calls VQSort.
@@ -163,6 +1041,13 @@ class HWY_CONTRIB_DLLEXPORT Sorter {
 #endif
 };
 
+// Returns the counters accumulated by all sorts on the calling thread since the
+// last ResetVQSortStats, or all zero unless the library was compiled with
+// VQSORT_STATS=1. To obtain the counters of a single call, reset before it.
+// Sorts with a ThreadPool also include the counters of their workers.
+HWY_CONTRIB_DLLEXPORT SortStats GetVQSortStats();
+HWY_CONTRIB_DLLEXPORT void ResetVQSortStats();
+
 // Used by vqsort-inl unless VQSORT_ONLY_STATIC.
 HWY_CONTRIB_DLLEXPORT bool Fill16BytesSecure(void* bytes);
 
@@ -21,6 +21,8 @@
 
 // After foreach_target
 #include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/contrib/sort/vqsort_merge-inl.h"
+#include "hwy/contrib/sort/vqsort_parallel-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace hwy {
@@ -30,6 +32,44 @@ void Sort128Asc(uint128_t* HWY_RESTRICT keys, size_t num) {
   return VQSortStatic(keys, num, SortAscending());
 }
 
+void ParallelSort128Asc(uint128_t* HWY_RESTRICT keys, size_t num,
+                        ThreadPool& pool) {
+  return VQSortStatic(keys, num, SortAscending(), pool);
+}
+
+void PartialSort128Asc(uint128_t* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQPartialSortStatic(keys, num, k, SortAscending());
+}
+
+void Select128Asc(uint128_t* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQSelectStatic(keys, num, k, SortAscending());
+}
+
+void Merge128Asc(const uint128_t* HWY_RESTRICT a, size_t num_a,
+                 const uint128_t* HWY_RESTRICT b, size_t num_b,
+                 uint128_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+}
+
+void MergeRuns128Asc(const uint128_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+                     const size_t* HWY_RESTRICT run_lengths,
+                     size_t num_runs, uint128_t* HWY_RESTRICT out) {
+  return VQMergeRunsStatic(runs, run_lengths, num_runs, out, SortAscending());
+}
+
+void SortSegments128Asc(uint128_t* HWY_RESTRICT keys,
+                        const size_t* HWY_RESTRICT offsets,
+                        size_t num_segments) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortAscending());
+}
+
+void ParallelSortSegments128Asc(uint128_t* HWY_RESTRICT keys,
+                                const size_t* HWY_RESTRICT offsets,
+                                size_t num_segments, ThreadPool& pool) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortAscending(),
+                              pool);
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
@@ -39,11 +79,57 @@ HWY_AFTER_NAMESPACE();
 namespace hwy {
 namespace {
 HWY_EXPORT(Sort128Asc);
+HWY_EXPORT(ParallelSort128Asc);
+HWY_EXPORT(PartialSort128Asc);
+HWY_EXPORT(Select128Asc);
+HWY_EXPORT(Merge128Asc);
+HWY_EXPORT(MergeRuns128Asc);
+HWY_EXPORT(SortSegments128Asc);
+HWY_EXPORT(ParallelSortSegments128Asc);
 }  // namespace
 
 void VQSort(uint128_t* HWY_RESTRICT keys, size_t n, SortAscending) {
   HWY_DYNAMIC_DISPATCH(Sort128Asc)(keys, n);
 }
 
+void VQSort(uint128_t* HWY_RESTRICT keys, size_t n, SortAscending,
+            ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSort128Asc)(keys, n, pool);
+}
+
+void VQPartialSort(uint128_t* HWY_RESTRICT keys, size_t n, size_t k,
+                   SortAscending) {
+  HWY_DYNAMIC_DISPATCH(PartialSort128Asc)(keys, n, k);
+}
+
+void VQSelect(uint128_t* HWY_RESTRICT keys, size_t n, size_t k, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(Select128Asc)(keys, n, k);
+}
+
+void VQMerge(const uint128_t* HWY_RESTRICT a, size_t num_a,
+             const uint128_t* HWY_RESTRICT b, size_t num_b,
+             uint128_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(Merge128Asc)(a, num_a, b, num_b, out);
+}
+
+void VQMergeRuns(const uint128_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+                 const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+                 uint128_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeRuns128Asc)(runs, run_lengths, num_runs, out);
+}
+
+void VQSortSegments(uint128_t* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortAscending) {
+  HWY_DYNAMIC_DISPATCH(SortSegments128Asc)(keys, offsets, num_segments);
+}
+
+void VQSortSegments(uint128_t* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortAscending, ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortSegments128Asc)(keys, offsets,
+                                                   num_segments, pool);
+}
+
 }  // namespace hwy
 #endif  // HWY_ONCE
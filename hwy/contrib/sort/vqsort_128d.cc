@@ -21,6 +21,8 @@
 
 // After foreach_target
 #include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/contrib/sort/vqsort_merge-inl.h"
+#include "hwy/contrib/sort/vqsort_parallel-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace hwy {
@@ -30,6 +32,44 @@ void Sort128Desc(uint128_t* HWY_RESTRICT keys, size_t num) {
   return VQSortStatic(keys, num, SortDescending());
 }
 
+void ParallelSort128Desc(uint128_t* HWY_RESTRICT keys, size_t num,
+                         ThreadPool& pool) {
+  return VQSortStatic(keys, num, SortDescending(), pool);
+}
+
+void PartialSort128Desc(uint128_t* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQPartialSortStatic(keys, num, k, SortDescending());
+}
+
+void Select128Desc(uint128_t* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQSelectStatic(keys, num, k, SortDescending());
+}
+
+void Merge128Desc(const uint128_t* HWY_RESTRICT a, size_t num_a,
+                  const uint128_t* HWY_RESTRICT b, size_t num_b,
+                  uint128_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+}
+
+void MergeRuns128Desc(const uint128_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+                      const size_t* HWY_RESTRICT run_lengths,
+                      size_t num_runs, uint128_t* HWY_RESTRICT out) {
+  return VQMergeRunsStatic(runs, run_lengths, num_runs, out, SortDescending());
+}
+
+void SortSegments128Desc(uint128_t* HWY_RESTRICT keys,
+                         const size_t* HWY_RESTRICT offsets,
+                         size_t num_segments) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortDescending());
+}
+
+void ParallelSortSegments128Desc(uint128_t* HWY_RESTRICT keys,
+                                 const size_t* HWY_RESTRICT offsets,
+                                 size_t num_segments, ThreadPool& pool) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortDescending(),
+                              pool);
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
@@ -39,11 +79,58 @@ HWY_AFTER_NAMESPACE();
 namespace hwy {
 namespace {
 HWY_EXPORT(Sort128Desc);
+HWY_EXPORT(ParallelSort128Desc);
+HWY_EXPORT(PartialSort128Desc);
+HWY_EXPORT(Select128Desc);
+HWY_EXPORT(Merge128Desc);
+HWY_EXPORT(MergeRuns128Desc);
+HWY_EXPORT(SortSegments128Desc);
+HWY_EXPORT(ParallelSortSegments128Desc);
 }  // namespace
 
 void VQSort(uint128_t* HWY_RESTRICT keys, size_t n, SortDescending) {
   HWY_DYNAMIC_DISPATCH(Sort128Desc)(keys, n);
 }
 
+void VQSort(uint128_t* HWY_RESTRICT keys, size_t n, SortDescending,
+            ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSort128Desc)(keys, n, pool);
+}
+
+void VQPartialSort(uint128_t* HWY_RESTRICT keys, size_t n, size_t k,
+                   SortDescending) {
+  HWY_DYNAMIC_DISPATCH(PartialSort128Desc)(keys, n, k);
+}
+
+void VQSelect(uint128_t* HWY_RESTRICT keys, size_t n, size_t k,
+              SortDescending) {
+  HWY_DYNAMIC_DISPATCH(Select128Desc)(keys, n, k);
+}
+
+void VQMerge(const uint128_t* HWY_RESTRICT a, size_t num_a,
+             const uint128_t* HWY_RESTRICT b, size_t num_b,
+             uint128_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(Merge128Desc)(a, num_a, b, num_b, out);
+}
+
+void VQMergeRuns(const uint128_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+                 const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+                 uint128_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeRuns128Desc)(runs, run_lengths, num_runs, out);
+}
+
+void VQSortSegments(uint128_t* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortDescending) {
+  HWY_DYNAMIC_DISPATCH(SortSegments128Desc)(keys, offsets, num_segments);
+}
+
+void VQSortSegments(uint128_t* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortDescending, ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortSegments128Desc)(keys, offsets,
+                                                    num_segments, pool);
+}
+
 }  // namespace hwy
 #endif  // HWY_ONCE
@@ -0,0 +1,379 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Argsort: packs (key, index) into the K32V32/K64V64 layouts used by the kv64
+// and kv128 traits, sorts those via VQSort, and unpacks the indices. Sorting
+// the pairs as whole u64/u128 rather than only by key additionally orders
+// equivalent keys by index, i.e. makes the argsort stable, at no extra cost.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/contrib/sort/vqsort.h"  // VQSort
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "hwy/contrib/sort/vqsort_argsort.cc"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+
+// After foreach_target
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace {
+
+// ------------------------------ Key transform
+
+// Returns unsigned integers whose ascending order matches the ascending order
+// of the original keys.
+template <class DU, class V, HWY_IF_UNSIGNED_V(V)>
+HWY_INLINE VFromD<DU> AscendingBits(DU /* du */, V v) {
+  return v;
+}
+
+template <class DU, class V, HWY_IF_SIGNED_V(V)>
+HWY_INLINE VFromD<DU> AscendingBits(DU du, V v) {
+  return Xor(BitCast(du, v), SignBit(du));
+}
+
+// Flips all bits of negative numbers, otherwise only the sign bit. -0.0 is
+// treated as +0.0 because VQSort considers them equivalent.
+template <class DU, class V, HWY_IF_FLOAT_V(V)>
+HWY_INLINE VFromD<DU> AscendingBits(DU du, V v) {
+  const DFromV<V> df;
+  const RebindToSigned<DU> di;
+  const VFromD<DU> bits = BitCast(du, IfThenZeroElse(Eq(v, Zero(df)), v));
+  const VFromD<DU> negative = BitCast(du, BroadcastSignBit(BitCast(di, bits)));
+  return Xor(bits, Or(negative, SignBit(du)));
+}
+
+// VQSort orders NaN after all other keys regardless of the sort order.
+template <class DU, class V, HWY_IF_NOT_FLOAT_V(V)>
+HWY_INLINE VFromD<DU> MaxIfNaN(DU /* du */, V /* v */, VFromD<DU> bits) {
+  return bits;
+}
+
+template <class DU, class V, HWY_IF_FLOAT_V(V)>
+HWY_INLINE VFromD<DU> MaxIfNaN(DU du, V v, VFromD<DU> bits) {
+  return IfThenElse(RebindMask(du, IsNaN(v)), Set(du, LimitsMax<TFromD<DU>>()),
+                    bits);
+}
+
+// The pairs are always sorted in ascending order of these.
+template <class DU, class V>
+HWY_INLINE VFromD<DU> OrderedBits(DU du, V v, SortAscending) {
+  return MaxIfNaN(du, v, AscendingBits(du, v));
+}
+
+template <class DU, class V>
+HWY_INLINE VFromD<DU> OrderedBits(DU du, V v, SortDescending) {
+  return MaxIfNaN(du, v, Not(AscendingBits(du, v)));
+}
+
+// ------------------------------ Argsort
+
+// 32-bit keys: each u64 lane holds the transformed key in the upper half and
+// the index in the lower half, as expected by the kv64 traits.
+template <class Order, typename T, HWY_IF_T_SIZE(T, 4)>
+void Argsort(const T* HWY_RESTRICT keys, size_t num,
+             uint32_t* HWY_RESTRICT indices) {
+  HWY_ASSERT(num <= static_cast<size_t>(LimitsMax<uint32_t>()));
+  if (num < 2) {
+    if (num == 1) indices[0] = 0;
+    return;
+  }
+  const ScalableTag<uint64_t> dw;
+  const Rebind<T, decltype(dw)> d;
+  const RebindToUnsigned<decltype(d)> du;
+  using VW = Vec<decltype(dw)>;
+  const size_t N = Lanes(dw);
+
+  auto pairs = hwy::AllocateAligned<uint64_t>(num);
+  HWY_ASSERT(pairs);
+
+  VW index = Iota(dw, 0);
+  const VW vN = Set(dw, N);
+  size_t i = 0;
+  for (; i + N <= num; i += N) {
+    const VW key = PromoteTo(dw, OrderedBits(du, LoadU(d, keys + i), Order()));
+    StoreU(Or(ShiftLeft<32>(key), index), dw, pairs.get() + i);
+    index = Add(index, vN);
+  }
+  const size_t remaining = num - i;
+  if (remaining != 0) {
+    const VW key =
+        PromoteTo(dw, OrderedBits(du, LoadN(d, keys + i, remaining), Order()));
+    StoreN(Or(ShiftLeft<32>(key), index), dw, pairs.get() + i, remaining);
+  }
+
+  hwy::VQSort(pairs.get(), num, SortAscending());
+
+  const Rebind<uint32_t, decltype(dw)> d32;
+  for (i = 0; i + N <= num; i += N) {
+    StoreU(TruncateTo(d32, LoadU(dw, pairs.get() + i)), d32, indices + i);
+  }
+  for (; i < num; ++i) {
+    indices[i] = static_cast<uint32_t>(pairs[i] & 0xFFFFFFFFu);
+  }
+}
+
+// 64-bit keys: pairs of u64 lanes, the index followed by the transformed key,
+// as expected by the kv128 traits.
+template <class Order, typename T, HWY_IF_T_SIZE(T, 8)>
+void Argsort(const T* HWY_RESTRICT keys, size_t num,
+             uint64_t* HWY_RESTRICT indices) {
+  if (num < 2) {
+    if (num == 1) indices[0] = 0;
+    return;
+  }
+  const ScalableTag<T> d;
+  const RebindToUnsigned<decltype(d)> du;
+  using VU = Vec<decltype(du)>;
+  const size_t N = Lanes(du);
+
+  auto pairs = hwy::AllocateAligned<uint64_t>(2 * num);
+  HWY_ASSERT(pairs);
+
+  VU index = Iota(du, 0);
+  const VU vN = Set(du, N);
+  size_t i = 0;
+  for (; i + N <= num; i += N) {
+    const VU key = OrderedBits(du, LoadU(d, keys + i), Order());
+    StoreInterleaved2(index, key, du, pairs.get() + 2 * i);
+    index = Add(index, vN);
+  }
+  const size_t remaining = num - i;
+  if (remaining != 0) {
+    HWY_ALIGN uint64_t buf[2 * HWY_MAX_BYTES / sizeof(uint64_t)];
+    const VU key = OrderedBits(du, LoadN(d, keys + i, remaining), Order());
+    StoreInterleaved2(index, key, du, buf);
+    CopyBytes(buf, pairs.get() + 2 * i, 2 * remaining * sizeof(uint64_t));
+  }
+
+  hwy::VQSort(reinterpret_cast<uint128_t*>(pairs.get()), num,
+              SortAscending());
+
+  for (i = 0; i + N <= num; i += N) {
+    VU value, key;
+    LoadInterleaved2(du, pairs.get() + 2 * i, value, key);
+    StoreU(value, du, indices + i);
+  }
+  for (; i < num; ++i) {
+    indices[i] = pairs[2 * i];
+  }
+}
+
+// ------------------------------ ApplyPermutation
+
+// Indices and values have the same size, so indices can be used as-is. Gather
+// interprets them as signed, hence only vectorize if all indices, which are
+// less than `num`, are non-negative when reinterpreted as signed.
+template <typename TI, typename T,
+          hwy::EnableIf<sizeof(T) == sizeof(TI) && sizeof(T) >= 4>* = nullptr>
+void ApplyPermutation(const TI* HWY_RESTRICT indices, size_t num,
+                      const T* HWY_RESTRICT in, T* HWY_RESTRICT out) {
+  const ScalableTag<T> d;
+  const RebindToSigned<decltype(d)> di;
+  const RebindToUnsigned<decltype(d)> du;
+  const size_t N = Lanes(d);
+  size_t i = 0;
+  if (static_cast<uint64_t>(num) <=
+      static_cast<uint64_t>(LimitsMax<MakeSigned<TI>>())) {
+    for (; i + N <= num; i += N) {
+      const Vec<decltype(di)> index = BitCast(di, LoadU(du, indices + i));
+      StoreU(GatherIndex(d, in, index), d, out + i);
+    }
+  }
+  for (; i < num; ++i) {
+    out[i] = in[indices[i]];
+  }
+}
+
+// 64-bit values, 32-bit indices: promote the indices.
+template <typename TI, typename T,
+          hwy::EnableIf<sizeof(T) == 8 && sizeof(TI) == 4>* = nullptr>
+void ApplyPermutation(const TI* HWY_RESTRICT indices, size_t num,
+                      const T* HWY_RESTRICT in, T* HWY_RESTRICT out) {
+  const ScalableTag<T> d;
+  const RebindToSigned<decltype(d)> di;
+  const RebindToUnsigned<decltype(d)> du;
+  const Rebind<uint32_t, decltype(d)> d32;
+  const size_t N = Lanes(d);
+  size_t i = 0;
+  for (; i + N <= num; i += N) {
+    const Vec<decltype(di)> index =
+        BitCast(di, PromoteTo(du, LoadU(d32, indices + i)));
+    StoreU(GatherIndex(d, in, index), d, out + i);
+  }
+  for (; i < num; ++i) {
+    out[i] = in[indices[i]];
+  }
+}
+
+// 32-bit values, 64-bit indices: the indices are less than `num`. If that fits
+// in int32_t, they can be truncated for the gather; otherwise, only the scalar
+// loop is used.
+template <typename TI, typename T,
+          hwy::EnableIf<sizeof(T) == 4 && sizeof(TI) == 8>* = nullptr>
+void ApplyPermutation(const TI* HWY_RESTRICT indices, size_t num,
+                      const T* HWY_RESTRICT in, T* HWY_RESTRICT out) {
+  const ScalableTag<uint64_t> d64;
+  const Rebind<T, decltype(d64)> d;
+  const RebindToSigned<decltype(d)> di;
+  const RebindToUnsigned<decltype(d)> du;
+  const size_t N = Lanes(d64);
+  size_t i = 0;
+  if (static_cast<uint64_t>(num) <=
+      static_cast<uint64_t>(LimitsMax<int32_t>())) {
+    for (; i + N <= num; i += N) {
+      const Vec<decltype(di)> index =
+          BitCast(di, TruncateTo(du, LoadU(d64, indices + i)));
+      StoreU(GatherIndex(d, in, index), d, out + i);
+    }
+  }
+  for (; i < num; ++i) {
+    out[i] = in[indices[i]];
+  }
+}
+
+// There is no gather for 8 or 16-bit lanes.
+template <typename TI, typename T, hwy::EnableIf<sizeof(T) <= 2>* = nullptr>
+void ApplyPermutation(const TI* HWY_RESTRICT indices, size_t num,
+                      const T* HWY_RESTRICT in, T* HWY_RESTRICT out) {
+  for (size_t i = 0; i < num; ++i) {
+    out[i] = in[indices[i]];
+  }
+}
+
+}  // namespace
+
+// Exported (only via HWY_EXPORT below), hence outside the anonymous namespace.
+#define HWY_ARGSORT_IMPL(NAME, T, TI, ORDER)                      \
+  void NAME(const T* HWY_RESTRICT keys, size_t num,               \
+            TI* HWY_RESTRICT indices) {                           \
+    return Argsort<ORDER>(keys, num, indices);                    \
+  }
+
+HWY_ARGSORT_IMPL(ArgsortU32Asc, uint32_t, uint32_t, SortAscending)
+HWY_ARGSORT_IMPL(ArgsortU32Desc, uint32_t, uint32_t, SortDescending)
+HWY_ARGSORT_IMPL(ArgsortI32Asc, int32_t, uint32_t, SortAscending)
+HWY_ARGSORT_IMPL(ArgsortI32Desc, int32_t, uint32_t, SortDescending)
+HWY_ARGSORT_IMPL(ArgsortF32Asc, float, uint32_t, SortAscending)
+HWY_ARGSORT_IMPL(ArgsortF32Desc, float, uint32_t, SortDescending)
+HWY_ARGSORT_IMPL(ArgsortU64Asc, uint64_t, uint64_t, SortAscending)
+HWY_ARGSORT_IMPL(ArgsortU64Desc, uint64_t, uint64_t, SortDescending)
+HWY_ARGSORT_IMPL(ArgsortI64Asc, int64_t, uint64_t, SortAscending)
+HWY_ARGSORT_IMPL(ArgsortI64Desc, int64_t, uint64_t, SortDescending)
+#if HWY_HAVE_FLOAT64
+HWY_ARGSORT_IMPL(ArgsortF64Asc, double, uint64_t, SortAscending)
+HWY_ARGSORT_IMPL(ArgsortF64Desc, double, uint64_t, SortDescending)
+#else
+void ArgsortF64Asc(const double* HWY_RESTRICT, size_t, uint64_t* HWY_RESTRICT) {
+  HWY_ASSERT(0);
+}
+void ArgsortF64Desc(const double* HWY_RESTRICT, size_t,
+                    uint64_t* HWY_RESTRICT) {
+  HWY_ASSERT(0);
+}
+#endif  // HWY_HAVE_FLOAT64
+#undef HWY_ARGSORT_IMPL
+
+#define HWY_PERMUTE_IMPL(NAME, T, TI)                                  \
+  void NAME(const TI* HWY_RESTRICT indices, size_t num,                \
+            const T* HWY_RESTRICT in, T* HWY_RESTRICT out) {           \
+    return ApplyPermutation(indices, num, in, out);                    \
+  }
+
+HWY_PERMUTE_IMPL(PermuteU8Idx32, uint8_t, uint32_t)
+HWY_PERMUTE_IMPL(PermuteU16Idx32, uint16_t, uint32_t)
+HWY_PERMUTE_IMPL(PermuteU32Idx32, uint32_t, uint32_t)
+HWY_PERMUTE_IMPL(PermuteU64Idx32, uint64_t, uint32_t)
+HWY_PERMUTE_IMPL(PermuteU8Idx64, uint8_t, uint64_t)
+HWY_PERMUTE_IMPL(PermuteU16Idx64, uint16_t, uint64_t)
+HWY_PERMUTE_IMPL(PermuteU32Idx64, uint32_t, uint64_t)
+HWY_PERMUTE_IMPL(PermuteU64Idx64, uint64_t, uint64_t)
+#undef HWY_PERMUTE_IMPL
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace hwy {
+namespace {
+HWY_EXPORT(ArgsortU32Asc);
+HWY_EXPORT(ArgsortU32Desc);
+HWY_EXPORT(ArgsortI32Asc);
+HWY_EXPORT(ArgsortI32Desc);
+HWY_EXPORT(ArgsortF32Asc);
+HWY_EXPORT(ArgsortF32Desc);
+HWY_EXPORT(ArgsortU64Asc);
+HWY_EXPORT(ArgsortU64Desc);
+HWY_EXPORT(ArgsortI64Asc);
+HWY_EXPORT(ArgsortI64Desc);
+HWY_EXPORT(ArgsortF64Asc);
+HWY_EXPORT(ArgsortF64Desc);
+HWY_EXPORT(PermuteU8Idx32);
+HWY_EXPORT(PermuteU16Idx32);
+HWY_EXPORT(PermuteU32Idx32);
+HWY_EXPORT(PermuteU64Idx32);
+HWY_EXPORT(PermuteU8Idx64);
+HWY_EXPORT(PermuteU16Idx64);
+HWY_EXPORT(PermuteU32Idx64);
+HWY_EXPORT(PermuteU64Idx64);
+}  // namespace
+
+#define HWY_ARGSORT_DISPATCH(NAME, T, TI, ORDER)                       \
+  void VQArgsort(const T* HWY_RESTRICT keys, size_t n,                 \
+                 TI* HWY_RESTRICT indices, ORDER) {                    \
+    HWY_DYNAMIC_DISPATCH(NAME)(keys, n, indices);                      \
+  }
+
+HWY_ARGSORT_DISPATCH(ArgsortU32Asc, uint32_t, uint32_t, SortAscending)
+HWY_ARGSORT_DISPATCH(ArgsortU32Desc, uint32_t, uint32_t, SortDescending)
+HWY_ARGSORT_DISPATCH(ArgsortI32Asc, int32_t, uint32_t, SortAscending)
+HWY_ARGSORT_DISPATCH(ArgsortI32Desc, int32_t, uint32_t, SortDescending)
+HWY_ARGSORT_DISPATCH(ArgsortF32Asc, float, uint32_t, SortAscending)
+HWY_ARGSORT_DISPATCH(ArgsortF32Desc, float, uint32_t, SortDescending)
+HWY_ARGSORT_DISPATCH(ArgsortU64Asc, uint64_t, uint64_t, SortAscending)
+HWY_ARGSORT_DISPATCH(ArgsortU64Desc, uint64_t, uint64_t, SortDescending)
+HWY_ARGSORT_DISPATCH(ArgsortI64Asc, int64_t, uint64_t, SortAscending)
+HWY_ARGSORT_DISPATCH(ArgsortI64Desc, int64_t, uint64_t, SortDescending)
+HWY_ARGSORT_DISPATCH(ArgsortF64Asc, double, uint64_t, SortAscending)
+HWY_ARGSORT_DISPATCH(ArgsortF64Desc, double, uint64_t, SortDescending)
+#undef HWY_ARGSORT_DISPATCH
+
+#define HWY_PERMUTE_DISPATCH(NAME, T, TI)                                \
+  void VQApplyPermutation(const TI* HWY_RESTRICT indices, size_t n,      \
+                          const T* HWY_RESTRICT in, T* HWY_RESTRICT out) { \
+    HWY_DYNAMIC_DISPATCH(NAME)(indices, n, in, out);                     \
+  }
+
+HWY_PERMUTE_DISPATCH(PermuteU8Idx32, uint8_t, uint32_t)
+HWY_PERMUTE_DISPATCH(PermuteU16Idx32, uint16_t, uint32_t)
+HWY_PERMUTE_DISPATCH(PermuteU32Idx32, uint32_t, uint32_t)
+HWY_PERMUTE_DISPATCH(PermuteU64Idx32, uint64_t, uint32_t)
+HWY_PERMUTE_DISPATCH(PermuteU8Idx64, uint8_t, uint64_t)
+HWY_PERMUTE_DISPATCH(PermuteU16Idx64, uint16_t, uint64_t)
+HWY_PERMUTE_DISPATCH(PermuteU32Idx64, uint32_t, uint64_t)
+HWY_PERMUTE_DISPATCH(PermuteU64Idx64, uint64_t, uint64_t)
+#undef HWY_PERMUTE_DISPATCH
+
+}  // namespace hwy
+#endif  // HWY_ONCE
@@ -0,0 +1,269 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// External (out-of-core) sort of files of fixed-width keys that do not fit in
+// memory: sorts memory-sized chunks with VQSort, writes them to temporary
+// files ("runs"), then merges the runs with VQMergeRuns. All reads and writes
+// are sequential and use large aligned buffers.
+
+#ifndef HIGHWAY_HWY_CONTRIB_SORT_VQSORT_EXTERNAL_H_
+#define HIGHWAY_HWY_CONTRIB_SORT_VQSORT_EXTERNAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>  // strlen
+
+#include <utility>  // std::move
+#include <vector>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/contrib/sort/vqsort.h"
+
+namespace hwy {
+
+namespace detail {
+
+// Reads up to `num` keys; returns the number read, which is less than `num`
+// only at the end of the file or on error (see ferror).
+template <typename T>
+size_t ReadKeys(FILE* file, T* HWY_RESTRICT keys, size_t num) {
+  return fread(keys, sizeof(T), num, file);
+}
+
+template <typename T>
+bool WriteKeys(FILE* file, const T* HWY_RESTRICT keys, size_t num) {
+  return fwrite(keys, sizeof(T), num, file) == num;
+}
+
+// Whether `a` is ordered after `b`.
+template <typename T>
+bool IsAfter(const T& a, const T& b, SortAscending) {
+  return b < a;
+}
+template <typename T>
+bool IsAfter(const T& a, const T& b, SortDescending) {
+  return a < b;
+}
+
+// One sorted run in a temporary file, with a buffer of its next keys.
+template <typename T>
+struct ExternalRun {
+  FILE* file = nullptr;
+  AlignedFreeUniquePtr<T[]> buf;
+  size_t begin = 0;  // first unused key in `buf`
+  size_t end = 0;    // one past the last valid key in `buf`
+  bool exhausted = false;  // whether `file` has no more keys
+
+  // Moves the unused keys to the front of `buf` and fills the remainder.
+  bool Refill(size_t capacity) {
+    const size_t num = end - begin;
+    if (num != 0 && begin != 0) {
+      CopyBytes(buf.get() + begin, buf.get(), num * sizeof(T));
+    }
+    begin = 0;
+    end = num;
+    if (!exhausted) {
+      end += ReadKeys(file, buf.get() + num, capacity - num);
+      if (end != capacity) {
+        if (ferror(file)) return false;
+        exhausted = true;
+      }
+    }
+    return true;
+  }
+};
+
+// Merges the runs into `out`. Each round emits, from every run, all buffered
+// keys not ordered after the smallest last buffered key of any run that is not
+// yet exhausted. Keys after that may still be preceded by unread keys.
+template <typename T, class Order>
+bool MergeExternalRuns(std::vector<ExternalRun<T>>& runs, size_t capacity,
+                       FILE* out, Order order) {
+  const size_t num_runs = runs.size();
+  std::vector<const T*> ptrs(num_runs);
+  std::vector<size_t> lengths(num_runs);
+  AlignedFreeUniquePtr<T[]> merged =
+      AllocateAligned<T>(num_runs * capacity);
+  if (!merged) return false;
+
+  for (ExternalRun<T>& run : runs) {
+    if (!run.Refill(capacity)) return false;
+  }
+
+  for (;;) {
+    const T* bound = nullptr;
+    for (const ExternalRun<T>& run : runs) {
+      if (run.exhausted || run.begin == run.end) continue;
+      const T* last = run.buf.get() + run.end - 1;
+      if (bound == nullptr || IsAfter(*bound, *last, order)) bound = last;
+    }
+
+    size_t num_merged = 0;
+    size_t num_nonempty = 0;
+    for (size_t r = 0; r < num_runs; ++r) {
+      ExternalRun<T>& run = runs[r];
+      const T* begin = run.buf.get() + run.begin;
+      // Binary search for the first key after `bound`.
+      size_t lo = 0;
+      size_t hi = run.end - run.begin;
+      if (bound != nullptr) {
+        while (lo < hi) {
+          const size_t mid = lo + (hi - lo) / 2;
+          if (IsAfter(begin[mid], *bound, order)) {
+            hi = mid;
+          } else {
+            lo = mid + 1;
+          }
+        }
+      }
+      if (hi == 0) continue;
+      ptrs[num_nonempty] = begin;
+      lengths[num_nonempty] = hi;
+      ++num_nonempty;
+      num_merged += hi;
+      run.begin += hi;
+    }
+    if (num_merged == 0) return true;  // all runs are exhausted
+
+    if (num_nonempty == 1) {
+      if (!WriteKeys(out, ptrs[0], lengths[0])) return false;
+    } else {
+      VQMergeRuns(ptrs.data(), lengths.data(), num_nonempty, merged.get(),
+                  order);
+      if (!WriteKeys(out, merged.get(), num_merged)) return false;
+    }
+
+    for (ExternalRun<T>& run : runs) {
+      if (run.begin == run.end && !run.Refill(capacity)) return false;
+    }
+  }
+}
+
+// Returns a new temporary file, deleted when closed if `tmp_dir` is null.
+// Otherwise, the caller must remove `path`.
+static inline FILE* OpenTemporary(const char* tmp_dir, const void* unique,
+                                  size_t index, std::vector<char>& path) {
+  if (tmp_dir == nullptr) return tmpfile();
+  path.resize(strlen(tmp_dir) + 64);
+  // Exclusive mode ("x") fails if the file exists, e.g. because another
+  // process uses the same `unique` address; try again with another suffix.
+  for (size_t attempt = 0; attempt < 100; ++attempt) {
+    snprintf(path.data(), path.size(), "%s/hwy_vqsort_%p_%zu_%zu.tmp",
+             tmp_dir, unique, index, attempt);
+    FILE* file = fopen(path.data(), "w+bx");
+    if (file != nullptr) return file;
+  }
+  return nullptr;
+}
+
+}  // namespace detail
+
+// Sorts all keys of the binary file `in`, which must contain a multiple of
+// sizeof(T) bytes, and writes them to `out`. Both must be opened in binary
+// mode; reading resp. writing begins at their current position. Uses about
+// `max_bytes` of memory. If the input does not fit, sorted runs are written to
+// temporary files in `tmp_dir`, or via tmpfile() if null, and then merged.
+// If `pool` is non-null, chunks are sorted with the parallel VQSort.
+//
+// Supports the key types of VQMergeRuns. Keys must not be NaN. Returns false
+// on I/O or allocation errors, in which case `out` is incomplete.
+template <typename T, class Order>
+bool VQSortExternal(FILE* in, FILE* out, size_t max_bytes, Order order,
+                    ThreadPool* pool = nullptr,
+                    const char* tmp_dir = nullptr) {
+  // Larger chunks mean fewer runs to merge.
+  const size_t chunk_keys = HWY_MAX(max_bytes, size_t{64} << 10) / sizeof(T);
+  AlignedFreeUniquePtr<T[]> chunk = AllocateAligned<T>(chunk_keys);
+  if (!chunk) return false;
+
+  std::vector<detail::ExternalRun<T>> runs;
+  std::vector<std::vector<char>> paths;
+  bool ok = true;
+  for (;;) {
+    const size_t num = detail::ReadKeys(in, chunk.get(), chunk_keys);
+    if (num != chunk_keys && ferror(in)) {
+      ok = false;
+      break;
+    }
+    if (num == 0) break;
+    if (pool != nullptr) {
+      VQSort(chunk.get(), num, order, *pool);
+    } else {
+      VQSort(chunk.get(), num, order);
+    }
+
+    // Everything fit into a single chunk: no need for temporary files.
+    if (runs.empty() && num != chunk_keys) {
+      return detail::WriteKeys(out, chunk.get(), num);
+    }
+
+    paths.emplace_back();
+    detail::ExternalRun<T> run;
+    run.file =
+        detail::OpenTemporary(tmp_dir, chunk.get(), runs.size(), paths.back());
+    if (run.file == nullptr) {
+      ok = false;
+      break;
+    }
+    runs.push_back(std::move(run));
+    if (!detail::WriteKeys(runs.back().file, chunk.get(), num) ||
+        fflush(runs.back().file) != 0) {
+      ok = false;
+      break;
+    }
+    if (num != chunk_keys) break;
+  }
+  chunk.reset();  // Free before allocating the merge buffers.
+
+  if (ok && !runs.empty()) {
+    // Split the memory between one read buffer per run plus the merge output,
+    // and VQMergeRuns allocates a buffer of the same size as the latter.
+    const size_t capacity =
+        HWY_MAX(chunk_keys / (3 * runs.size()), size_t{4096} / sizeof(T));
+    for (detail::ExternalRun<T>& run : runs) {
+      run.buf = AllocateAligned<T>(capacity);
+      ok = ok && run.buf && fseek(run.file, 0, SEEK_SET) == 0;
+    }
+    ok = ok && detail::MergeExternalRuns(runs, capacity, out, order);
+  }
+
+  for (size_t r = 0; r < runs.size(); ++r) {
+    fclose(runs[r].file);
+    if (tmp_dir != nullptr) remove(paths[r].data());
+  }
+  return ok;
+}
+
+// Same as above, but opens the files at the given paths, which must differ.
+template <typename T, class Order>
+bool VQSortFile(const char* in_path, const char* out_path, size_t max_bytes,
+                Order order, ThreadPool* pool = nullptr,
+                const char* tmp_dir = nullptr) {
+  HWY_ASSERT(strcmp(in_path, out_path) != 0);
+  FILE* in = fopen(in_path, "rb");
+  if (in == nullptr) return false;
+  FILE* out = fopen(out_path, "wb");
+  bool ok = out != nullptr &&
+            VQSortExternal<T>(in, out, max_bytes, order, pool, tmp_dir);
+  fclose(in);
+  if (out != nullptr) ok = (fclose(out) == 0) && ok;
+  return ok;
+}
+
+}  // namespace hwy
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_VQSORT_EXTERNAL_H_
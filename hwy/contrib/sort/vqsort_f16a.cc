@@ -21,6 +21,8 @@
 
 // After foreach_target
 #include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/contrib/sort/vqsort_merge-inl.h"
+#include "hwy/contrib/sort/vqsort_parallel-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace hwy {
@@ -36,6 +38,102 @@ void SortF16Asc(float16_t* HWY_RESTRICT keys, size_t num) {
 #endif
 }
 
+void ParallelSortF16Asc(float16_t* HWY_RESTRICT keys, size_t num,
+                        ThreadPool& pool) {
+#if HWY_HAVE_FLOAT16
+  return VQSortStatic(keys, num, SortAscending(), pool);
+#else
+  (void)keys;
+  (void)num;
+  (void)pool;
+  HWY_ASSERT(0);
+#endif
+}
+
+void PartialSortF16Asc(float16_t* HWY_RESTRICT keys, size_t num, size_t k) {
+#if HWY_HAVE_FLOAT16
+  return VQPartialSortStatic(keys, num, k, SortAscending());
+#else
+  (void)keys;
+  (void)num;
+  (void)k;
+  HWY_ASSERT(0);
+#endif
+}
+
+void SelectF16Asc(float16_t* HWY_RESTRICT keys, size_t num, size_t k) {
+#if HWY_HAVE_FLOAT16
+  return VQSelectStatic(keys, num, k, SortAscending());
+#else
+  (void)keys;
+  (void)num;
+  (void)k;
+  HWY_ASSERT(0);
+#endif
+}
+
+void MergeF16Asc(const float16_t* HWY_RESTRICT a, size_t num_a,
+                 const float16_t* HWY_RESTRICT b, size_t num_b,
+                 float16_t* HWY_RESTRICT out) {
+#if HWY_HAVE_FLOAT16
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+#else
+  (void)a;
+  (void)num_a;
+  (void)b;
+  (void)num_b;
+  (void)out;
+  HWY_ASSERT(0);
+#endif
+}
+
+void MergeRunsF16Asc(const float16_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+                     const size_t* HWY_RESTRICT run_lengths,
+                     size_t num_runs, float16_t* HWY_RESTRICT out) {
+#if HWY_HAVE_FLOAT16
+  return VQMergeRunsStatic(runs, run_lengths, num_runs, out, SortAscending());
+#else
+  (void)runs;
+  (void)run_lengths;
+  (void)num_runs;
+  (void)out;
+  HWY_ASSERT(0);
+#endif
+}
+
+void SortSegmentsF16Asc(float16_t* HWY_RESTRICT keys,
+                        const size_t* HWY_RESTRICT offsets,
+                        size_t num_segments) {
+#if HWY_HAVE_FLOAT16
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortAscending());
+#else
+  (void)keys;
+  (void)offsets;
+  (void)num_segments;
+  HWY_ASSERT(0);
+#endif
+}
+
+void ParallelSortSegmentsF16Asc(float16_t* HWY_RESTRICT keys,
+                                const size_t* HWY_RESTRICT offsets,
+                                size_t num_segments, ThreadPool& pool) {
+#if HWY_HAVE_FLOAT16
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortAscending(),
+                              pool);
+#else
+  (void)keys;
+  (void)offsets;
+  (void)num_segments;
+  (void)pool;
+  HWY_ASSERT(0);
+#endif
+}
+
+void SortF16AscFloatOrder(float16_t* HWY_RESTRICT keys, size_t num,
+                          FloatOrder float_order) {
+  return VQSortStatic(keys, num, SortAscending(), float_order);
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
@@ -45,11 +143,63 @@ HWY_AFTER_NAMESPACE();
 namespace hwy {
 namespace {
 HWY_EXPORT(SortF16Asc);
+HWY_EXPORT(ParallelSortF16Asc);
+HWY_EXPORT(PartialSortF16Asc);
+HWY_EXPORT(SelectF16Asc);
+HWY_EXPORT(MergeF16Asc);
+HWY_EXPORT(MergeRunsF16Asc);
+HWY_EXPORT(SortSegmentsF16Asc);
+HWY_EXPORT(ParallelSortSegmentsF16Asc);
+HWY_EXPORT(SortF16AscFloatOrder);
 }  // namespace
 
 void VQSort(float16_t* HWY_RESTRICT keys, size_t n, SortAscending) {
   HWY_DYNAMIC_DISPATCH(SortF16Asc)(keys, n);
 }
 
+void VQSort(float16_t* HWY_RESTRICT keys, size_t n, SortAscending,
+            ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortF16Asc)(keys, n, pool);
+}
+
+void VQPartialSort(float16_t* HWY_RESTRICT keys, size_t n, size_t k,
+                   SortAscending) {
+  HWY_DYNAMIC_DISPATCH(PartialSortF16Asc)(keys, n, k);
+}
+
+void VQSelect(float16_t* HWY_RESTRICT keys, size_t n, size_t k, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(SelectF16Asc)(keys, n, k);
+}
+
+void VQMerge(const float16_t* HWY_RESTRICT a, size_t num_a,
+             const float16_t* HWY_RESTRICT b, size_t num_b,
+             float16_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeF16Asc)(a, num_a, b, num_b, out);
+}
+
+void VQMergeRuns(const float16_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+                 const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+                 float16_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeRunsF16Asc)(runs, run_lengths, num_runs, out);
+}
+
+void VQSortSegments(float16_t* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortAscending) {
+  HWY_DYNAMIC_DISPATCH(SortSegmentsF16Asc)(keys, offsets, num_segments);
+}
+
+void VQSortSegments(float16_t* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortAscending, ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortSegmentsF16Asc)(keys, offsets,
+                                                   num_segments, pool);
+}
+
+void VQSort(float16_t* HWY_RESTRICT keys, size_t n, SortAscending,
+            FloatOrder float_order) {
+  HWY_DYNAMIC_DISPATCH(SortF16AscFloatOrder)(keys, n, float_order);
+}
+
 }  // namespace hwy
 #endif  // HWY_ONCE
@@ -21,6 +21,8 @@
 
 // After foreach_target
 #include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/contrib/sort/vqsort_merge-inl.h"
+#include "hwy/contrib/sort/vqsort_parallel-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace hwy {
@@ -36,6 +38,102 @@ void SortF16Desc(float16_t* HWY_RESTRICT keys, size_t num) {
 #endif
 }
 
+void ParallelSortF16Desc(float16_t* HWY_RESTRICT keys, size_t num,
+                         ThreadPool& pool) {
+#if HWY_HAVE_FLOAT16
+  return VQSortStatic(keys, num, SortDescending(), pool);
+#else
+  (void)keys;
+  (void)num;
+  (void)pool;
+  HWY_ASSERT(0);
+#endif
+}
+
+void PartialSortF16Desc(float16_t* HWY_RESTRICT keys, size_t num, size_t k) {
+#if HWY_HAVE_FLOAT16
+  return VQPartialSortStatic(keys, num, k, SortDescending());
+#else
+  (void)keys;
+  (void)num;
+  (void)k;
+  HWY_ASSERT(0);
+#endif
+}
+
+void SelectF16Desc(float16_t* HWY_RESTRICT keys, size_t num, size_t k) {
+#if HWY_HAVE_FLOAT16
+  return VQSelectStatic(keys, num, k, SortDescending());
+#else
+  (void)keys;
+  (void)num;
+  (void)k;
+  HWY_ASSERT(0);
+#endif
+}
+
+void MergeF16Desc(const float16_t* HWY_RESTRICT a, size_t num_a,
+                  const float16_t* HWY_RESTRICT b, size_t num_b,
+                  float16_t* HWY_RESTRICT out) {
+#if HWY_HAVE_FLOAT16
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+#else
+  (void)a;
+  (void)num_a;
+  (void)b;
+  (void)num_b;
+  (void)out;
+  HWY_ASSERT(0);
+#endif
+}
+
+void MergeRunsF16Desc(const float16_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+                      const size_t* HWY_RESTRICT run_lengths,
+                      size_t num_runs, float16_t* HWY_RESTRICT out) {
+#if HWY_HAVE_FLOAT16
+  return VQMergeRunsStatic(runs, run_lengths, num_runs, out, SortDescending());
+#else
+  (void)runs;
+  (void)run_lengths;
+  (void)num_runs;
+  (void)out;
+  HWY_ASSERT(0);
+#endif
+}
+
+void SortSegmentsF16Desc(float16_t* HWY_RESTRICT keys,
+                         const size_t* HWY_RESTRICT offsets,
+                         size_t num_segments) {
+#if HWY_HAVE_FLOAT16
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortDescending());
+#else
+  (void)keys;
+  (void)offsets;
+  (void)num_segments;
+  HWY_ASSERT(0);
+#endif
+}
+
+void ParallelSortSegmentsF16Desc(float16_t* HWY_RESTRICT keys,
+                                 const size_t* HWY_RESTRICT offsets,
+                                 size_t num_segments, ThreadPool& pool) {
+#if HWY_HAVE_FLOAT16
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortDescending(),
+                              pool);
+#else
+  (void)keys;
+  (void)offsets;
+  (void)num_segments;
+  (void)pool;
+  HWY_ASSERT(0);
+#endif
+}
+
+void SortF16DescFloatOrder(float16_t* HWY_RESTRICT keys, size_t num,
+                           FloatOrder float_order) {
+  return VQSortStatic(keys, num, SortDescending(), float_order);
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
@@ -45,11 +143,64 @@ HWY_AFTER_NAMESPACE();
 namespace hwy {
 namespace {
 HWY_EXPORT(SortF16Desc);
+HWY_EXPORT(ParallelSortF16Desc);
+HWY_EXPORT(PartialSortF16Desc);
+HWY_EXPORT(SelectF16Desc);
+HWY_EXPORT(MergeF16Desc);
+HWY_EXPORT(MergeRunsF16Desc);
+HWY_EXPORT(SortSegmentsF16Desc);
+HWY_EXPORT(ParallelSortSegmentsF16Desc);
+HWY_EXPORT(SortF16DescFloatOrder);
 }  // namespace
 
 void VQSort(float16_t* HWY_RESTRICT keys, size_t n, SortDescending) {
   HWY_DYNAMIC_DISPATCH(SortF16Desc)(keys, n);
 }
 
+void VQSort(float16_t* HWY_RESTRICT keys, size_t n, SortDescending,
+            ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortF16Desc)(keys, n, pool);
+}
+
+void VQPartialSort(float16_t* HWY_RESTRICT keys, size_t n, size_t k,
+                   SortDescending) {
+  HWY_DYNAMIC_DISPATCH(PartialSortF16Desc)(keys, n, k);
+}
+
+void VQSelect(float16_t* HWY_RESTRICT keys, size_t n, size_t k,
+              SortDescending) {
+  HWY_DYNAMIC_DISPATCH(SelectF16Desc)(keys, n, k);
+}
+
+void VQMerge(const float16_t* HWY_RESTRICT a, size_t num_a,
+             const float16_t* HWY_RESTRICT b, size_t num_b,
+             float16_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeF16Desc)(a, num_a, b, num_b, out);
+}
+
+void VQMergeRuns(const float16_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+                 const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+                 float16_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeRunsF16Desc)(runs, run_lengths, num_runs, out);
+}
+
+void VQSortSegments(float16_t* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortDescending) {
+  HWY_DYNAMIC_DISPATCH(SortSegmentsF16Desc)(keys, offsets, num_segments);
+}
+
+void VQSortSegments(float16_t* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortDescending, ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortSegmentsF16Desc)(keys, offsets,
+                                                    num_segments, pool);
+}
+
+void VQSort(float16_t* HWY_RESTRICT keys, size_t n, SortDescending,
+            FloatOrder float_order) {
+  HWY_DYNAMIC_DISPATCH(SortF16DescFloatOrder)(keys, n, float_order);
+}
+
 }  // namespace hwy
 #endif  // HWY_ONCE
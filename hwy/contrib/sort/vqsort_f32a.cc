@@ -21,6 +21,8 @@
 
 // After foreach_target
 #include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/contrib/sort/vqsort_merge-inl.h"
+#include "hwy/contrib/sort/vqsort_parallel-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace hwy {
@@ -30,6 +32,49 @@ void SortF32Asc(float* HWY_RESTRICT keys, size_t num) {
   return VQSortStatic(keys, num, SortAscending());
 }
 
+void ParallelSortF32Asc(float* HWY_RESTRICT keys, size_t num,
+                        ThreadPool& pool) {
+  return VQSortStatic(keys, num, SortAscending(), pool);
+}
+
+void PartialSortF32Asc(float* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQPartialSortStatic(keys, num, k, SortAscending());
+}
+
+void SelectF32Asc(float* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQSelectStatic(keys, num, k, SortAscending());
+}
+
+void MergeF32Asc(const float* HWY_RESTRICT a, size_t num_a,
+                 const float* HWY_RESTRICT b, size_t num_b,
+                 float* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+}
+
+void MergeRunsF32Asc(const float* HWY_RESTRICT const* HWY_RESTRICT runs,
+                     const size_t* HWY_RESTRICT run_lengths,
+                     size_t num_runs, float* HWY_RESTRICT out) {
+  return VQMergeRunsStatic(runs, run_lengths, num_runs, out, SortAscending());
+}
+
+void SortSegmentsF32Asc(float* HWY_RESTRICT keys,
+                        const size_t* HWY_RESTRICT offsets,
+                        size_t num_segments) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortAscending());
+}
+
+void ParallelSortSegmentsF32Asc(float* HWY_RESTRICT keys,
+                                const size_t* HWY_RESTRICT offsets,
+                                size_t num_segments, ThreadPool& pool) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortAscending(),
+                              pool);
+}
+
+void SortF32AscFloatOrder(float* HWY_RESTRICT keys, size_t num,
+                          FloatOrder float_order) {
+  return VQSortStatic(keys, num, SortAscending(), float_order);
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
@@ -39,11 +84,63 @@ HWY_AFTER_NAMESPACE();
 namespace hwy {
 namespace {
 HWY_EXPORT(SortF32Asc);
+HWY_EXPORT(ParallelSortF32Asc);
+HWY_EXPORT(PartialSortF32Asc);
+HWY_EXPORT(SelectF32Asc);
+HWY_EXPORT(MergeF32Asc);
+HWY_EXPORT(MergeRunsF32Asc);
+HWY_EXPORT(SortSegmentsF32Asc);
+HWY_EXPORT(ParallelSortSegmentsF32Asc);
+HWY_EXPORT(SortF32AscFloatOrder);
 }  // namespace
 
 void VQSort(float* HWY_RESTRICT keys, size_t n, SortAscending) {
   HWY_DYNAMIC_DISPATCH(SortF32Asc)(keys, n);
 }
 
+void VQSort(float* HWY_RESTRICT keys, size_t n, SortAscending,
+            ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortF32Asc)(keys, n, pool);
+}
+
+void VQPartialSort(float* HWY_RESTRICT keys, size_t n, size_t k,
+                   SortAscending) {
+  HWY_DYNAMIC_DISPATCH(PartialSortF32Asc)(keys, n, k);
+}
+
+void VQSelect(float* HWY_RESTRICT keys, size_t n, size_t k, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(SelectF32Asc)(keys, n, k);
+}
+
+void VQMerge(const float* HWY_RESTRICT a, size_t num_a,
+             const float* HWY_RESTRICT b, size_t num_b,
+             float* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeF32Asc)(a, num_a, b, num_b, out);
+}
+
+void VQMergeRuns(const float* HWY_RESTRICT const* HWY_RESTRICT runs,
+                 const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+                 float* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeRunsF32Asc)(runs, run_lengths, num_runs, out);
+}
+
+void VQSortSegments(float* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortAscending) {
+  HWY_DYNAMIC_DISPATCH(SortSegmentsF32Asc)(keys, offsets, num_segments);
+}
+
+void VQSortSegments(float* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortAscending, ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortSegmentsF32Asc)(keys, offsets,
+                                                   num_segments, pool);
+}
+
+void VQSort(float* HWY_RESTRICT keys, size_t n, SortAscending,
+            FloatOrder float_order) {
+  HWY_DYNAMIC_DISPATCH(SortF32AscFloatOrder)(keys, n, float_order);
+}
+
 }  // namespace hwy
 #endif  // HWY_ONCE
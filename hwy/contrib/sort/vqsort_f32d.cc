@@ -22,6 +22,8 @@
 // After foreach_target
 #include "hwy/contrib/sort/traits-inl.h"
 #include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/contrib/sort/vqsort_merge-inl.h"
+#include "hwy/contrib/sort/vqsort_parallel-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace hwy {
@@ -31,6 +33,49 @@ void SortF32Desc(float* HWY_RESTRICT keys, size_t num) {
   return VQSortStatic(keys, num, SortDescending());
 }
 
+void ParallelSortF32Desc(float* HWY_RESTRICT keys, size_t num,
+                         ThreadPool& pool) {
+  return VQSortStatic(keys, num, SortDescending(), pool);
+}
+
+void PartialSortF32Desc(float* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQPartialSortStatic(keys, num, k, SortDescending());
+}
+
+void SelectF32Desc(float* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQSelectStatic(keys, num, k, SortDescending());
+}
+
+void MergeF32Desc(const float* HWY_RESTRICT a, size_t num_a,
+                  const float* HWY_RESTRICT b, size_t num_b,
+                  float* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+}
+
+void MergeRunsF32Desc(const float* HWY_RESTRICT const* HWY_RESTRICT runs,
+                      const size_t* HWY_RESTRICT run_lengths,
+                      size_t num_runs, float* HWY_RESTRICT out) {
+  return VQMergeRunsStatic(runs, run_lengths, num_runs, out, SortDescending());
+}
+
+void SortSegmentsF32Desc(float* HWY_RESTRICT keys,
+                         const size_t* HWY_RESTRICT offsets,
+                         size_t num_segments) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortDescending());
+}
+
+void ParallelSortSegmentsF32Desc(float* HWY_RESTRICT keys,
+                                 const size_t* HWY_RESTRICT offsets,
+                                 size_t num_segments, ThreadPool& pool) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortDescending(),
+                              pool);
+}
+
+void SortF32DescFloatOrder(float* HWY_RESTRICT keys, size_t num,
+                           FloatOrder float_order) {
+  return VQSortStatic(keys, num, SortDescending(), float_order);
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
@@ -40,11 +85,63 @@ HWY_AFTER_NAMESPACE();
 namespace hwy {
 namespace {
 HWY_EXPORT(SortF32Desc);
+HWY_EXPORT(ParallelSortF32Desc);
+HWY_EXPORT(PartialSortF32Desc);
+HWY_EXPORT(SelectF32Desc);
+HWY_EXPORT(MergeF32Desc);
+HWY_EXPORT(MergeRunsF32Desc);
+HWY_EXPORT(SortSegmentsF32Desc);
+HWY_EXPORT(ParallelSortSegmentsF32Desc);
+HWY_EXPORT(SortF32DescFloatOrder);
 }  // namespace
 
 void VQSort(float* HWY_RESTRICT keys, size_t n, SortDescending) {
   HWY_DYNAMIC_DISPATCH(SortF32Desc)(keys, n);
 }
 
+void VQSort(float* HWY_RESTRICT keys, size_t n, SortDescending,
+            ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortF32Desc)(keys, n, pool);
+}
+
+void VQPartialSort(float* HWY_RESTRICT keys, size_t n, size_t k,
+                   SortDescending) {
+  HWY_DYNAMIC_DISPATCH(PartialSortF32Desc)(keys, n, k);
+}
+
+void VQSelect(float* HWY_RESTRICT keys, size_t n, size_t k, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(SelectF32Desc)(keys, n, k);
+}
+
+void VQMerge(const float* HWY_RESTRICT a, size_t num_a,
+             const float* HWY_RESTRICT b, size_t num_b,
+             float* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeF32Desc)(a, num_a, b, num_b, out);
+}
+
+void VQMergeRuns(const float* HWY_RESTRICT const* HWY_RESTRICT runs,
+                 const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+                 float* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeRunsF32Desc)(runs, run_lengths, num_runs, out);
+}
+
+void VQSortSegments(float* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortDescending) {
+  HWY_DYNAMIC_DISPATCH(SortSegmentsF32Desc)(keys, offsets, num_segments);
+}
+
+void VQSortSegments(float* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortDescending, ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortSegmentsF32Desc)(keys, offsets,
+                                                    num_segments, pool);
+}
+
+void VQSort(float* HWY_RESTRICT keys, size_t n, SortDescending,
+            FloatOrder float_order) {
+  HWY_DYNAMIC_DISPATCH(SortF32DescFloatOrder)(keys, n, float_order);
+}
+
 }  // namespace hwy
 #endif  // HWY_ONCE
@@ -21,6 +21,8 @@
 
 // After foreach_target
 #include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/contrib/sort/vqsort_merge-inl.h"
+#include "hwy/contrib/sort/vqsort_parallel-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace hwy {
@@ -36,6 +38,102 @@ void SortF64Asc(double* HWY_RESTRICT keys, size_t num) {
 #endif
 }
 
+void ParallelSortF64Asc(double* HWY_RESTRICT keys, size_t num,
+                        ThreadPool& pool) {
+#if HWY_HAVE_FLOAT64
+  return VQSortStatic(keys, num, SortAscending(), pool);
+#else
+  (void)keys;
+  (void)num;
+  (void)pool;
+  HWY_ASSERT(0);
+#endif
+}
+
+void PartialSortF64Asc(double* HWY_RESTRICT keys, size_t num, size_t k) {
+#if HWY_HAVE_FLOAT64
+  return VQPartialSortStatic(keys, num, k, SortAscending());
+#else
+  (void)keys;
+  (void)num;
+  (void)k;
+  HWY_ASSERT(0);
+#endif
+}
+
+void SelectF64Asc(double* HWY_RESTRICT keys, size_t num, size_t k) {
+#if HWY_HAVE_FLOAT64
+  return VQSelectStatic(keys, num, k, SortAscending());
+#else
+  (void)keys;
+  (void)num;
+  (void)k;
+  HWY_ASSERT(0);
+#endif
+}
+
+void MergeF64Asc(const double* HWY_RESTRICT a, size_t num_a,
+                 const double* HWY_RESTRICT b, size_t num_b,
+                 double* HWY_RESTRICT out) {
+#if HWY_HAVE_FLOAT64
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+#else
+  (void)a;
+  (void)num_a;
+  (void)b;
+  (void)num_b;
+  (void)out;
+  HWY_ASSERT(0);
+#endif
+}
+
+void MergeRunsF64Asc(const double* HWY_RESTRICT const* HWY_RESTRICT runs,
+                     const size_t* HWY_RESTRICT run_lengths,
+                     size_t num_runs, double* HWY_RESTRICT out) {
+#if HWY_HAVE_FLOAT64
+  return VQMergeRunsStatic(runs, run_lengths, num_runs, out, SortAscending());
+#else
+  (void)runs;
+  (void)run_lengths;
+  (void)num_runs;
+  (void)out;
+  HWY_ASSERT(0);
+#endif
+}
+
+void SortSegmentsF64Asc(double* HWY_RESTRICT keys,
+                        const size_t* HWY_RESTRICT offsets,
+                        size_t num_segments) {
+#if HWY_HAVE_FLOAT64
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortAscending());
+#else
+  (void)keys;
+  (void)offsets;
+  (void)num_segments;
+  HWY_ASSERT(0);
+#endif
+}
+
+void ParallelSortSegmentsF64Asc(double* HWY_RESTRICT keys,
+                                const size_t* HWY_RESTRICT offsets,
+                                size_t num_segments, ThreadPool& pool) {
+#if HWY_HAVE_FLOAT64
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortAscending(),
+                              pool);
+#else
+  (void)keys;
+  (void)offsets;
+  (void)num_segments;
+  (void)pool;
+  HWY_ASSERT(0);
+#endif
+}
+
+void SortF64AscFloatOrder(double* HWY_RESTRICT keys, size_t num,
+                          FloatOrder float_order) {
+  return VQSortStatic(keys, num, SortAscending(), float_order);
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
@@ -45,11 +143,63 @@ HWY_AFTER_NAMESPACE();
 namespace hwy {
 namespace {
 HWY_EXPORT(SortF64Asc);
+HWY_EXPORT(ParallelSortF64Asc);
+HWY_EXPORT(PartialSortF64Asc);
+HWY_EXPORT(SelectF64Asc);
+HWY_EXPORT(MergeF64Asc);
+HWY_EXPORT(MergeRunsF64Asc);
+HWY_EXPORT(SortSegmentsF64Asc);
+HWY_EXPORT(ParallelSortSegmentsF64Asc);
+HWY_EXPORT(SortF64AscFloatOrder);
 }  // namespace
 
 void VQSort(double* HWY_RESTRICT keys, size_t n, SortAscending) {
   HWY_DYNAMIC_DISPATCH(SortF64Asc)(keys, n);
 }
 
+void VQSort(double* HWY_RESTRICT keys, size_t n, SortAscending,
+            ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortF64Asc)(keys, n, pool);
+}
+
+void VQPartialSort(double* HWY_RESTRICT keys, size_t n, size_t k,
+                   SortAscending) {
+  HWY_DYNAMIC_DISPATCH(PartialSortF64Asc)(keys, n, k);
+}
+
+void VQSelect(double* HWY_RESTRICT keys, size_t n, size_t k, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(SelectF64Asc)(keys, n, k);
+}
+
+void VQMerge(const double* HWY_RESTRICT a, size_t num_a,
+             const double* HWY_RESTRICT b, size_t num_b,
+             double* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeF64Asc)(a, num_a, b, num_b, out);
+}
+
+void VQMergeRuns(const double* HWY_RESTRICT const* HWY_RESTRICT runs,
+                 const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+                 double* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeRunsF64Asc)(runs, run_lengths, num_runs, out);
+}
+
+void VQSortSegments(double* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortAscending) {
+  HWY_DYNAMIC_DISPATCH(SortSegmentsF64Asc)(keys, offsets, num_segments);
+}
+
+void VQSortSegments(double* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortAscending, ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortSegmentsF64Asc)(keys, offsets,
+                                                   num_segments, pool);
+}
+
+void VQSort(double* HWY_RESTRICT keys, size_t n, SortAscending,
+            FloatOrder float_order) {
+  HWY_DYNAMIC_DISPATCH(SortF64AscFloatOrder)(keys, n, float_order);
+}
+
 }  // namespace hwy
 #endif  // HWY_ONCE
@@ -21,6 +21,8 @@
 
 // After foreach_target
 #include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/contrib/sort/vqsort_merge-inl.h"
+#include "hwy/contrib/sort/vqsort_parallel-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace hwy {
@@ -36,6 +38,102 @@ void SortF64Desc(double* HWY_RESTRICT keys, size_t num) {
 #endif
 }
 
+void ParallelSortF64Desc(double* HWY_RESTRICT keys, size_t num,
+                         ThreadPool& pool) {
+#if HWY_HAVE_FLOAT64
+  return VQSortStatic(keys, num, SortDescending(), pool);
+#else
+  (void)keys;
+  (void)num;
+  (void)pool;
+  HWY_ASSERT(0);
+#endif
+}
+
+void PartialSortF64Desc(double* HWY_RESTRICT keys, size_t num, size_t k) {
+#if HWY_HAVE_FLOAT64
+  return VQPartialSortStatic(keys, num, k, SortDescending());
+#else
+  (void)keys;
+  (void)num;
+  (void)k;
+  HWY_ASSERT(0);
+#endif
+}
+
+void SelectF64Desc(double* HWY_RESTRICT keys, size_t num, size_t k) {
+#if HWY_HAVE_FLOAT64
+  return VQSelectStatic(keys, num, k, SortDescending());
+#else
+  (void)keys;
+  (void)num;
+  (void)k;
+  HWY_ASSERT(0);
+#endif
+}
+
+void MergeF64Desc(const double* HWY_RESTRICT a, size_t num_a,
+                  const double* HWY_RESTRICT b, size_t num_b,
+                  double* HWY_RESTRICT out) {
+#if HWY_HAVE_FLOAT64
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+#else
+  (void)a;
+  (void)num_a;
+  (void)b;
+  (void)num_b;
+  (void)out;
+  HWY_ASSERT(0);
+#endif
+}
+
+void MergeRunsF64Desc(const double* HWY_RESTRICT const* HWY_RESTRICT runs,
+                      const size_t* HWY_RESTRICT run_lengths,
+                      size_t num_runs, double* HWY_RESTRICT out) {
+#if HWY_HAVE_FLOAT64
+  return VQMergeRunsStatic(runs, run_lengths, num_runs, out, SortDescending());
+#else
+  (void)runs;
+  (void)run_lengths;
+  (void)num_runs;
+  (void)out;
+  HWY_ASSERT(0);
+#endif
+}
+
+void SortSegmentsF64Desc(double* HWY_RESTRICT keys,
+                         const size_t* HWY_RESTRICT offsets,
+                         size_t num_segments) {
+#if HWY_HAVE_FLOAT64
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortDescending());
+#else
+  (void)keys;
+  (void)offsets;
+  (void)num_segments;
+  HWY_ASSERT(0);
+#endif
+}
+
+void ParallelSortSegmentsF64Desc(double* HWY_RESTRICT keys,
+                                 const size_t* HWY_RESTRICT offsets,
+                                 size_t num_segments, ThreadPool& pool) {
+#if HWY_HAVE_FLOAT64
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortDescending(),
+                              pool);
+#else
+  (void)keys;
+  (void)offsets;
+  (void)num_segments;
+  (void)pool;
+  HWY_ASSERT(0);
+#endif
+}
+
+void SortF64DescFloatOrder(double* HWY_RESTRICT keys, size_t num,
+                           FloatOrder float_order) {
+  return VQSortStatic(keys, num, SortDescending(), float_order);
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
@@ -45,11 +143,63 @@ HWY_AFTER_NAMESPACE();
 namespace hwy {
 namespace {
 HWY_EXPORT(SortF64Desc);
+HWY_EXPORT(ParallelSortF64Desc);
+HWY_EXPORT(PartialSortF64Desc);
+HWY_EXPORT(SelectF64Desc);
+HWY_EXPORT(MergeF64Desc);
+HWY_EXPORT(MergeRunsF64Desc);
+HWY_EXPORT(SortSegmentsF64Desc);
+HWY_EXPORT(ParallelSortSegmentsF64Desc);
+HWY_EXPORT(SortF64DescFloatOrder);
 }  // namespace
 
 void VQSort(double* HWY_RESTRICT keys, size_t n, SortDescending) {
   HWY_DYNAMIC_DISPATCH(SortF64Desc)(keys, n);
 }
 
+void VQSort(double* HWY_RESTRICT keys, size_t n, SortDescending,
+            ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortF64Desc)(keys, n, pool);
+}
+
+void VQPartialSort(double* HWY_RESTRICT keys, size_t n, size_t k,
+                   SortDescending) {
+  HWY_DYNAMIC_DISPATCH(PartialSortF64Desc)(keys, n, k);
+}
+
+void VQSelect(double* HWY_RESTRICT keys, size_t n, size_t k, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(SelectF64Desc)(keys, n, k);
+}
+
+void VQMerge(const double* HWY_RESTRICT a, size_t num_a,
+             const double* HWY_RESTRICT b, size_t num_b,
+             double* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeF64Desc)(a, num_a, b, num_b, out);
+}
+
+void VQMergeRuns(const double* HWY_RESTRICT const* HWY_RESTRICT runs,
+                 const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+                 double* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeRunsF64Desc)(runs, run_lengths, num_runs, out);
+}
+
+void VQSortSegments(double* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortDescending) {
+  HWY_DYNAMIC_DISPATCH(SortSegmentsF64Desc)(keys, offsets, num_segments);
+}
+
+void VQSortSegments(double* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortDescending, ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortSegmentsF64Desc)(keys, offsets,
+                                                    num_segments, pool);
+}
+
+void VQSort(double* HWY_RESTRICT keys, size_t n, SortDescending,
+            FloatOrder float_order) {
+  HWY_DYNAMIC_DISPATCH(SortF64DescFloatOrder)(keys, n, float_order);
+}
+
 }  // namespace hwy
 #endif  // HWY_ONCE
@@ -21,6 +21,8 @@
 
 // After foreach_target
 #include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/contrib/sort/vqsort_merge-inl.h"
+#include "hwy/contrib/sort/vqsort_parallel-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace hwy {
@@ -30,6 +32,44 @@ void SortI16Asc(int16_t* HWY_RESTRICT keys, size_t num) {
   return VQSortStatic(keys, num, SortAscending());
 }
 
+void ParallelSortI16Asc(int16_t* HWY_RESTRICT keys, size_t num,
+                        ThreadPool& pool) {
+  return VQSortStatic(keys, num, SortAscending(), pool);
+}
+
+void PartialSortI16Asc(int16_t* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQPartialSortStatic(keys, num, k, SortAscending());
+}
+
+void SelectI16Asc(int16_t* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQSelectStatic(keys, num, k, SortAscending());
+}
+
+void MergeI16Asc(const int16_t* HWY_RESTRICT a, size_t num_a,
+                 const int16_t* HWY_RESTRICT b, size_t num_b,
+                 int16_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+}
+
+void MergeRunsI16Asc(const int16_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+                     const size_t* HWY_RESTRICT run_lengths,
+                     size_t num_runs, int16_t* HWY_RESTRICT out) {
+  return VQMergeRunsStatic(runs, run_lengths, num_runs, out, SortAscending());
+}
+
+void SortSegmentsI16Asc(int16_t* HWY_RESTRICT keys,
+                        const size_t* HWY_RESTRICT offsets,
+                        size_t num_segments) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortAscending());
+}
+
+void ParallelSortSegmentsI16Asc(int16_t* HWY_RESTRICT keys,
+                                const size_t* HWY_RESTRICT offsets,
+                                size_t num_segments, ThreadPool& pool) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortAscending(),
+                              pool);
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
@@ -39,11 +79,57 @@ HWY_AFTER_NAMESPACE();
 namespace hwy {
 namespace {
 HWY_EXPORT(SortI16Asc);
+HWY_EXPORT(ParallelSortI16Asc);
+HWY_EXPORT(PartialSortI16Asc);
+HWY_EXPORT(SelectI16Asc);
+HWY_EXPORT(MergeI16Asc);
+HWY_EXPORT(MergeRunsI16Asc);
+HWY_EXPORT(SortSegmentsI16Asc);
+HWY_EXPORT(ParallelSortSegmentsI16Asc);
 }  // namespace
 
 void VQSort(int16_t* HWY_RESTRICT keys, size_t n, SortAscending) {
   HWY_DYNAMIC_DISPATCH(SortI16Asc)(keys, n);
 }
 
+void VQSort(int16_t* HWY_RESTRICT keys, size_t n, SortAscending,
+            ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortI16Asc)(keys, n, pool);
+}
+
+void VQPartialSort(int16_t* HWY_RESTRICT keys, size_t n, size_t k,
+                   SortAscending) {
+  HWY_DYNAMIC_DISPATCH(PartialSortI16Asc)(keys, n, k);
+}
+
+void VQSelect(int16_t* HWY_RESTRICT keys, size_t n, size_t k, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(SelectI16Asc)(keys, n, k);
+}
+
+void VQMerge(const int16_t* HWY_RESTRICT a, size_t num_a,
+             const int16_t* HWY_RESTRICT b, size_t num_b,
+             int16_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeI16Asc)(a, num_a, b, num_b, out);
+}
+
+void VQMergeRuns(const int16_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+                 const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+                 int16_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeRunsI16Asc)(runs, run_lengths, num_runs, out);
+}
+
+void VQSortSegments(int16_t* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortAscending) {
+  HWY_DYNAMIC_DISPATCH(SortSegmentsI16Asc)(keys, offsets, num_segments);
+}
+
+void VQSortSegments(int16_t* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortAscending, ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortSegmentsI16Asc)(keys, offsets,
+                                                   num_segments, pool);
+}
+
 }  // namespace hwy
 #endif  // HWY_ONCE
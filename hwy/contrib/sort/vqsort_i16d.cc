@@ -21,6 +21,8 @@
 
 // After foreach_target
 #include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/contrib/sort/vqsort_merge-inl.h"
+#include "hwy/contrib/sort/vqsort_parallel-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace hwy {
@@ -30,6 +32,44 @@ void SortI16Desc(int16_t* HWY_RESTRICT keys, size_t num) {
   return VQSortStatic(keys, num, SortDescending());
 }
 
+void ParallelSortI16Desc(int16_t* HWY_RESTRICT keys, size_t num,
+                         ThreadPool& pool) {
+  return VQSortStatic(keys, num, SortDescending(), pool);
+}
+
+void PartialSortI16Desc(int16_t* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQPartialSortStatic(keys, num, k, SortDescending());
+}
+
+void SelectI16Desc(int16_t* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQSelectStatic(keys, num, k, SortDescending());
+}
+
+void MergeI16Desc(const int16_t* HWY_RESTRICT a, size_t num_a,
+                  const int16_t* HWY_RESTRICT b, size_t num_b,
+                  int16_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+}
+
+void MergeRunsI16Desc(const int16_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+                      const size_t* HWY_RESTRICT run_lengths,
+                      size_t num_runs, int16_t* HWY_RESTRICT out) {
+  return VQMergeRunsStatic(runs, run_lengths, num_runs, out, SortDescending());
+}
+
+void SortSegmentsI16Desc(int16_t* HWY_RESTRICT keys,
+                         const size_t* HWY_RESTRICT offsets,
+                         size_t num_segments) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortDescending());
+}
+
+void ParallelSortSegmentsI16Desc(int16_t* HWY_RESTRICT keys,
+                                 const size_t* HWY_RESTRICT offsets,
+                                 size_t num_segments, ThreadPool& pool) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortDescending(),
+                              pool);
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
@@ -39,11 +79,57 @@ HWY_AFTER_NAMESPACE();
 namespace hwy {
 namespace {
 HWY_EXPORT(SortI16Desc);
+HWY_EXPORT(ParallelSortI16Desc);
+HWY_EXPORT(PartialSortI16Desc);
+HWY_EXPORT(SelectI16Desc);
+HWY_EXPORT(MergeI16Desc);
+HWY_EXPORT(MergeRunsI16Desc);
+HWY_EXPORT(SortSegmentsI16Desc);
+HWY_EXPORT(ParallelSortSegmentsI16Desc);
 }  // namespace
 
 void VQSort(int16_t* HWY_RESTRICT keys, size_t n, SortDescending) {
   HWY_DYNAMIC_DISPATCH(SortI16Desc)(keys, n);
 }
 
+void VQSort(int16_t* HWY_RESTRICT keys, size_t n, SortDescending,
+            ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortI16Desc)(keys, n, pool);
+}
+
+void VQPartialSort(int16_t* HWY_RESTRICT keys, size_t n, size_t k,
+                   SortDescending) {
+  HWY_DYNAMIC_DISPATCH(PartialSortI16Desc)(keys, n, k);
+}
+
+void VQSelect(int16_t* HWY_RESTRICT keys, size_t n, size_t k, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(SelectI16Desc)(keys, n, k);
+}
+
+void VQMerge(const int16_t* HWY_RESTRICT a, size_t num_a,
+             const int16_t* HWY_RESTRICT b, size_t num_b,
+             int16_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeI16Desc)(a, num_a, b, num_b, out);
+}
+
+void VQMergeRuns(const int16_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+                 const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+                 int16_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeRunsI16Desc)(runs, run_lengths, num_runs, out);
+}
+
+void VQSortSegments(int16_t* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortDescending) {
+  HWY_DYNAMIC_DISPATCH(SortSegmentsI16Desc)(keys, offsets, num_segments);
+}
+
+void VQSortSegments(int16_t* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortDescending, ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortSegmentsI16Desc)(keys, offsets,
+                                                    num_segments, pool);
+}
+
 }  // namespace hwy
 #endif  // HWY_ONCE
@@ -21,6 +21,8 @@
 
 // After foreach_target
 #include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/contrib/sort/vqsort_merge-inl.h"
+#include "hwy/contrib/sort/vqsort_parallel-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace hwy {
@@ -30,6 +32,44 @@ void SortI32Asc(int32_t* HWY_RESTRICT keys, size_t num) {
   return VQSortStatic(keys, num, SortAscending());
 }
 
+void ParallelSortI32Asc(int32_t* HWY_RESTRICT keys, size_t num,
+                        ThreadPool& pool) {
+  return VQSortStatic(keys, num, SortAscending(), pool);
+}
+
+void PartialSortI32Asc(int32_t* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQPartialSortStatic(keys, num, k, SortAscending());
+}
+
+void SelectI32Asc(int32_t* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQSelectStatic(keys, num, k, SortAscending());
+}
+
+void MergeI32Asc(const int32_t* HWY_RESTRICT a, size_t num_a,
+                 const int32_t* HWY_RESTRICT b, size_t num_b,
+                 int32_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+}
+
+void MergeRunsI32Asc(const int32_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+                     const size_t* HWY_RESTRICT run_lengths,
+                     size_t num_runs, int32_t* HWY_RESTRICT out) {
+  return VQMergeRunsStatic(runs, run_lengths, num_runs, out, SortAscending());
+}
+
+void SortSegmentsI32Asc(int32_t* HWY_RESTRICT keys,
+                        const size_t* HWY_RESTRICT offsets,
+                        size_t num_segments) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortAscending());
+}
+
+void ParallelSortSegmentsI32Asc(int32_t* HWY_RESTRICT keys,
+                                const size_t* HWY_RESTRICT offsets,
+                                size_t num_segments, ThreadPool& pool) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortAscending(),
+                              pool);
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
@@ -39,11 +79,57 @@ HWY_AFTER_NAMESPACE();
 namespace hwy {
 namespace {
 HWY_EXPORT(SortI32Asc);
+HWY_EXPORT(ParallelSortI32Asc);
+HWY_EXPORT(PartialSortI32Asc);
+HWY_EXPORT(SelectI32Asc);
+HWY_EXPORT(MergeI32Asc);
+HWY_EXPORT(MergeRunsI32Asc);
+HWY_EXPORT(SortSegmentsI32Asc);
+HWY_EXPORT(ParallelSortSegmentsI32Asc);
 }  // namespace
 
 void VQSort(int32_t* HWY_RESTRICT keys, size_t n, SortAscending) {
   HWY_DYNAMIC_DISPATCH(SortI32Asc)(keys, n);
 }
 
+void VQSort(int32_t* HWY_RESTRICT keys, size_t n, SortAscending,
+            ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortI32Asc)(keys, n, pool);
+}
+
+void VQPartialSort(int32_t* HWY_RESTRICT keys, size_t n, size_t k,
+                   SortAscending) {
+  HWY_DYNAMIC_DISPATCH(PartialSortI32Asc)(keys, n, k);
+}
+
+void VQSelect(int32_t* HWY_RESTRICT keys, size_t n, size_t k, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(SelectI32Asc)(keys, n, k);
+}
+
+void VQMerge(const int32_t* HWY_RESTRICT a, size_t num_a,
+             const int32_t* HWY_RESTRICT b, size_t num_b,
+             int32_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeI32Asc)(a, num_a, b, num_b, out);
+}
+
+void VQMergeRuns(const int32_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+                 const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+                 int32_t* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeRunsI32Asc)(runs, run_lengths, num_runs, out);
+}
+
+void VQSortSegments(int32_t* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortAscending) {
+  HWY_DYNAMIC_DISPATCH(SortSegmentsI32Asc)(keys, offsets, num_segments);
+}
+
+void VQSortSegments(int32_t* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortAscending, ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortSegmentsI32Asc)(keys, offsets,
+                                                   num_segments, pool);
+}
+
 }  // namespace hwy
 #endif  // HWY_ONCE
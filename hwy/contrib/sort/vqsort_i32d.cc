@@ -21,6 +21,8 @@
 
 // After foreach_target
 #include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/contrib/sort/vqsort_merge-inl.h"
+#include "hwy/contrib/sort/vqsort_parallel-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace hwy {
@@ -30,6 +32,44 @@ void SortI32Desc(int32_t* HWY_RESTRICT keys, size_t num) {
   return VQSortStatic(keys, num, SortDescending());
 }
 
+void ParallelSortI32Desc(int32_t* HWY_RESTRICT keys, size_t num,
+                         ThreadPool& pool) {
+  return VQSortStatic(keys, num, SortDescending(), pool);
+}
+
+void PartialSortI32Desc(int32_t* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQPartialSortStatic(keys, num, k, SortDescending());
+}
+
+void SelectI32Desc(int32_t* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQSelectStatic(keys, num, k, SortDescending());
+}
+
+void MergeI32Desc(const int32_t* HWY_RESTRICT a, size_t num_a,
+                  const int32_t* HWY_RESTRICT b, size_t num_b,
+                  int32_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+}
+
+void MergeRunsI32Desc(const int32_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+                      const size_t* HWY_RESTRICT run_lengths,
+                      size_t num_runs, int32_t* HWY_RESTRICT out) {
+  return VQMergeRunsStatic(runs, run_lengths, num_runs, out, SortDescending());
+}
+
+void SortSegmentsI32Desc(int32_t* HWY_RESTRICT keys,
+                         const size_t* HWY_RESTRICT offsets,
+                         size_t num_segments) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortDescending());
+}
+
+void ParallelSortSegmentsI32Desc(int32_t* HWY_RESTRICT keys,
+                                 const size_t* HWY_RESTRICT offsets,
+                                 size_t num_segments, ThreadPool& pool) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortDescending(),
+                              pool);
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
@@ -39,11 +79,57 @@ HWY_AFTER_NAMESPACE();
 namespace hwy {
 namespace {
 HWY_EXPORT(SortI32Desc);
+HWY_EXPORT(ParallelSortI32Desc);
+HWY_EXPORT(PartialSortI32Desc);
+HWY_EXPORT(SelectI32Desc);
+HWY_EXPORT(MergeI32Desc);
+HWY_EXPORT(MergeRunsI32Desc);
+HWY_EXPORT(SortSegmentsI32Desc);
+HWY_EXPORT(ParallelSortSegmentsI32Desc);
 }  // namespace
 
 void VQSort(int32_t* HWY_RESTRICT keys, size_t n, SortDescending) {
   HWY_DYNAMIC_DISPATCH(SortI32Desc)(keys, n);
 }
 
+void VQSort(int32_t* HWY_RESTRICT keys, size_t n, SortDescending,
+            ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortI32Desc)(keys, n, pool);
+}
+
+void VQPartialSort(int32_t* HWY_RESTRICT keys, size_t n, size_t k,
+                   SortDescending) {
+  HWY_DYNAMIC_DISPATCH(PartialSortI32Desc)(keys, n, k);
+}
+
+void VQSelect(int32_t* HWY_RESTRICT keys, size_t n, size_t k, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(SelectI32Desc)(keys, n, k);
+}
+
+void VQMerge(const int32_t* HWY_RESTRICT a, size_t num_a,
+             const int32_t* HWY_RESTRICT b, size_t num_b,
+             int32_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeI32Desc)(a, num_a, b, num_b, out);
+}
+
+void VQMergeRuns(const int32_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+                 const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+                 int32_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeRunsI32Desc)(runs, run_lengths, num_runs, out);
+}
+
+void VQSortSegments(int32_t* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortDescending) {
+  HWY_DYNAMIC_DISPATCH(SortSegmentsI32Desc)(keys, offsets, num_segments);
+}
+
+void VQSortSegments(int32_t* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortDescending, ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortSegmentsI32Desc)(keys, offsets,
+                                                    num_segments, pool);
+}
+
 }  // namespace hwy
 #endif  // HWY_ONCE
@@ -21,6 +21,8 @@
 
 // After foreach_target
 #include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/contrib/sort/vqsort_merge-inl.h"
+#include "hwy/contrib/sort/vqsort_parallel-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace hwy {
@@ -30,6 +32,44 @@ void SortI64Desc(int64_t* HWY_RESTRICT keys, size_t num) {
   return VQSortStatic(keys, num, SortDescending());
 }
 
+void ParallelSortI64Desc(int64_t* HWY_RESTRICT keys, size_t num,
+                         ThreadPool& pool) {
+  return VQSortStatic(keys, num, SortDescending(), pool);
+}
+
+void PartialSortI64Desc(int64_t* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQPartialSortStatic(keys, num, k, SortDescending());
+}
+
+void SelectI64Desc(int64_t* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQSelectStatic(keys, num, k, SortDescending());
+}
+
+void MergeI64Desc(const int64_t* HWY_RESTRICT a, size_t num_a,
+                  const int64_t* HWY_RESTRICT b, size_t num_b,
+                  int64_t* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+}
+
+void MergeRunsI64Desc(const int64_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+                      const size_t* HWY_RESTRICT run_lengths,
+                      size_t num_runs, int64_t* HWY_RESTRICT out) {
+  return VQMergeRunsStatic(runs, run_lengths, num_runs, out, SortDescending());
+}
+
+void SortSegmentsI64Desc(int64_t* HWY_RESTRICT keys,
+                         const size_t* HWY_RESTRICT offsets,
+                         size_t num_segments) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortDescending());
+}
+
+void ParallelSortSegmentsI64Desc(int64_t* HWY_RESTRICT keys,
+                                 const size_t* HWY_RESTRICT offsets,
+                                 size_t num_segments, ThreadPool& pool) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortDescending(),
+                              pool);
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
@@ -39,11 +79,57 @@ HWY_AFTER_NAMESPACE();
 namespace hwy {
 namespace {
 HWY_EXPORT(SortI64Desc);
+HWY_EXPORT(ParallelSortI64Desc);
+HWY_EXPORT(PartialSortI64Desc);
+HWY_EXPORT(SelectI64Desc);
+HWY_EXPORT(MergeI64Desc);
+HWY_EXPORT(MergeRunsI64Desc);
+HWY_EXPORT(SortSegmentsI64Desc);
+HWY_EXPORT(ParallelSortSegmentsI64Desc);
 }  // namespace
 
 void VQSort(int64_t* HWY_RESTRICT keys, size_t n, SortDescending) {
   HWY_DYNAMIC_DISPATCH(SortI64Desc)(keys, n);
 }
 
+void VQSort(int64_t* HWY_RESTRICT keys, size_t n, SortDescending,
+            ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortI64Desc)(keys, n, pool);
+}
+
+void VQPartialSort(int64_t* HWY_RESTRICT keys, size_t n, size_t k,
+                   SortDescending) {
+  HWY_DYNAMIC_DISPATCH(PartialSortI64Desc)(keys, n, k);
+}
+
+void VQSelect(int64_t* HWY_RESTRICT keys, size_t n, size_t k, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(SelectI64Desc)(keys, n, k);
+}
+
+void VQMerge(const int64_t* HWY_RESTRICT a, size_t num_a,
+             const int64_t* HWY_RESTRICT b, size_t num_b,
+             int64_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeI64Desc)(a, num_a, b, num_b, out);
+}
+
+void VQMergeRuns(const int64_t* HWY_RESTRICT const* HWY_RESTRICT runs,
+                 const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+                 int64_t* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeRunsI64Desc)(runs, run_lengths, num_runs, out);
+}
+
+void VQSortSegments(int64_t* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortDescending) {
+  HWY_DYNAMIC_DISPATCH(SortSegmentsI64Desc)(keys, offsets, num_segments);
+}
+
+void VQSortSegments(int64_t* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortDescending, ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortSegmentsI64Desc)(keys, offsets,
+                                                    num_segments, pool);
+}
+
 }  // namespace hwy
 #endif  // HWY_ONCE
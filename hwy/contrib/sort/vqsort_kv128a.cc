@@ -24,6 +24,8 @@
 
 // After foreach_target
 #include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/contrib/sort/vqsort_merge-inl.h"
+#include "hwy/contrib/sort/vqsort_parallel-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace hwy {
@@ -33,6 +35,44 @@ void SortKV128Asc(K64V64* HWY_RESTRICT keys, size_t num) {
   return VQSortStatic(keys, num, SortAscending());
 }
 
+void ParallelSortKV128Asc(K64V64* HWY_RESTRICT keys, size_t num,
+                          ThreadPool& pool) {
+  return VQSortStatic(keys, num, SortAscending(), pool);
+}
+
+void PartialSortKV128Asc(K64V64* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQPartialSortStatic(keys, num, k, SortAscending());
+}
+
+void SelectKV128Asc(K64V64* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQSelectStatic(keys, num, k, SortAscending());
+}
+
+void MergeKV128Asc(const K64V64* HWY_RESTRICT a, size_t num_a,
+                   const K64V64* HWY_RESTRICT b, size_t num_b,
+                   K64V64* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortAscending());
+}
+
+void MergeRunsKV128Asc(const K64V64* HWY_RESTRICT const* HWY_RESTRICT runs,
+                       const size_t* HWY_RESTRICT run_lengths,
+                       size_t num_runs, K64V64* HWY_RESTRICT out) {
+  return VQMergeRunsStatic(runs, run_lengths, num_runs, out, SortAscending());
+}
+
+void SortSegmentsKV128Asc(K64V64* HWY_RESTRICT keys,
+                          const size_t* HWY_RESTRICT offsets,
+                          size_t num_segments) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortAscending());
+}
+
+void ParallelSortSegmentsKV128Asc(K64V64* HWY_RESTRICT keys,
+                                  const size_t* HWY_RESTRICT offsets,
+                                  size_t num_segments, ThreadPool& pool) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortAscending(),
+                              pool);
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
@@ -42,11 +82,57 @@ HWY_AFTER_NAMESPACE();
 namespace hwy {
 namespace {
 HWY_EXPORT(SortKV128Asc);
+HWY_EXPORT(ParallelSortKV128Asc);
+HWY_EXPORT(PartialSortKV128Asc);
+HWY_EXPORT(SelectKV128Asc);
+HWY_EXPORT(MergeKV128Asc);
+HWY_EXPORT(MergeRunsKV128Asc);
+HWY_EXPORT(SortSegmentsKV128Asc);
+HWY_EXPORT(ParallelSortSegmentsKV128Asc);
 }  // namespace
 
 void VQSort(K64V64* HWY_RESTRICT keys, size_t n, SortAscending) {
   HWY_DYNAMIC_DISPATCH(SortKV128Asc)(keys, n);
 }
 
+void VQSort(K64V64* HWY_RESTRICT keys, size_t n, SortAscending,
+            ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortKV128Asc)(keys, n, pool);
+}
+
+void VQPartialSort(K64V64* HWY_RESTRICT keys, size_t n, size_t k,
+                   SortAscending) {
+  HWY_DYNAMIC_DISPATCH(PartialSortKV128Asc)(keys, n, k);
+}
+
+void VQSelect(K64V64* HWY_RESTRICT keys, size_t n, size_t k, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(SelectKV128Asc)(keys, n, k);
+}
+
+void VQMerge(const K64V64* HWY_RESTRICT a, size_t num_a,
+             const K64V64* HWY_RESTRICT b, size_t num_b,
+             K64V64* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeKV128Asc)(a, num_a, b, num_b, out);
+}
+
+void VQMergeRuns(const K64V64* HWY_RESTRICT const* HWY_RESTRICT runs,
+                 const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+                 K64V64* HWY_RESTRICT out, SortAscending) {
+  HWY_DYNAMIC_DISPATCH(MergeRunsKV128Asc)(runs, run_lengths, num_runs, out);
+}
+
+void VQSortSegments(K64V64* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortAscending) {
+  HWY_DYNAMIC_DISPATCH(SortSegmentsKV128Asc)(keys, offsets, num_segments);
+}
+
+void VQSortSegments(K64V64* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortAscending, ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortSegmentsKV128Asc)(keys, offsets,
+                                                     num_segments, pool);
+}
+
 }  // namespace hwy
 #endif  // HWY_ONCE
@@ -24,6 +24,8 @@
 
 // After foreach_target
 #include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/contrib/sort/vqsort_merge-inl.h"
+#include "hwy/contrib/sort/vqsort_parallel-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace hwy {
@@ -33,6 +35,44 @@ void SortKV128Desc(K64V64* HWY_RESTRICT keys, size_t num) {
   return VQSortStatic(keys, num, SortDescending());
 }
 
+void ParallelSortKV128Desc(K64V64* HWY_RESTRICT keys, size_t num,
+                           ThreadPool& pool) {
+  return VQSortStatic(keys, num, SortDescending(), pool);
+}
+
+void PartialSortKV128Desc(K64V64* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQPartialSortStatic(keys, num, k, SortDescending());
+}
+
+void SelectKV128Desc(K64V64* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQSelectStatic(keys, num, k, SortDescending());
+}
+
+void MergeKV128Desc(const K64V64* HWY_RESTRICT a, size_t num_a,
+                    const K64V64* HWY_RESTRICT b, size_t num_b,
+                    K64V64* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+}
+
+void MergeRunsKV128Desc(const K64V64* HWY_RESTRICT const* HWY_RESTRICT runs,
+                        const size_t* HWY_RESTRICT run_lengths,
+                        size_t num_runs, K64V64* HWY_RESTRICT out) {
+  return VQMergeRunsStatic(runs, run_lengths, num_runs, out, SortDescending());
+}
+
+void SortSegmentsKV128Desc(K64V64* HWY_RESTRICT keys,
+                           const size_t* HWY_RESTRICT offsets,
+                           size_t num_segments) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortDescending());
+}
+
+void ParallelSortSegmentsKV128Desc(K64V64* HWY_RESTRICT keys,
+                                   const size_t* HWY_RESTRICT offsets,
+                                   size_t num_segments, ThreadPool& pool) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortDescending(),
+                              pool);
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
@@ -42,11 +82,57 @@ HWY_AFTER_NAMESPACE();
 namespace hwy {
 namespace {
 HWY_EXPORT(SortKV128Desc);
+HWY_EXPORT(ParallelSortKV128Desc);
+HWY_EXPORT(PartialSortKV128Desc);
+HWY_EXPORT(SelectKV128Desc);
+HWY_EXPORT(MergeKV128Desc);
+HWY_EXPORT(MergeRunsKV128Desc);
+HWY_EXPORT(SortSegmentsKV128Desc);
+HWY_EXPORT(ParallelSortSegmentsKV128Desc);
 }  // namespace
 
 void VQSort(K64V64* HWY_RESTRICT keys, size_t n, SortDescending) {
   HWY_DYNAMIC_DISPATCH(SortKV128Desc)(keys, n);
 }
 
+void VQSort(K64V64* HWY_RESTRICT keys, size_t n, SortDescending,
+            ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortKV128Desc)(keys, n, pool);
+}
+
+void VQPartialSort(K64V64* HWY_RESTRICT keys, size_t n, size_t k,
+                   SortDescending) {
+  HWY_DYNAMIC_DISPATCH(PartialSortKV128Desc)(keys, n, k);
+}
+
+void VQSelect(K64V64* HWY_RESTRICT keys, size_t n, size_t k, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(SelectKV128Desc)(keys, n, k);
+}
+
+void VQMerge(const K64V64* HWY_RESTRICT a, size_t num_a,
+             const K64V64* HWY_RESTRICT b, size_t num_b,
+             K64V64* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeKV128Desc)(a, num_a, b, num_b, out);
+}
+
+void VQMergeRuns(const K64V64* HWY_RESTRICT const* HWY_RESTRICT runs,
+                 const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+                 K64V64* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeRunsKV128Desc)(runs, run_lengths, num_runs, out);
+}
+
+void VQSortSegments(K64V64* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortDescending) {
+  HWY_DYNAMIC_DISPATCH(SortSegmentsKV128Desc)(keys, offsets, num_segments);
+}
+
+void VQSortSegments(K64V64* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortDescending, ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortSegmentsKV128Desc)(keys, offsets,
+                                                      num_segments, pool);
+}
+
 }  // namespace hwy
 #endif  // HWY_ONCE
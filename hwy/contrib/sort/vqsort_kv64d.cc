@@ -24,6 +24,8 @@
 
 // After foreach_target
 #include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/contrib/sort/vqsort_merge-inl.h"
+#include "hwy/contrib/sort/vqsort_parallel-inl.h"
 
 HWY_BEFORE_NAMESPACE();
 namespace hwy {
@@ -33,6 +35,44 @@ void SortKV64Desc(K32V32* HWY_RESTRICT keys, size_t num) {
   return VQSortStatic(keys, num, SortDescending());
 }
 
+void ParallelSortKV64Desc(K32V32* HWY_RESTRICT keys, size_t num,
+                          ThreadPool& pool) {
+  return VQSortStatic(keys, num, SortDescending(), pool);
+}
+
+void PartialSortKV64Desc(K32V32* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQPartialSortStatic(keys, num, k, SortDescending());
+}
+
+void SelectKV64Desc(K32V32* HWY_RESTRICT keys, size_t num, size_t k) {
+  return VQSelectStatic(keys, num, k, SortDescending());
+}
+
+void MergeKV64Desc(const K32V32* HWY_RESTRICT a, size_t num_a,
+                   const K32V32* HWY_RESTRICT b, size_t num_b,
+                   K32V32* HWY_RESTRICT out) {
+  return VQMergeStatic(a, num_a, b, num_b, out, SortDescending());
+}
+
+void MergeRunsKV64Desc(const K32V32* HWY_RESTRICT const* HWY_RESTRICT runs,
+                       const size_t* HWY_RESTRICT run_lengths,
+                       size_t num_runs, K32V32* HWY_RESTRICT out) {
+  return VQMergeRunsStatic(runs, run_lengths, num_runs, out, SortDescending());
+}
+
+void SortSegmentsKV64Desc(K32V32* HWY_RESTRICT keys,
+                          const size_t* HWY_RESTRICT offsets,
+                          size_t num_segments) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortDescending());
+}
+
+void ParallelSortSegmentsKV64Desc(K32V32* HWY_RESTRICT keys,
+                                  const size_t* HWY_RESTRICT offsets,
+                                  size_t num_segments, ThreadPool& pool) {
+  return VQSortSegmentsStatic(keys, offsets, num_segments, SortDescending(),
+                              pool);
+}
+
 // NOLINTNEXTLINE(google-readability-namespace-comments)
 }  // namespace HWY_NAMESPACE
 }  // namespace hwy
@@ -42,11 +82,57 @@ HWY_AFTER_NAMESPACE();
 namespace hwy {
 namespace {
 HWY_EXPORT(SortKV64Desc);
+HWY_EXPORT(ParallelSortKV64Desc);
+HWY_EXPORT(PartialSortKV64Desc);
+HWY_EXPORT(SelectKV64Desc);
+HWY_EXPORT(MergeKV64Desc);
+HWY_EXPORT(MergeRunsKV64Desc);
+HWY_EXPORT(SortSegmentsKV64Desc);
+HWY_EXPORT(ParallelSortSegmentsKV64Desc);
 }  // namespace
 
 void VQSort(K32V32* HWY_RESTRICT keys, size_t n, SortDescending) {
   HWY_DYNAMIC_DISPATCH(SortKV64Desc)(keys, n);
 }
 
+void VQSort(K32V32* HWY_RESTRICT keys, size_t n, SortDescending,
+            ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortKV64Desc)(keys, n, pool);
+}
+
+void VQPartialSort(K32V32* HWY_RESTRICT keys, size_t n, size_t k,
+                   SortDescending) {
+  HWY_DYNAMIC_DISPATCH(PartialSortKV64Desc)(keys, n, k);
+}
+
+void VQSelect(K32V32* HWY_RESTRICT keys, size_t n, size_t k, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(SelectKV64Desc)(keys, n, k);
+}
+
+void VQMerge(const K32V32* HWY_RESTRICT a, size_t num_a,
+             const K32V32* HWY_RESTRICT b, size_t num_b,
+             K32V32* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeKV64Desc)(a, num_a, b, num_b, out);
+}
+
+void VQMergeRuns(const K32V32* HWY_RESTRICT const* HWY_RESTRICT runs,
+                 const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+                 K32V32* HWY_RESTRICT out, SortDescending) {
+  HWY_DYNAMIC_DISPATCH(MergeRunsKV64Desc)(runs, run_lengths, num_runs, out);
+}
+
+void VQSortSegments(K32V32* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortDescending) {
+  HWY_DYNAMIC_DISPATCH(SortSegmentsKV64Desc)(keys, offsets, num_segments);
+}
+
+void VQSortSegments(K32V32* HWY_RESTRICT keys,
+                    const size_t* HWY_RESTRICT offsets, size_t num_segments,
+                    SortDescending, ThreadPool& pool) {
+  HWY_DYNAMIC_DISPATCH(ParallelSortSegmentsKV64Desc)(keys, offsets,
+                                                     num_segments, pool);
+}
+
 }  // namespace hwy
 #endif  // HWY_ONCE
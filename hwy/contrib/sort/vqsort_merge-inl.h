@@ -0,0 +1,390 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Merging of sorted runs: a vectorized 2-way merge based on a bitonic merge
+// network, and a k-way merge built from a tree of 2-way merges.
+
+// Normal include guard for target-independent parts
+#ifndef HIGHWAY_HWY_CONTRIB_SORT_VQSORT_MERGE_INL_H_
+#define HIGHWAY_HWY_CONTRIB_SORT_VQSORT_MERGE_INL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_VQSORT_MERGE_INL_H_
+
+// Per-target
+#if defined(HIGHWAY_HWY_CONTRIB_SORT_VQSORT_MERGE_TOGGLE) == \
+    defined(HWY_TARGET_TOGGLE)
+#ifdef HIGHWAY_HWY_CONTRIB_SORT_VQSORT_MERGE_TOGGLE
+#undef HIGHWAY_HWY_CONTRIB_SORT_VQSORT_MERGE_TOGGLE
+#else
+#define HIGHWAY_HWY_CONTRIB_SORT_VQSORT_MERGE_TOGGLE
+#endif
+
+#include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace detail {
+
+#if VQSORT_ENABLED || HWY_IDE
+
+// ------------------------------ Merge network
+
+// Conditionally swaps the lower and upper half of the vector, i.e. keys at
+// distance kKeys / 2.
+template <class D, class Traits, class V = Vec<D>>
+HWY_INLINE V SortPairsHalves(D d, Traits st, V v) {
+  V swapped = ConcatLowerUpper(d, v, v);
+  st.Sort2(d, v, swapped);
+  return ConcatUpperLower(d, swapped, v);
+}
+
+// Sorts a bitonic sequence of kKeys keys via half-cleaners of decreasing
+// distance. 128-bit keys are limited to four per (512-bit) vector, hence only
+// lane keys use SortPairsDistance2.
+template <class D, class Traits, class V = Vec<D>>
+HWY_INLINE V SortBitonic(D d, Traits st, V v, hwy::SizeTag<2> /* keys */) {
+  return st.SortPairsDistance1(d, v);
+}
+
+template <class D, class Traits, class V = Vec<D>>
+HWY_INLINE V SortBitonic(D d, Traits st, V v, hwy::SizeTag<4> /* keys */) {
+  v = SortPairsHalves(d, st, v);
+  return st.SortPairsDistance1(d, v);
+}
+
+template <class D, class Traits, class V = Vec<D>>
+HWY_INLINE V SortBitonic(D d, Traits st, V v, hwy::SizeTag<8> /* keys */) {
+  v = SortPairsHalves(d, st, v);
+  v = st.SortPairsDistance2(d, v);
+  return st.SortPairsDistance1(d, v);
+}
+
+// Merges the keys of the sorted vectors `a` and `b`: afterwards, `a` holds the
+// first kKeys in sort order, sorted, and `b` the remaining ones, also sorted.
+//
+// As in BaseCase, key-value pairs with equal keys are not equivalent here:
+// `TraitsKV` compares only keys, and its Sort2 would then duplicate one of the
+// pairs. We instead compare all bits. This is a refinement of the key order,
+// so the result is still sorted by key (0-1 principle) even though the inputs
+// are not sorted by all bits.
+template <size_t kKeys, class D, class TraitsKV, class V = Vec<D>>
+HWY_INLINE void MergeVectors(D d, TraitsKV, V& a, V& b) {
+  using Traits = typename TraitsKV::SharedTraitsForSortingNetwork;
+  Traits st;
+  // Reversing `b` turns a||b into a bitonic sequence, whose first and second
+  // halves after Sort2 are both bitonic.
+  b = st.ReverseKeys(d, b);
+  st.Sort2(d, a, b);
+  a = SortBitonic(d, st, a, hwy::SizeTag<kKeys>());
+  b = SortBitonic(d, st, b, hwy::SizeTag<kKeys>());
+}
+
+// ------------------------------ MergeTwo
+
+// Merges sorted `a` and `b` (of `num_a` and `num_b` lanes) into `out`, one key
+// at a time. Returns the number of lanes written.
+template <class Traits, typename T>
+HWY_INLINE size_t MergeScalar(Traits st, const T* HWY_RESTRICT a, size_t num_a,
+                              const T* HWY_RESTRICT b, size_t num_b,
+                              T* HWY_RESTRICT out) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  const size_t num = num_a + num_b;
+  while (num_a != 0 && num_b != 0) {
+    // Prefer `a` for equivalent keys.
+    if (st.Compare1(b, a)) {
+      CopyBytes<kLPK * sizeof(T)>(b, out);
+      b += kLPK;
+      num_b -= kLPK;
+    } else {
+      CopyBytes<kLPK * sizeof(T)>(a, out);
+      a += kLPK;
+      num_a -= kLPK;
+    }
+    out += kLPK;
+  }
+  CopyBytes(a, out, num_a * sizeof(T));
+  CopyBytes(b, out + num_a, num_b * sizeof(T));
+  return num;
+}
+
+// Vectorized merge with kKeys per vector, which must match Lanes(d).
+template <size_t kKeys, class Traits, typename T>
+HWY_NOINLINE void MergeTwo(Traits st, const T* a, size_t num_a, const T* b,
+                           size_t num_b, T* HWY_RESTRICT out) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  constexpr size_t kLanes = kKeys * kLPK;
+  const CappedTag<T, kLanes> d;
+  using V = Vec<decltype(d)>;
+  HWY_DASSERT(Lanes(d) == kLanes);
+
+  // When an input has less than one vector left, it is merged with the
+  // in-flight keys into its own `pending` buffer, which then replaces that
+  // input. Each input requires a separate buffer because the other input may
+  // still be reading from its own.
+  HWY_ALIGN T pending_a[2 * kLanes];
+  HWY_ALIGN T pending_b[2 * kLanes];
+  HWY_ALIGN T tmp[2 * kLanes];
+
+  while (num_a >= kLanes && num_b >= kLanes) {
+    V va = LoadU(d, a);
+    V vb = LoadU(d, b);
+    a += kLanes;
+    b += kLanes;
+    num_a -= kLanes;
+    num_b -= kLanes;
+
+    for (;;) {
+      MergeVectors<kKeys>(d, st, va, vb);
+      StoreU(va, d, out);
+      out += kLanes;
+
+      // No key in `vb` is before any already written. The next vector comes
+      // from the input whose next key is first in sort order, so the keys in
+      // `va` after merging it with `vb` are the next in sort order.
+      const bool take_a = num_b == 0 || (num_a != 0 && !st.Compare1(b, a));
+      const T*& next = take_a ? a : b;
+      size_t& num_next = take_a ? num_a : num_b;
+      if (HWY_UNLIKELY(num_next < kLanes)) {
+        T* HWY_RESTRICT pending = take_a ? pending_a : pending_b;
+        // `next` may point into `pending`, hence copy to `tmp` first.
+        Store(vb, d, tmp);
+        CopyBytes(next, tmp + kLanes, num_next * sizeof(T));
+        num_next =
+            MergeScalar(st, tmp, kLanes, tmp + kLanes, num_next, pending);
+        next = pending;
+        break;
+      }
+      va = LoadU(d, next);
+      next += kLanes;
+      num_next -= kLanes;
+    }
+  }
+
+  MergeScalar(st, a, num_a, b, num_b, out);
+}
+
+// Uses the largest supported number of keys per vector not exceeding kKeys.
+template <class Traits, typename T>
+HWY_INLINE void MergeWithKeys(hwy::SizeTag<1> /* keys */, Traits st,
+                              const T* HWY_RESTRICT a, size_t num_a,
+                              const T* HWY_RESTRICT b, size_t num_b,
+                              T* HWY_RESTRICT out) {
+  MergeScalar(st, a, num_a, b, num_b, out);
+}
+
+template <size_t kKeys, class Traits, typename T>
+HWY_INLINE void MergeWithKeys(hwy::SizeTag<kKeys> /* keys */, Traits st,
+                              const T* HWY_RESTRICT a, size_t num_a,
+                              const T* HWY_RESTRICT b, size_t num_b,
+                              T* HWY_RESTRICT out) {
+  constexpr size_t kLanes = kKeys * st.LanesPerKey();
+  // Scalable vectors may be shorter than the compile-time bound.
+  if (Lanes(CappedTag<T, kLanes>()) == kLanes) {
+    return MergeTwo<kKeys>(st, a, num_a, b, num_b, out);
+  }
+  MergeWithKeys(hwy::SizeTag<kKeys / 2>(), st, a, num_a, b, num_b, out);
+}
+
+// For floating-point keys, sorted inputs end with NaN, which are excluded
+// from the comparisons and instead appended to the output.
+template <typename T, HWY_IF_FLOAT(T)>
+HWY_INLINE size_t CountTrailingNaN(const T* HWY_RESTRICT keys, size_t num) {
+  size_t num_nan = 0;
+  while (num_nan < num && ScalarIsNaN(keys[num - 1 - num_nan])) ++num_nan;
+  return num_nan;
+}
+
+template <typename T, HWY_IF_NOT_FLOAT(T)>
+HWY_INLINE size_t CountTrailingNaN(const T* HWY_RESTRICT, size_t) {
+  return 0;
+}
+
+// Inputs and output are in lanes. `out` must not overlap the inputs.
+template <class Traits, typename T>
+void Merge(Traits st, const T* HWY_RESTRICT a, size_t num_a,
+           const T* HWY_RESTRICT b, size_t num_b, T* HWY_RESTRICT out) {
+  const size_t nan_a = CountTrailingNaN(a, num_a);
+  const size_t nan_b = CountTrailingNaN(b, num_b);
+  num_a -= nan_a;
+  num_b -= nan_b;
+
+  // The networks assume no more than 512-bit vectors, in which 128-bit keys
+  // only fit four times. Eight keys require fewer merge steps per key than
+  // 16, and the smaller vectors also reduce the cost of the tail.
+  constexpr size_t kMaxKeys = st.Is128() ? 4 : 8;
+  constexpr size_t kKeys =
+      HWY_MIN(kMaxKeys, HWY_LANES(T) / st.LanesPerKey());
+  MergeWithKeys(hwy::SizeTag<HWY_MAX(kKeys, size_t{1})>(), st, a, num_a, b,
+                num_b, out);
+
+  out += num_a + num_b;
+  CopyBytes(a + num_a, out, nan_a * sizeof(T));
+  CopyBytes(b + num_b, out + nan_a, nan_b * sizeof(T));
+}
+
+// ------------------------------ MergeRuns
+
+// Merges sorted `runs[i]` of `run_lanes[i]` lanes into `out` via a tree of
+// 2-way merges, alternating between `out` and a temporary buffer such that the
+// final merge writes to `out`.
+template <class Traits, typename T>
+void MergeRuns(Traits st, const T* HWY_RESTRICT const* HWY_RESTRICT runs,
+               const size_t* HWY_RESTRICT run_lanes, size_t num_runs,
+               T* HWY_RESTRICT out) {
+  if (num_runs == 0) return;
+  size_t num = 0;
+  for (size_t i = 0; i < num_runs; ++i) {
+    num += run_lanes[i];
+  }
+  if (num_runs == 1) {
+    CopyBytes(runs[0], out, num * sizeof(T));
+    return;
+  }
+
+  size_t num_levels = 0;
+  for (size_t remaining = num_runs; remaining > 1;
+       remaining = (remaining + 1) / 2) {
+    ++num_levels;
+  }
+
+  AlignedFreeUniquePtr<T[]> buf;
+  if (num_levels > 1) {
+    buf = hwy::AllocateAligned<T>(num);
+    HWY_ASSERT(buf);
+  }
+  // Odd levels (counting backwards from the last) write to `out`.
+  T* dst = (num_levels & 1) ? out : buf.get();
+  T* other = (num_levels & 1) ? buf.get() : out;
+
+  // First level: merge pairs of input runs, recording where the results are.
+  std::vector<size_t> begin;
+  begin.reserve(num_runs / 2 + 2);
+  size_t pos = 0;
+  for (size_t i = 0; i < num_runs; i += 2) {
+    begin.push_back(pos);
+    if (i + 1 == num_runs) {
+      CopyBytes(runs[i], dst + pos, run_lanes[i] * sizeof(T));
+      pos += run_lanes[i];
+    } else {
+      Merge(st, runs[i], run_lanes[i], runs[i + 1], run_lanes[i + 1],
+            dst + pos);
+      pos += run_lanes[i] + run_lanes[i + 1];
+    }
+  }
+  begin.push_back(pos);
+
+  // Subsequent levels: runs are contiguous, bounded by `begin`.
+  while (begin.size() > 2) {
+    std::swap(dst, other);
+    const size_t num_current = begin.size() - 1;
+    size_t num_next = 0;
+    for (size_t i = 0; i < num_current; i += 2) {
+      const size_t lo = begin[i];
+      begin[num_next++] = lo;
+      if (i + 1 == num_current) {
+        CopyBytes(other + lo, dst + lo, (begin[i + 1] - lo) * sizeof(T));
+      } else {
+        const size_t mid = begin[i + 1];
+        Merge(st, other + lo, mid - lo, other + mid, begin[i + 2] - mid,
+              dst + lo);
+      }
+    }
+    begin[num_next] = num;
+    begin.resize(num_next + 1);
+  }
+  HWY_DASSERT(dst == out);
+}
+
+#endif  // VQSORT_ENABLED
+
+}  // namespace detail
+
+// Simpler interface matching VQMerge(), but without dynamic dispatch. Merges
+// the sorted `a[0, num_a)` and `b[0, num_b)` into `out`, which must not
+// overlap them. Supports the same key types as VQSortStatic.
+template <typename T, class Order>
+void VQMergeStatic(const T* HWY_RESTRICT a, size_t num_a,
+                   const T* HWY_RESTRICT b, size_t num_b, T* HWY_RESTRICT out,
+                   Order /* order */) {
+#if VQSORT_ENABLED
+  using Adapter = detail::KeyAdapter<T>;
+  using AdapterOrder =
+      hwy::If<Order().IsAscending(), typename Adapter::Ascending,
+              typename Adapter::Descending>;
+  const detail::SharedTraits<typename Adapter::template Traits<AdapterOrder>>
+      st;
+  using LaneType = typename decltype(st)::LaneType;
+  detail::Merge(st, reinterpret_cast<const LaneType*>(a),
+                num_a * st.LanesPerKey(), reinterpret_cast<const LaneType*>(b),
+                num_b * st.LanesPerKey(), reinterpret_cast<LaneType*>(out));
+#else
+  (void)a;
+  (void)num_a;
+  (void)b;
+  (void)num_b;
+  (void)out;
+  HWY_ASSERT(0);
+#endif  // VQSORT_ENABLED
+}
+
+// Simpler interface matching VQMergeRuns(), but without dynamic dispatch.
+// Merges the sorted `runs[i]` of `run_lengths[i]` keys, for i < num_runs, into
+// `out`, which must not overlap them. Allocates a buffer of the same size as
+// the output if there are more than two runs.
+template <typename T, class Order>
+void VQMergeRunsStatic(const T* HWY_RESTRICT const* HWY_RESTRICT runs,
+                       const size_t* HWY_RESTRICT run_lengths, size_t num_runs,
+                       T* HWY_RESTRICT out, Order /* order */) {
+#if VQSORT_ENABLED
+  using Adapter = detail::KeyAdapter<T>;
+  using AdapterOrder =
+      hwy::If<Order().IsAscending(), typename Adapter::Ascending,
+              typename Adapter::Descending>;
+  const detail::SharedTraits<typename Adapter::template Traits<AdapterOrder>>
+      st;
+  using LaneType = typename decltype(st)::LaneType;
+  std::vector<const LaneType*> lane_runs(num_runs);
+  std::vector<size_t> run_lanes(num_runs);
+  for (size_t i = 0; i < num_runs; ++i) {
+    lane_runs[i] = reinterpret_cast<const LaneType*>(runs[i]);
+    run_lanes[i] = run_lengths[i] * st.LanesPerKey();
+  }
+  detail::MergeRuns(st, lane_runs.data(), run_lanes.data(), num_runs,
+                    reinterpret_cast<LaneType*>(out));
+#else
+  (void)runs;
+  (void)run_lengths;
+  (void)num_runs;
+  (void)out;
+  HWY_ASSERT(0);
+#endif  // VQSORT_ENABLED
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_VQSORT_MERGE_TOGGLE
@@ -0,0 +1,411 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Multi-threaded sort: partitions the top levels of the VQSort recursion using
+// all workers of a ThreadPool, then sorts the resulting disjoint subarrays
+// in parallel via the usual (single-threaded) recursion.
+
+// Normal include guard for target-independent parts
+#ifndef HIGHWAY_HWY_CONTRIB_SORT_VQSORT_PARALLEL_INL_H_
+#define HIGHWAY_HWY_CONTRIB_SORT_VQSORT_PARALLEL_INL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>  // std::lower_bound, std::sort, std::swap_ranges
+#include <vector>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_VQSORT_PARALLEL_INL_H_
+
+// Per-target
+#if defined(HIGHWAY_HWY_CONTRIB_SORT_VQSORT_PARALLEL_TOGGLE) == \
+    defined(HWY_TARGET_TOGGLE)
+#ifdef HIGHWAY_HWY_CONTRIB_SORT_VQSORT_PARALLEL_TOGGLE
+#undef HIGHWAY_HWY_CONTRIB_SORT_VQSORT_PARALLEL_TOGGLE
+#else
+#define HIGHWAY_HWY_CONTRIB_SORT_VQSORT_PARALLEL_TOGGLE
+#endif
+
+#include "hwy/contrib/sort/vqsort-inl.h"
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+namespace detail {
+
+#if VQSORT_ENABLED || HWY_IDE
+
+// Subarrays with fewer lanes are not split across workers: the fork-join
+// overhead would exceed the gains.
+constexpr size_t kMinParallelLanes = 32 * 1024;
+
+// Subarray of lanes [begin, begin + num).
+struct SortRange {
+  size_t begin;
+  size_t num;
+};
+
+// Calls `pool.Run(begin, end, func)`. If VQSORT_STATS, also adds the SortStats
+// that tasks recorded on the worker threads to those of the calling thread,
+// which would otherwise not include them because they are thread-local.
+template <class Func>
+void RunAndGatherStats(ThreadPool& pool, uint64_t begin, uint64_t end,
+                       const Func& func) {
+#if VQSORT_STATS
+  PerWorker<SortStats> worker_stats(pool.NumWorkers(), SortStats());
+  pool.Run(begin, end, [&](uint64_t task, size_t thread) {
+    // The main thread is also a worker, hence set aside its prior counters.
+    SortStats& stats = Stats();
+    const SortStats prev = stats;
+    stats = SortStats();
+    func(task, thread);
+    worker_stats[thread].Add(stats);
+    stats = prev;
+  });
+  for (size_t worker = 0; worker < worker_stats.NumWorkers(); ++worker) {
+    Stats().Add(worker_stats[worker]);
+  }
+#else
+  pool.Run(begin, end, func);
+#endif
+}
+
+// Returns the first lane of chunk `i` of `num_chunks` within `num` lanes,
+// rounded down to a whole key.
+HWY_INLINE size_t ChunkBegin(size_t i, size_t num_chunks, size_t num,
+                             size_t lanes_per_key) {
+  const size_t begin = static_cast<size_t>(
+      static_cast<uint64_t>(num) * i / static_cast<uint64_t>(num_chunks));
+  return begin & ~(lanes_per_key - 1);
+}
+
+// Appends to `out` the intersection of [begin, end) with [lower, upper).
+HWY_INLINE void AppendClipped(size_t begin, size_t end, size_t lower,
+                              size_t upper, std::vector<SortRange>& out) {
+  begin = HWY_MAX(begin, lower);
+  end = HWY_MIN(end, upper);
+  if (begin < end) out.push_back(SortRange{begin, end - begin});
+}
+
+// Returns a pointer to lane `offset` of the concatenation of `ranges`, and
+// sets `avail` to the number of contiguous lanes starting there.
+template <typename T>
+HWY_INLINE T* LocateInRanges(T* keys, const std::vector<SortRange>& ranges,
+                             size_t offset, size_t& avail) {
+  for (const SortRange& r : ranges) {
+    if (offset < r.num) {
+      avail = r.num - offset;
+      return keys + r.begin + offset;
+    }
+    offset -= r.num;
+  }
+  HWY_DASSERT(false);
+  avail = 0;
+  return keys;
+}
+
+// Same result as Partition, but each worker first partitions one chunk, and
+// then keys on the wrong side of the global bound are swapped in parallel.
+template <class D, class Traits, typename T>
+HWY_NOINLINE size_t ParallelPartition(D d, Traits st, T* HWY_RESTRICT keys,
+                                      const size_t num,
+                                      const T* HWY_RESTRICT pivot_lanes,
+                                      ThreadPool& pool) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  const size_t num_chunks =
+      HWY_MAX(size_t{1}, HWY_MIN(pool.NumWorkers(), num / kMinParallelLanes));
+
+  std::vector<size_t> bounds(num_chunks);
+  pool.Run(0, num_chunks, [&](uint64_t task, size_t /*thread*/) {
+    HWY_ALIGN T buf[SortConstants::BufBytes<T, kLPK>(HWY_MAX_BYTES) /
+                    sizeof(T)];
+    const size_t begin = ChunkBegin(task, num_chunks, num, kLPK);
+    const size_t end = ChunkBegin(task + 1, num_chunks, num, kLPK);
+    // Vectors cannot be captured on all targets, hence reload the pivot.
+    const Vec<D> pivot = LoadU(d, pivot_lanes);
+    bounds[task] = Partition(d, st, keys + begin, end - begin, pivot, buf);
+  });
+
+  size_t bound = 0;
+  for (size_t b : bounds) bound += b;
+
+  // Right-side keys in [0, bound) and left-side keys in [bound, num).
+  std::vector<SortRange> wrong_left, wrong_right;
+  for (size_t i = 0; i < num_chunks; ++i) {
+    const size_t begin = ChunkBegin(i, num_chunks, num, kLPK);
+    const size_t end = ChunkBegin(i + 1, num_chunks, num, kLPK);
+    const size_t mid = begin + bounds[i];
+    AppendClipped(mid, end, 0, bound, wrong_left);
+    AppendClipped(begin, mid, bound, num, wrong_right);
+  }
+  size_t num_wrong = 0;
+  for (const SortRange& r : wrong_left) num_wrong += r.num;
+
+  // Swap in whole keys; each worker handles a contiguous part of both lists.
+  const size_t num_swaps =
+      HWY_MAX(size_t{1}, HWY_MIN(pool.NumWorkers(), num_wrong / 4096));
+  pool.Run(0, num_swaps, [&](uint64_t task, size_t /*thread*/) {
+    size_t offset = ChunkBegin(task, num_swaps, num_wrong, kLPK);
+    const size_t end = ChunkBegin(task + 1, num_swaps, num_wrong, kLPK);
+    while (offset < end) {
+      size_t availL, availR;
+      T* left = LocateInRanges(keys, wrong_left, offset, availL);
+      T* right = LocateInRanges(keys, wrong_right, offset, availR);
+      const size_t n = HWY_MIN(HWY_MIN(availL, availR), end - offset);
+      std::swap_ranges(left, left + n, right);
+      offset += n;
+    }
+  });
+  return bound;
+}
+
+// Splits `keys` into subarrays, each ordered before the next, until there are
+// enough for all workers. Then sorts them in parallel.
+template <class D, class Traits, typename T>
+HWY_NOINLINE void ParallelRecurse(D d, Traits st, T* HWY_RESTRICT keys,
+                                  const size_t num, T* HWY_RESTRICT buf,
+                                  ThreadPool& pool) {
+  constexpr size_t kLPK = st.LanesPerKey();
+  const size_t N = Lanes(d);
+  const size_t num_workers = pool.NumWorkers();
+  // Several tasks per worker for load-balancing.
+  const size_t max_task_lanes =
+      HWY_MAX(kMinParallelLanes, num / (4 * num_workers));
+  // Limits the number of sequential pivot selections for adversarial inputs.
+  const size_t max_levels = 2 * CeilLog2(4 * num_workers) + 2;
+  uint64_t* HWY_RESTRICT state = hwy::detail::GetGeneratorStateStatic();
+  auto pivot_lanes = hwy::AllocateAligned<T>(N);
+  HWY_ASSERT(pivot_lanes);
+
+  std::vector<SortRange> tasks;
+  std::vector<SortRange> todo{SortRange{0, num}};
+  for (size_t level = 0; !todo.empty(); ++level) {
+    std::vector<SortRange> next;
+    for (const SortRange& r : todo) {
+      if (r.num <= max_task_lanes || level == max_levels) {
+        tasks.push_back(r);
+        continue;
+      }
+
+      Vec<D> pivot;
+      const PivotResult result =
+          ChoosePivot(d, st, keys + r.begin, r.num, buf, state, pivot);
+      if (result == PivotResult::kDone) continue;
+      Store(pivot, d, pivot_lanes.get());
+
+      const size_t bound = ParallelPartition(d, st, keys + r.begin, r.num,
+                                             pivot_lanes.get(), pool);
+      HWY_DASSERT(bound != 0);
+      HWY_DASSERT(bound != r.num || result == PivotResult::kWasLast);
+      if (VQSORT_PRINT >= 1) {
+        fprintf(stderr, "ParallelRecurse level %zu len %zu bound %zu\n",
+                level, r.num, bound);
+      }
+      // As in Recurse, skip the side with all-equal keys.
+      if (HWY_LIKELY(result != PivotResult::kIsFirst)) {
+        next.push_back(SortRange{r.begin, bound});
+      }
+      if (HWY_LIKELY(result != PivotResult::kWasLast)) {
+        next.push_back(SortRange{r.begin + bound, r.num - bound});
+      }
+    }
+    todo.swap(next);
+  }
+
+  // Largest first, so that the smaller tasks fill in the gaps.
+  std::sort(tasks.begin(), tasks.end(),
+            [](const SortRange& a, const SortRange& b) {
+              return a.num > b.num;
+            });
+  const auto sort_task = [&](uint64_t task, size_t /*thread*/) {
+    HWY_ALIGN T task_buf[SortConstants::BufBytes<T, kLPK>(HWY_MAX_BYTES) /
+                         sizeof(T)];
+    const SortRange& r = tasks[task];
+    if (r.num <= Constants::BaseCaseNumLanes<kLPK>(N)) {
+      BaseCase(d, st, keys + r.begin, r.num, task_buf);
+      return;
+    }
+    // Thread-local, hence each worker draws different samples.
+    uint64_t* HWY_RESTRICT task_state = hwy::detail::GetGeneratorStateStatic();
+    Recurse(d, st, keys + r.begin, r.num, task_buf, task_state,
+            Constants::kMaxLevels);
+  };
+  RunAndGatherStats(pool, 0, tasks.size(), sort_task);
+}
+
+#endif  // VQSORT_ENABLED
+
+}  // namespace detail
+
+// Same as Sort, but uses all workers of `pool`. Falls back to the single-
+// threaded Sort if `num` is too small to benefit from parallelization.
+template <class D, class Traits, typename T>
+void ParallelSort(D d, Traits st, T* HWY_RESTRICT keys, size_t num,
+                  ThreadPool& pool) {
+#if HWY_MAX_BYTES > 64
+  // sorting_networks-inl and traits assume no more than 512 bit vectors.
+  if (HWY_UNLIKELY(Lanes(d) > 64 / sizeof(T))) {
+    return ParallelSort(CappedTag<T, 64 / sizeof(T)>(), st, keys, num, pool);
+  }
+#endif  // HWY_MAX_BYTES > 64
+
+#if VQSORT_ENABLED || HWY_IDE
+  constexpr size_t kLPK = st.LanesPerKey();
+  if (pool.NumWorkers() <= 1 || num < 2 * detail::kMinParallelLanes) {
+    return Sort(d, st, keys, num);
+  }
+
+  if (VQSORT_STATS) ++detail::Stats().num_sorts;
+  HWY_ALIGN T buf[SortConstants::BufBytes<T, kLPK>(HWY_MAX_BYTES) / sizeof(T)];
+
+  // Replace NaN in parallel; they are sorted to the back and restored below.
+  const size_t num_chunks = pool.NumWorkers();
+  std::vector<size_t> nan_counts(num_chunks);
+  pool.Run(0, num_chunks, [&](uint64_t task, size_t /*thread*/) {
+    const size_t begin = detail::ChunkBegin(task, num_chunks, num, kLPK);
+    const size_t end = detail::ChunkBegin(task + 1, num_chunks, num, kLPK);
+    nan_counts[task] =
+        detail::CountAndReplaceNaN(d, st, keys + begin, end - begin);
+  });
+  size_t num_nan = 0;
+  for (size_t count : nan_counts) num_nan += count;
+
+  if (!detail::HandleSpecialCases(d, st, keys, num, buf)) {
+    detail::ParallelRecurse(d, st, keys, num, buf, pool);
+  }
+
+  if (num_nan != 0) {
+    Fill(d, GetLane(NaN(d)), num_nan, keys + num - num_nan);
+  }
+#else
+  (void)pool;
+  Sort(d, st, keys, num);
+#endif  // VQSORT_ENABLED
+}
+
+// Same as SortSegments, but uses all workers of `pool`. Each task sorts
+// consecutive segments with about the same total number of keys. Segments are
+// not split across workers, so a single large segment is better sorted via
+// ParallelSort.
+template <class D, class Traits, typename T>
+void ParallelSortSegments(D d, Traits st, T* HWY_RESTRICT keys,
+                          const size_t* HWY_RESTRICT offsets,
+                          size_t num_segments, ThreadPool& pool) {
+#if HWY_MAX_BYTES > 64
+  // sorting_networks-inl and traits assume no more than 512 bit vectors.
+  if (HWY_UNLIKELY(Lanes(d) > 64 / sizeof(T))) {
+    return ParallelSortSegments(CappedTag<T, 64 / sizeof(T)>(), st, keys,
+                                offsets, num_segments, pool);
+  }
+#endif  // HWY_MAX_BYTES > 64
+
+#if VQSORT_ENABLED || HWY_IDE
+  constexpr size_t kLPK = st.LanesPerKey();
+  if (num_segments == 0) return;
+  const size_t num_keys = offsets[num_segments] - offsets[0];
+  // Several tasks per worker for load-balancing, but not fewer keys per task
+  // than are worth a fork-join.
+  const size_t num_tasks =
+      HWY_MIN(HWY_MIN(num_segments, 4 * pool.NumWorkers()),
+              num_keys * kLPK / (detail::kMinParallelLanes / 4));
+  if (pool.NumWorkers() <= 1 || num_tasks <= 1) {
+    return SortSegments(d, st, keys, offsets, num_segments);
+  }
+
+  // Task t begins with the first segment starting at or after the t-th
+  // fraction of all keys.
+  std::vector<size_t> first_segment(num_tasks + 1);
+  for (size_t t = 0; t < num_tasks; ++t) {
+    const size_t target = offsets[0] + static_cast<size_t>(
+                                           static_cast<uint64_t>(num_keys) * t /
+                                           static_cast<uint64_t>(num_tasks));
+    first_segment[t] = static_cast<size_t>(
+        std::lower_bound(offsets, offsets + num_segments, target) - offsets);
+  }
+  first_segment[num_tasks] = num_segments;
+
+  const auto sort_task = [&](uint64_t task, size_t /*thread*/) {
+    HWY_ALIGN T buf[SortConstants::BufBytes<T, kLPK>(HWY_MAX_BYTES) /
+                    sizeof(T)];
+    detail::SortSegmentRange(d, st, keys, offsets, first_segment[task],
+                             first_segment[task + 1], buf);
+  };
+  detail::RunAndGatherStats(pool, 0, num_tasks, sort_task);
+#else
+  (void)pool;
+  SortSegments(d, st, keys, offsets, num_segments);
+#endif  // VQSORT_ENABLED
+}
+
+#if VQSORT_ENABLED
+// Simpler interface matching the VQSort() overload with a ThreadPool, but
+// without dynamic dispatch.
+template <typename T, class Order>
+void VQSortStatic(T* HWY_RESTRICT keys, size_t num, Order /* order */,
+                  ThreadPool& pool) {
+  using Adapter = detail::KeyAdapter<T>;
+  using AdapterOrder =
+      hwy::If<Order().IsAscending(), typename Adapter::Ascending,
+              typename Adapter::Descending>;
+  const detail::SharedTraits<typename Adapter::template Traits<AdapterOrder>>
+      st;
+  using LaneType = typename decltype(st)::LaneType;
+  const SortTag<LaneType> d;
+  ParallelSort(d, st, reinterpret_cast<LaneType*>(keys),
+               num * st.LanesPerKey(), pool);
+}
+#else
+template <typename T, class Order>
+void VQSortStatic(T* HWY_RESTRICT keys, size_t num, Order order,
+                  ThreadPool& /* pool */) {
+  VQSortStatic(keys, num, order);
+}
+#endif  // VQSORT_ENABLED
+
+// Simpler interface matching the VQSortSegments() overload with a ThreadPool,
+// but without dynamic dispatch.
+template <typename T, class Order>
+void VQSortSegmentsStatic(T* HWY_RESTRICT keys,
+                          const size_t* HWY_RESTRICT offsets,
+                          size_t num_segments, Order order, ThreadPool& pool) {
+#if VQSORT_ENABLED
+  using Adapter = detail::KeyAdapter<T>;
+  using AdapterOrder =
+      hwy::If<Order().IsAscending(), typename Adapter::Ascending,
+              typename Adapter::Descending>;
+  const detail::SharedTraits<typename Adapter::template Traits<AdapterOrder>>
+      st;
+  using LaneType = typename decltype(st)::LaneType;
+  const SortTag<LaneType> d;
+  (void)order;
+  ParallelSortSegments(d, st, reinterpret_cast<LaneType*>(keys), offsets,
+                       num_segments, pool);
+#else
+  (void)pool;
+  VQSortSegmentsStatic(keys, offsets, num_segments, order);
+#endif  // VQSORT_ENABLED
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#endif  // HIGHWAY_HWY_CONTRIB_SORT_VQSORT_PARALLEL_TOGGLE
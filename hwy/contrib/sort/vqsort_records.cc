@@ -0,0 +1,181 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Record sort: copies the embedded keys into a contiguous array, obtains their
+// stable argsort via VQArgsort (which sorts K32V32 or K64V64 pairs), and
+// gathers whole records into a buffer in that order before copying back.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/cache_control.h"        // Prefetch
+#include "hwy/contrib/sort/vqsort.h"  // VQArgsort
+
+namespace hwy {
+namespace {
+
+// The source records are visited in random order, so the hardware prefetcher
+// cannot help. Instead, gather blocks of this size: first prefetch all of a
+// block's sources, so that their cache misses overlap, then copy them. The
+// block is small enough for the prefetched lines to remain in L1/L2.
+constexpr size_t kBlockBytes = 16 * 1024;
+
+// Copies key i from records[i * record_bytes + key_offset].
+template <typename TKey>
+void ExtractKeys(const uint8_t* HWY_RESTRICT records, size_t n,
+                 size_t record_bytes, size_t key_offset,
+                 TKey* HWY_RESTRICT keys) {
+  const uint8_t* HWY_RESTRICT pos = records + key_offset;
+  for (size_t i = 0; i < n; ++i) {
+    CopyBytes<sizeof(TKey)>(pos, keys + i);
+    pos += record_bytes;
+  }
+}
+
+// Writes in[indices[i]] to out[i] for i < num. kBytes is the record size if
+// known at compile time, otherwise zero.
+template <size_t kBytes, typename TI>
+void GatherRecords(const TI* HWY_RESTRICT indices, size_t num,
+                   const uint8_t* HWY_RESTRICT in, size_t record_bytes,
+                   uint8_t* HWY_RESTRICT out) {
+  HWY_DASSERT(kBytes == 0 || kBytes == record_bytes);
+  const size_t block_records = HWY_MAX(size_t{1}, kBlockBytes / record_bytes);
+  for (size_t begin = 0; begin < num; begin += block_records) {
+    const size_t end = HWY_MIN(num, begin + block_records);
+    for (size_t i = begin; i < end; ++i) {
+      Prefetch(in + indices[i] * record_bytes);
+    }
+    for (size_t i = begin; i < end; ++i) {
+      const uint8_t* HWY_RESTRICT from = in + indices[i] * record_bytes;
+      if (kBytes != 0) {
+        CopyBytes<kBytes>(from, out);
+      } else {
+        CopyBytes(from, out, record_bytes);
+      }
+      out += record_bytes;
+    }
+  }
+}
+
+template <typename TI>
+void GatherRecords(const TI* HWY_RESTRICT indices, size_t num,
+                   const uint8_t* HWY_RESTRICT in, size_t record_bytes,
+                   uint8_t* HWY_RESTRICT out) {
+  switch (record_bytes) {
+    case 8:
+      return GatherRecords<8>(indices, num, in, record_bytes, out);
+    case 16:
+      return GatherRecords<16>(indices, num, in, record_bytes, out);
+    case 24:
+      return GatherRecords<24>(indices, num, in, record_bytes, out);
+    case 32:
+      return GatherRecords<32>(indices, num, in, record_bytes, out);
+    case 48:
+      return GatherRecords<48>(indices, num, in, record_bytes, out);
+    case 64:
+      return GatherRecords<64>(indices, num, in, record_bytes, out);
+    default:
+      return GatherRecords<0>(indices, num, in, record_bytes, out);
+  }
+}
+
+// 32-bit keys use 32-bit indices, hence n must be less than 2^32.
+template <typename TKey>
+using IndexFor = UnsignedFromSize<sizeof(TKey)>;
+
+template <typename TKey, class Order>
+void SortRecords(void* HWY_RESTRICT records, size_t n, size_t record_bytes,
+                 size_t key_offset, Order order) {
+  HWY_ASSERT(key_offset + sizeof(TKey) <= record_bytes);
+  if (n < 2) return;
+  using TI = IndexFor<TKey>;
+  uint8_t* HWY_RESTRICT bytes = static_cast<uint8_t*>(records);
+
+  auto indices = hwy::AllocateAligned<TI>(n);
+  HWY_ASSERT(indices);
+  {
+    auto keys = hwy::AllocateAligned<TKey>(n);
+    HWY_ASSERT(keys);
+    ExtractKeys(bytes, n, record_bytes, key_offset, keys.get());
+    VQArgsort(keys.get(), n, indices.get(), order);
+  }
+
+  // The gather reads from all records, hence they must be copied before any
+  // are overwritten.
+  auto copy = hwy::AllocateAligned<uint8_t>(n * record_bytes);
+  HWY_ASSERT(copy);
+  CopyBytes(bytes, copy.get(), n * record_bytes);
+  GatherRecords(indices.get(), n, copy.get(), record_bytes, bytes);
+}
+
+}  // namespace
+
+void VQSortRecords(void* HWY_RESTRICT records, size_t n, size_t record_bytes,
+                   size_t key_offset, const uint32_t*, SortAscending) {
+  SortRecords<uint32_t>(records, n, record_bytes, key_offset, SortAscending());
+}
+void VQSortRecords(void* HWY_RESTRICT records, size_t n, size_t record_bytes,
+                   size_t key_offset, const uint32_t*, SortDescending) {
+  SortRecords<uint32_t>(records, n, record_bytes, key_offset, SortDescending());
+}
+
+void VQSortRecords(void* HWY_RESTRICT records, size_t n, size_t record_bytes,
+                   size_t key_offset, const int32_t*, SortAscending) {
+  SortRecords<int32_t>(records, n, record_bytes, key_offset, SortAscending());
+}
+void VQSortRecords(void* HWY_RESTRICT records, size_t n, size_t record_bytes,
+                   size_t key_offset, const int32_t*, SortDescending) {
+  SortRecords<int32_t>(records, n, record_bytes, key_offset, SortDescending());
+}
+
+void VQSortRecords(void* HWY_RESTRICT records, size_t n, size_t record_bytes,
+                   size_t key_offset, const float*, SortAscending) {
+  SortRecords<float>(records, n, record_bytes, key_offset, SortAscending());
+}
+void VQSortRecords(void* HWY_RESTRICT records, size_t n, size_t record_bytes,
+                   size_t key_offset, const float*, SortDescending) {
+  SortRecords<float>(records, n, record_bytes, key_offset, SortDescending());
+}
+
+void VQSortRecords(void* HWY_RESTRICT records, size_t n, size_t record_bytes,
+                   size_t key_offset, const uint64_t*, SortAscending) {
+  SortRecords<uint64_t>(records, n, record_bytes, key_offset, SortAscending());
+}
+void VQSortRecords(void* HWY_RESTRICT records, size_t n, size_t record_bytes,
+                   size_t key_offset, const uint64_t*, SortDescending) {
+  SortRecords<uint64_t>(records, n, record_bytes, key_offset, SortDescending());
+}
+
+void VQSortRecords(void* HWY_RESTRICT records, size_t n, size_t record_bytes,
+                   size_t key_offset, const int64_t*, SortAscending) {
+  SortRecords<int64_t>(records, n, record_bytes, key_offset, SortAscending());
+}
+void VQSortRecords(void* HWY_RESTRICT records, size_t n, size_t record_bytes,
+                   size_t key_offset, const int64_t*, SortDescending) {
+  SortRecords<int64_t>(records, n, record_bytes, key_offset, SortDescending());
+}
+
+void VQSortRecords(void* HWY_RESTRICT records, size_t n, size_t record_bytes,
+                   size_t key_offset, const double*, SortAscending) {
+  SortRecords<double>(records, n, record_bytes, key_offset, SortAscending());
+}
+void VQSortRecords(void* HWY_RESTRICT records, size_t n, size_t record_bytes,
+                   size_t key_offset, const double*, SortDescending) {
+  SortRecords<double>(records, n, record_bytes, key_offset, SortDescending());
+}
+
+}  // namespace hwy
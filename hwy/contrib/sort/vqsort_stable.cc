@@ -0,0 +1,188 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Stable sort: VQArgsort is stable, so applying its permutation to a copy of
+// the keys (or key-value pairs) sorts them stably.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/contrib/sort/vqsort.h"  // VQArgsort
+
+#undef HWY_TARGET_INCLUDE
+#define HWY_TARGET_INCLUDE "hwy/contrib/sort/vqsort_stable.cc"
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+
+// After foreach_target
+#include "hwy/highway.h"
+
+HWY_BEFORE_NAMESPACE();
+namespace hwy {
+namespace HWY_NAMESPACE {
+
+// Exported (only via HWY_EXPORT below), hence outside an anonymous namespace.
+
+// K32V32 are u64 lanes with the key in the upper half.
+void ExtractKeys32(const K32V32* HWY_RESTRICT kv, size_t num,
+                   uint32_t* HWY_RESTRICT keys) {
+  const ScalableTag<uint64_t> d64;
+  const Rebind<uint32_t, decltype(d64)> d32;
+  const size_t N = Lanes(d64);
+  const uint64_t* HWY_RESTRICT lanes = reinterpret_cast<const uint64_t*>(kv);
+  size_t i = 0;
+  for (; i + N <= num; i += N) {
+    const Vec<decltype(d64)> v = LoadU(d64, lanes + i);
+    StoreU(TruncateTo(d32, ShiftRight<32>(v)), d32, keys + i);
+  }
+  for (; i < num; ++i) {
+    keys[i] = kv[i].key;
+  }
+}
+
+// K64V64 are pairs of u64 lanes, the value followed by the key.
+void ExtractKeys64(const K64V64* HWY_RESTRICT kv, size_t num,
+                   uint64_t* HWY_RESTRICT keys) {
+  const ScalableTag<uint64_t> d;
+  const size_t N = Lanes(d);
+  const uint64_t* HWY_RESTRICT lanes = reinterpret_cast<const uint64_t*>(kv);
+  size_t i = 0;
+  for (; i + N <= num; i += N) {
+    Vec<decltype(d)> value, key;
+    LoadInterleaved2(d, lanes + 2 * i, value, key);
+    StoreU(key, d, keys + i);
+  }
+  for (; i < num; ++i) {
+    keys[i] = kv[i].key;
+  }
+}
+
+// NOLINTNEXTLINE(google-readability-namespace-comments)
+}  // namespace HWY_NAMESPACE
+}  // namespace hwy
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace hwy {
+namespace {
+HWY_EXPORT(ExtractKeys32);
+HWY_EXPORT(ExtractKeys64);
+
+// Sorts `keys` according to the stable argsort of `sort_keys`, which are
+// either `keys` or extracted from them, hence may alias `keys`.
+template <typename TI, typename TK, typename T, class Order>
+void StableSortBy(const TK* sort_keys, T* keys, size_t n, Order order) {
+  if (n < 2) return;
+  auto indices = hwy::AllocateAligned<TI>(n);
+  HWY_ASSERT(indices);
+  VQArgsort(sort_keys, n, indices.get(), order);
+
+  auto copy = hwy::AllocateAligned<T>(n);
+  HWY_ASSERT(copy);
+  CopyBytes(keys, copy.get(), n * sizeof(T));
+  VQApplyPermutation(indices.get(), n, copy.get(), keys);
+}
+
+// There is no gather for 128-bit lanes.
+void ApplyPermutation128(const uint64_t* HWY_RESTRICT indices, size_t n,
+                         const K64V64* HWY_RESTRICT in,
+                         K64V64* HWY_RESTRICT out) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = in[indices[i]];
+  }
+}
+
+template <class Order>
+void StableSortK64V64(K64V64* HWY_RESTRICT kv, size_t n, Order order) {
+  if (n < 2) return;
+  auto indices = hwy::AllocateAligned<uint64_t>(n);
+  HWY_ASSERT(indices);
+  {
+    auto keys = hwy::AllocateAligned<uint64_t>(n);
+    HWY_ASSERT(keys);
+    HWY_DYNAMIC_DISPATCH(ExtractKeys64)(kv, n, keys.get());
+    VQArgsort(keys.get(), n, indices.get(), order);
+  }
+
+  auto copy = hwy::AllocateAligned<K64V64>(n);
+  HWY_ASSERT(copy);
+  CopyBytes(kv, copy.get(), n * sizeof(K64V64));
+  ApplyPermutation128(indices.get(), n, copy.get(), kv);
+}
+
+}  // namespace
+
+void VQStableSort(uint32_t* HWY_RESTRICT keys, size_t n, SortAscending) {
+  VQSort(keys, n, SortAscending());
+}
+void VQStableSort(uint32_t* HWY_RESTRICT keys, size_t n, SortDescending) {
+  VQSort(keys, n, SortDescending());
+}
+void VQStableSort(int32_t* HWY_RESTRICT keys, size_t n, SortAscending) {
+  VQSort(keys, n, SortAscending());
+}
+void VQStableSort(int32_t* HWY_RESTRICT keys, size_t n, SortDescending) {
+  VQSort(keys, n, SortDescending());
+}
+void VQStableSort(uint64_t* HWY_RESTRICT keys, size_t n, SortAscending) {
+  VQSort(keys, n, SortAscending());
+}
+void VQStableSort(uint64_t* HWY_RESTRICT keys, size_t n, SortDescending) {
+  VQSort(keys, n, SortDescending());
+}
+void VQStableSort(int64_t* HWY_RESTRICT keys, size_t n, SortAscending) {
+  VQSort(keys, n, SortAscending());
+}
+void VQStableSort(int64_t* HWY_RESTRICT keys, size_t n, SortDescending) {
+  VQSort(keys, n, SortDescending());
+}
+
+void VQStableSort(float* HWY_RESTRICT keys, size_t n, SortAscending) {
+  StableSortBy<uint32_t>(keys, keys, n, SortAscending());
+}
+void VQStableSort(float* HWY_RESTRICT keys, size_t n, SortDescending) {
+  StableSortBy<uint32_t>(keys, keys, n, SortDescending());
+}
+void VQStableSort(double* HWY_RESTRICT keys, size_t n, SortAscending) {
+  StableSortBy<uint64_t>(keys, keys, n, SortAscending());
+}
+void VQStableSort(double* HWY_RESTRICT keys, size_t n, SortDescending) {
+  StableSortBy<uint64_t>(keys, keys, n, SortDescending());
+}
+
+void VQStableSort(K32V32* HWY_RESTRICT keys, size_t n, SortAscending) {
+  if (n < 2) return;
+  auto sort_keys = hwy::AllocateAligned<uint32_t>(n);
+  HWY_ASSERT(sort_keys);
+  HWY_DYNAMIC_DISPATCH(ExtractKeys32)(keys, n, sort_keys.get());
+  StableSortBy<uint32_t>(sort_keys.get(), keys, n, SortAscending());
+}
+void VQStableSort(K32V32* HWY_RESTRICT keys, size_t n, SortDescending) {
+  if (n < 2) return;
+  auto sort_keys = hwy::AllocateAligned<uint32_t>(n);
+  HWY_ASSERT(sort_keys);
+  HWY_DYNAMIC_DISPATCH(ExtractKeys32)(keys, n, sort_keys.get());
+  StableSortBy<uint32_t>(sort_keys.get(), keys, n, SortDescending());
+}
+void VQStableSort(K64V64* HWY_RESTRICT keys, size_t n, SortAscending) {
+  StableSortK64V64(keys, n, SortAscending());
+}
+void VQStableSort(K64V64* HWY_RESTRICT keys, size_t n, SortDescending) {
+  StableSortK64V64(keys, n, SortDescending());
+}
+
+}  // namespace hwy
+#endif  // HWY_ONCE
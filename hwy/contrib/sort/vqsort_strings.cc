@@ -0,0 +1,212 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// String sort in the manner of multikey quicksort: each pass packs the next
+// bytes of each string into the upper bits of a uint128_t key, with the string
+// index in the lower bits, and sorts those keys via VQSort. Only groups of
+// strings whose packed bytes are equal require another pass, and only small
+// groups are sorted by comparing their remaining bytes.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>  // memcmp
+
+#include <algorithm>  // std::sort
+#include <vector>
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/contrib/sort/vqsort.h"  // VQSort
+
+namespace hwy {
+namespace {
+
+// Groups smaller than this are sorted by std::sort with full comparisons.
+constexpr size_t kMinVQSortStrings = 32;
+
+// Returns the bytes s[offset, offset + num_bytes) as a big-endian integer, so
+// that integer order matches lexicographic order. Bytes past the end of the
+// string are zero. num_bytes <= 8.
+HWY_INLINE uint64_t LoadBigEndian(const char* HWY_RESTRICT s, size_t len,
+                                  size_t offset, size_t num_bytes) {
+  uint8_t buf[8] = {0};
+  if (offset < len) {
+    CopyBytes(s + offset, buf, HWY_MIN(num_bytes, len - offset));
+  }
+  uint64_t bits = 0;
+  for (size_t i = 0; i < num_bytes; ++i) {
+    bits = (bits << 8) | buf[i];
+  }
+  return bits;
+}
+
+template <typename TI>
+class StringSorter {
+ public:
+  StringSorter(const char* const* HWY_RESTRICT strings,
+               const size_t* HWY_RESTRICT lengths, size_t n)
+      : strings_(strings),
+        lengths_(lengths),
+        // With 32-bit indices, the lower half of lo holds four more bytes.
+        index_bits_(static_cast<uint64_t>(n) <= (uint64_t{1} << 32) ? 32 : 64),
+        bytes_per_pass_(index_bits_ == 32 ? 12 : 8),
+        keys_(AllocateAligned<uint128_t>(n)) {
+    HWY_ASSERT(keys_);
+  }
+
+  void operator()(TI* HWY_RESTRICT indices, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+      indices[i] = static_cast<TI>(i);
+    }
+    // Explicit stack because long common prefixes (e.g. URLs) would otherwise
+    // lead to deep recursion.
+    std::vector<Group> stack;
+    stack.push_back(Group{0, n, 0});
+    while (!stack.empty()) {
+      const Group group = stack.back();
+      stack.pop_back();
+      SortGroup(indices, group, stack);
+    }
+  }
+
+ private:
+  // indices[begin, end) have equal bytes before `offset`.
+  struct Group {
+    size_t begin;
+    size_t end;
+    size_t offset;
+  };
+
+  // Whether string a is ordered before string b, given that their first
+  // `offset` bytes are equal.
+  bool Less(size_t a, size_t b, size_t offset) const {
+    const size_t len_a = lengths_[a] - HWY_MIN(offset, lengths_[a]);
+    const size_t len_b = lengths_[b] - HWY_MIN(offset, lengths_[b]);
+    const int cmp = memcmp(strings_[a] + HWY_MIN(offset, lengths_[a]),
+                           strings_[b] + HWY_MIN(offset, lengths_[b]),
+                           HWY_MIN(len_a, len_b));
+    return cmp == 0 ? len_a < len_b : cmp < 0;
+  }
+
+  void SortGroup(TI* HWY_RESTRICT indices, const Group& group,
+                 std::vector<Group>& stack) {
+    const size_t num = group.end - group.begin;
+    const size_t offset = group.offset;
+    TI* HWY_RESTRICT first = indices + group.begin;
+    if (num < kMinVQSortStrings) {
+      std::sort(first, first + num, [this, offset](TI a, TI b) {
+        return Less(a, b, offset);
+      });
+      return;
+    }
+
+    uint128_t* HWY_RESTRICT keys = keys_.get() + group.begin;
+    for (size_t i = 0; i < num; ++i) {
+      const size_t idx = first[i];
+      const char* HWY_RESTRICT s = strings_[idx];
+      const size_t len = lengths_[idx];
+      keys[i].hi = LoadBigEndian(s, len, offset, 8);
+      keys[i].lo = index_bits_ == 32
+                       ? (LoadBigEndian(s, len, offset + 8, 4) << 32) | idx
+                       : uint64_t{idx};
+    }
+    VQSort(keys, num, SortAscending());
+
+    const uint64_t index_mask =
+        index_bits_ == 32 ? 0xFFFFFFFFu : ~uint64_t{0};
+    for (size_t i = 0; i < num; ++i) {
+      first[i] = static_cast<TI>(keys[i].lo & index_mask);
+    }
+
+    // Find runs of equal packed bytes.
+    const size_t end_offset = offset + bytes_per_pass_;
+    size_t run_begin = 0;
+    for (size_t i = 1; i <= num; ++i) {
+      if (i != num && SamePrefix(keys[i - 1], keys[i])) continue;
+      if (i - run_begin > 1) {
+        SplitRun(first + run_begin, i - run_begin, end_offset,
+                 group.begin + run_begin, stack);
+      }
+      run_begin = i;
+    }
+  }
+
+  bool SamePrefix(const uint128_t& a, const uint128_t& b) const {
+    if (a.hi != b.hi) return false;
+    return index_bits_ == 64 || (a.lo >> 32) == (b.lo >> 32);
+  }
+
+  // run[0, num) have equal bytes before end_offset, after zero-padding. Those
+  // that end before end_offset are thus prefixes of the others, and only
+  // differ from each other in their number of trailing zero bytes.
+  void SplitRun(TI* HWY_RESTRICT run, size_t num, size_t end_offset,
+                size_t begin, std::vector<Group>& stack) {
+    const size_t* HWY_RESTRICT lengths = lengths_;
+    TI* HWY_RESTRICT longer =
+        std::partition(run, run + num, [lengths, end_offset](TI idx) {
+          return lengths[idx] <= end_offset;
+        });
+    std::sort(run, longer,
+              [lengths](TI a, TI b) { return lengths[a] < lengths[b]; });
+    const size_t num_shorter = static_cast<size_t>(longer - run);
+    if (num - num_shorter > 1) {
+      stack.push_back(Group{begin + num_shorter, begin + num, end_offset});
+    }
+  }
+
+  const char* const* HWY_RESTRICT strings_;
+  const size_t* HWY_RESTRICT lengths_;
+  const size_t index_bits_;
+  const size_t bytes_per_pass_;
+  AlignedFreeUniquePtr<uint128_t[]> keys_;
+};
+
+template <typename TI>
+void SortStrings(const char* const* HWY_RESTRICT strings,
+                 const size_t* HWY_RESTRICT lengths, size_t n,
+                 TI* HWY_RESTRICT indices, bool is_ascending) {
+  HWY_ASSERT(n == 0 || n - 1 <= static_cast<size_t>(LimitsMax<TI>()));
+  if (n < 2) {
+    if (n == 1) indices[0] = 0;
+    return;
+  }
+  StringSorter<TI>(strings, lengths, n)(indices, n);
+  if (!is_ascending) std::reverse(indices, indices + n);
+}
+
+}  // namespace
+
+void VQSortStrings(const char* const* HWY_RESTRICT strings,
+                   const size_t* HWY_RESTRICT lengths, size_t n,
+                   uint32_t* HWY_RESTRICT indices, SortAscending) {
+  SortStrings(strings, lengths, n, indices, /*is_ascending=*/true);
+}
+void VQSortStrings(const char* const* HWY_RESTRICT strings,
+                   const size_t* HWY_RESTRICT lengths, size_t n,
+                   uint32_t* HWY_RESTRICT indices, SortDescending) {
+  SortStrings(strings, lengths, n, indices, /*is_ascending=*/false);
+}
+void VQSortStrings(const char* const* HWY_RESTRICT strings,
+                   const size_t* HWY_RESTRICT lengths, size_t n,
+                   uint64_t* HWY_RESTRICT indices, SortAscending) {
+  SortStrings(strings, lengths, n, indices, /*is_ascending=*/true);
+}
+void VQSortStrings(const char* const* HWY_RESTRICT strings,
+                   const size_t* HWY_RESTRICT lengths, size_t n,
+                   uint64_t* HWY_RESTRICT indices, SortDescending) {
+  SortStrings(strings, lengths, n, indices, /*is_ascending=*/false);
+}
+
+}  // namespace hwy
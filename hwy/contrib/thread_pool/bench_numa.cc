@@ -0,0 +1,173 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures read bandwidth of a thread pinned to each NUMA node from memory on
+// each node, i.e. local vs. remote, plus interleaved and first-touch arrays
+// read by a pinned pool.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>  // std::find
+#include <thread>     // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/contrib/thread_pool/numa.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
+#include "hwy/contrib/thread_pool/topology.h"
+#include "hwy/detect_compiler_arch.h"  // HWY_ARCH_WASM
+#include "hwy/timer.h"
+
+namespace hwy {
+namespace {
+
+#if HWY_IS_DEBUG_BUILD
+constexpr size_t kBytes = 8 * 1024 * 1024;
+#else
+constexpr size_t kBytes = 64 * 1024 * 1024;
+#endif
+constexpr size_t kItems = kBytes / sizeof(uint64_t);
+constexpr size_t kReps = 5;
+
+// Prevents the compiler from eliding the sums.
+uint64_t sink;
+
+uint64_t SumRange(const uint64_t* HWY_RESTRICT items, size_t begin,
+                  size_t end) {
+  uint64_t sum = 0;
+  for (size_t i = begin; i < end; ++i) sum += items[i];
+  return sum;
+}
+
+void Fill(uint64_t* HWY_RESTRICT items, size_t begin, size_t end) {
+  for (size_t i = begin; i < end; ++i) items[i] = i;
+}
+
+// Returns GB/s of the fastest of kReps calls to `func()`, which reads kBytes.
+template <class Func>
+double BestBandwidth(const Func& func) {
+  double best = 0.0;
+  for (size_t rep = 0; rep < kReps; ++rep) {
+    const double t0 = platform::Now();
+    func();
+    const double elapsed = platform::Now() - t0;
+    best = HWY_MAX(best, static_cast<double>(kBytes) * 1E-9 / elapsed);
+  }
+  return best;
+}
+
+// Returns the first LP in `allowed` on each node, if any.
+std::vector<LogicalProcessor> OneLPPerNode(const Topology& topology,
+                                           const std::vector<size_t>& allowed) {
+  std::vector<LogicalProcessor> lps;
+  for (size_t node : topology.Nodes()) {
+    for (const LogicalProcessor& lp : topology.LPs()) {
+      if (lp.node == node &&
+          std::find(allowed.begin(), allowed.end(), lp.lp) != allowed.end()) {
+        lps.push_back(lp);
+        break;
+      }
+    }
+  }
+  return lps;
+}
+
+TEST(NumaBench, LocalRemote) {
+  if (HWY_ARCH_WASM) return;
+
+  const Topology topology;
+  std::vector<size_t> allowed;
+  if (topology.Empty() || !GetThreadAffinity(allowed)) {
+    fprintf(stderr, "Skipping: topology or affinity not supported.\n");
+    return;
+  }
+  const std::vector<size_t>& nodes = topology.Nodes();
+  if (nodes.size() < 2) {
+    fprintf(stderr, "Only one NUMA node; local and remote are the same.\n");
+  }
+
+  for (const LogicalProcessor& cpu : OneLPPerNode(topology, allowed)) {
+    for (size_t mem_node : nodes) {
+      // Separate thread so that pinning does not affect the main thread.
+      std::thread thread([&]() {
+        HWY_ASSERT(PinThreadToLogicalProcessor(cpu.lp));
+        AlignedFreeUniquePtr<uint64_t[]> items =
+            AllocateAlignedOnNode<uint64_t>(kItems, mem_node);
+        HWY_ASSERT(items);
+        Fill(items.get(), 0, kItems);
+        const double gbps = BestBandwidth(
+            [&]() { sink += SumRange(items.get(), 0, kItems); });
+        fprintf(stderr, "CPU node %zu, memory node %zu (%s): %6.2f GB/s\n",
+                cpu.node, mem_node, cpu.node == mem_node ? "local " : "remote",
+                gbps);
+      });
+      thread.join();
+    }
+  }
+}
+
+TEST(NumaBench, PoolPlacement) {
+  if (HWY_ARCH_WASM) return;
+
+  std::vector<size_t> allowed;
+  (void)GetThreadAffinity(allowed);
+  const std::vector<size_t> lps =
+      Topology().LPsForPinning(PinPolicy::kSkipSMT, allowed);
+  ThreadPool pool(HWY_MIN(ThreadPool::MaxThreads() + 1, lps.size()), lps);
+  const size_t num_workers = pool.NumWorkers();
+  const size_t per_worker = DivCeil(kItems, num_workers);
+
+  // Each worker reads the range it would first-touch, see numa.h.
+  const auto parallel_sum = [&](const uint64_t* items) {
+    std::vector<uint64_t> sums(num_workers);
+    pool.Run(0, num_workers, [&](uint64_t task, size_t thread) {
+      const size_t begin = static_cast<size_t>(task) * per_worker;
+      const size_t end = HWY_MIN(begin + per_worker, kItems);
+      sums[thread] = SumRange(items, begin, end);
+    });
+    for (uint64_t sum : sums) sink += sum;
+  };
+
+  AlignedFreeUniquePtr<uint64_t[]> interleaved =
+      AllocateAlignedInterleaved<uint64_t>(kItems);
+  AlignedFreeUniquePtr<uint64_t[]> first_touch =
+      AllocateAlignedFirstTouch<uint64_t>(kItems, pool);
+  AlignedFreeUniquePtr<uint64_t[]> main_touch =
+      AllocateAligned<uint64_t>(kItems);
+  HWY_ASSERT(interleaved && first_touch && main_touch);
+  Fill(interleaved.get(), 0, kItems);
+  Fill(main_touch.get(), 0, kItems);
+  pool.Run(0, num_workers, [&](uint64_t task, size_t /*thread*/) {
+    const size_t begin = static_cast<size_t>(task) * per_worker;
+    Fill(first_touch.get(), begin, HWY_MIN(begin + per_worker, kItems));
+  });
+
+  fprintf(stderr, "%zu workers: main thread first touch %6.2f GB/s\n",
+          num_workers,
+          BestBandwidth([&]() { parallel_sum(main_touch.get()); }));
+  fprintf(stderr, "%zu workers: interleaved            %6.2f GB/s\n",
+          num_workers,
+          BestBandwidth([&]() { parallel_sum(interleaved.get()); }));
+  fprintf(stderr, "%zu workers: worker first touch     %6.2f GB/s\n",
+          num_workers,
+          BestBandwidth([&]() { parallel_sum(first_touch.get()); }));
+}
+
+}  // namespace
+}  // namespace hwy
@@ -0,0 +1,159 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HIGHWAY_HWY_CONTRIB_THREAD_POOL_NESTED_POOLS_H_
+#define HIGHWAY_HWY_CONTRIB_THREAD_POOL_NESTED_POOLS_H_
+
+// Two-level thread pools: an outer pool with one worker per package (socket)
+// or L3 cluster, each of which owns an inner pool of the cores in its group.
+
+#include <stddef.h>
+
+#include <algorithm>  // std::lower_bound
+#include <memory>
+#include <vector>
+
+#include "hwy/base.h"  // HWY_ASSERT
+#include "hwy/contrib/thread_pool/thread_pool.h"
+#include "hwy/contrib/thread_pool/topology.h"
+
+namespace hwy {
+
+// Which logical processors share an inner pool.
+enum class PoolGroup {
+  kPackage,  // Socket, i.e. NUMA node on most systems.
+  kCluster,  // Cores sharing an L3 cache, e.g. an AMD CCX.
+};
+
+// A single ThreadPool must not be re-entered, i.e. its `Run` closure must not
+// call `Run` on the same pool. Instead, the outer pool's closure calls `Run` on
+// the inner pool belonging to the current outer worker:
+//
+//   pools.Outer().Run(0, num_batches, [&](uint64_t batch, size_t outer) {
+//     pools.Inner(outer).Run(0, num_rows, [&](uint64_t row, size_t inner) {
+//       ...
+//     });
+//   });
+//
+// Each outer worker is also the main thread of its inner pool, hence the total
+// number of threads equals the number of logical processors, and tasks of the
+// same batch run within the same group, which keeps their data local.
+class NestedPools {
+ public:
+  // Unpinned `num_outer` groups of `num_inner` workers each, for platforms
+  // without Topology support or for testing. Arguments of 0 are treated as 1.
+  NestedPools(size_t num_outer, size_t num_inner) {
+    num_outer = HWY_MAX(num_outer, size_t{1});
+    num_inner = HWY_MAX(num_inner, size_t{1});
+    outer_.reset(new ThreadPool(num_outer));
+    lps_.resize(num_outer);
+    for (size_t outer = 0; outer < num_outer; ++outer) {
+      inner_.emplace_back(new ThreadPool(num_inner));
+    }
+  }
+
+  // Groups the logical processors returned by `topology.LPsForPinning(policy,
+  // allowed)` by `group`, then uses at most `max_outer` groups of at most
+  // `max_inner` processors each (0 means no limit). Outer worker `o` and the
+  // workers of `Inner(o)` are pinned to the processors of group `o`, except
+  // for the caller of `Outer().Run`, which is not pinned but acts as the main
+  // thread of the last inner pool. If `topology` is empty, falls back to a
+  // single unpinned group of `ThreadPool::MaxThreads() + 1` workers.
+  NestedPools(const Topology& topology, PoolGroup group, PinPolicy policy,
+              size_t max_outer = 0, size_t max_inner = 0,
+              const std::vector<size_t>& allowed = std::vector<size_t>()) {
+    const std::vector<LogicalProcessor>& all = topology.LPs();
+    std::vector<size_t> keys;  // package or cluster, per group
+    for (size_t lp : topology.LPsForPinning(policy, allowed)) {
+      // `all` is sorted by OS index.
+      const LogicalProcessor& info = *std::lower_bound(
+          all.begin(), all.end(), lp,
+          [](const LogicalProcessor& a, size_t b) { return a.lp < b; });
+      const size_t key =
+          group == PoolGroup::kPackage ? info.package : info.cluster;
+      // Groups are numbered in order of their first LP in pinning order, so
+      // that we can cap their number below.
+      size_t idx = 0;
+      while (idx < keys.size() && keys[idx] != key) ++idx;
+      if (idx == keys.size()) {
+        keys.push_back(key);
+        lps_.emplace_back();
+      }
+      lps_[idx].push_back(lp);
+    }
+
+    if (lps_.empty()) {
+      lps_.resize(1);
+      outer_.reset(new ThreadPool(1));
+      inner_.emplace_back(new ThreadPool(ThreadPool::MaxThreads() + 1));
+      return;
+    }
+
+    if (max_outer != 0 && lps_.size() > max_outer) lps_.resize(max_outer);
+    std::vector<size_t> first_lps;
+    for (std::vector<size_t>& lps : lps_) {
+      if (max_inner != 0 && lps.size() > max_inner) lps.resize(max_inner);
+      first_lps.push_back(lps[0]);
+      // The outer worker is pinned to lps[0] and is the inner main thread.
+      const std::vector<size_t> inner_lps(lps.begin() + 1, lps.end());
+      inner_.emplace_back(new ThreadPool(lps.size(), inner_lps));
+    }
+    outer_.reset(new ThreadPool(lps_.size(), first_lps));
+  }
+
+  NestedPools(const NestedPools&) = delete;
+  NestedPools& operator=(const NestedPools&) = delete;
+
+  size_t NumOuter() const { return inner_.size(); }
+
+  // Total number of workers across all inner pools.
+  size_t NumWorkers() const {
+    size_t num_workers = 0;
+    for (const std::unique_ptr<ThreadPool>& inner : inner_) {
+      num_workers += inner->NumWorkers();
+    }
+    return num_workers;
+  }
+
+  ThreadPool& Outer() { return *outer_; }
+
+  // `outer` is the `thread` argument of the `Outer().Run` closure.
+  ThreadPool& Inner(size_t outer) {
+    HWY_DASSERT(outer < inner_.size());
+    return *inner_[outer];
+  }
+
+  // OS indices of the logical processors of group `outer`; the first is that
+  // of the outer worker. Empty if not pinned.
+  const std::vector<size_t>& LPs(size_t outer) const {
+    HWY_DASSERT(outer < lps_.size());
+    return lps_[outer];
+  }
+
+  // Sets `mode` for all pools; see ThreadPool::SetWaitMode.
+  void SetWaitMode(PoolWaitMode mode) {
+    outer_->SetWaitMode(mode);
+    for (std::unique_ptr<ThreadPool>& inner : inner_) inner->SetWaitMode(mode);
+  }
+
+ private:
+  std::unique_ptr<ThreadPool> outer_;
+  std::vector<std::unique_ptr<ThreadPool>> inner_;
+  std::vector<std::vector<size_t>> lps_;  // per group
+};
+
+}  // namespace hwy
+
+#endif  // HIGHWAY_HWY_CONTRIB_THREAD_POOL_NESTED_POOLS_H_
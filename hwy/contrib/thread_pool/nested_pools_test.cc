@@ -0,0 +1,184 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hwy/contrib/thread_pool/nested_pools.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "hwy/base.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
+#include "hwy/contrib/thread_pool/topology.h"
+#include "hwy/detect_compiler_arch.h"  // HWY_ARCH_WASM
+
+#if HWY_OS_LINUX
+#include <stdlib.h>    // mkdtemp
+#include <sys/stat.h>  // mkdir
+#endif
+
+namespace hwy {
+namespace {
+
+// Runs a nested parallel-for and verifies each (batch, row) is visited once per
+// repetition.
+void VerifyNested(NestedPools& pools) {
+  constexpr size_t kBatches = 7;
+  constexpr size_t kRows = 19;
+  std::vector<std::atomic<uint32_t>> visits(kBatches * kRows);
+  for (std::atomic<uint32_t>& v : visits) v.store(0);
+
+  for (size_t rep = 0; rep < 3; ++rep) {
+    pools.Outer().Run(0, kBatches, [&](uint64_t batch, size_t outer) {
+      HWY_ASSERT(outer < pools.NumOuter());
+      ThreadPool& inner = pools.Inner(outer);
+      const size_t num_inner = inner.NumWorkers();
+      inner.Run(0, kRows, [&](uint64_t row, size_t thread) {
+        HWY_ASSERT(thread < num_inner);
+        visits[batch * kRows + row].fetch_add(1);
+      });
+    });
+  }
+
+  for (std::atomic<uint32_t>& v : visits) HWY_ASSERT(v.load() == 3);
+}
+
+TEST(NestedPoolsTest, TestUnpinned) {
+  if (HWY_ARCH_WASM) return;  // WASM threading is unreliable
+
+  for (size_t num_outer = 0; num_outer <= 3; ++num_outer) {
+    for (size_t num_inner = 0; num_inner <= 3; ++num_inner) {
+      NestedPools pools(num_outer, num_inner);
+      HWY_ASSERT(pools.NumOuter() == HWY_MAX(num_outer, size_t{1}));
+      HWY_ASSERT(pools.NumWorkers() == pools.NumOuter() *
+                                           HWY_MAX(num_inner, size_t{1}));
+      HWY_ASSERT(pools.LPs(0).empty());
+      VerifyNested(pools);
+      pools.SetWaitMode(PoolWaitMode::kSpin);
+      VerifyNested(pools);
+    }
+  }
+}
+
+TEST(NestedPoolsTest, TestTopology) {
+  if (HWY_ARCH_WASM) return;  // WASM threading is unreliable
+
+  std::vector<size_t> allowed;
+  (void)GetThreadAffinity(allowed);
+  const Topology topology;
+  for (PoolGroup group : {PoolGroup::kPackage, PoolGroup::kCluster}) {
+    NestedPools pools(topology, group, PinPolicy::kSkipSMT, /*max_outer=*/0,
+                      /*max_inner=*/4, allowed);
+    fprintf(stderr, "%zu outer, %zu workers\n", pools.NumOuter(),
+            pools.NumWorkers());
+    if (!topology.Empty()) {
+      const size_t num_groups = group == PoolGroup::kPackage
+                                    ? topology.NumPackages()
+                                    : topology.NumClusters();
+      HWY_ASSERT(pools.NumOuter() <= num_groups);
+      for (size_t outer = 0; outer < pools.NumOuter(); ++outer) {
+        HWY_ASSERT(pools.LPs(outer).size() == pools.Inner(outer).NumWorkers());
+        HWY_ASSERT(pools.LPs(outer).size() <= 4);
+      }
+    }
+    VerifyNested(pools);
+  }
+}
+
+#if HWY_OS_LINUX
+
+// Six LPs without SMT: 0, 1, 4 in package 0 and 2, 3, 5 in package 1.
+TEST(NestedPoolsTest, TestGrouping) {
+  char templ[] = "/tmp/hwy_nested_XXXXXX";
+  HWY_ASSERT(mkdtemp(templ) != nullptr);
+  const std::string dir = templ;
+  std::vector<std::string> paths = {dir};
+  const auto write = [&paths](const std::string& path, const char* contents) {
+    FILE* f = fopen(path.c_str(), "w");
+    HWY_ASSERT(f != nullptr);
+    HWY_ASSERT(fputs(contents, f) >= 0);
+    HWY_ASSERT(fclose(f) == 0);
+    paths.push_back(path);
+  };
+  write(dir + "/online", "0-5\n");
+  const size_t packages[6] = {0, 0, 1, 1, 0, 1};
+  for (size_t lp = 0; lp < 6; ++lp) {
+    const std::string cpu = dir + "/cpu" + std::to_string(lp);
+    for (const std::string& sub : {cpu, cpu + "/topology"}) {
+      HWY_ASSERT(mkdir(sub.c_str(), 0700) == 0);
+      paths.push_back(sub);
+    }
+    write(cpu + "/topology/physical_package_id", packages[lp] ? "1" : "0");
+  }
+  const Topology topology(dir.c_str());
+  for (size_t i = paths.size(); i != 0; --i) {
+    (void)remove(paths[i - 1].c_str());
+  }
+  HWY_ASSERT(topology.NumPackages() == 2);
+
+  {
+    NestedPools pools(topology, PoolGroup::kPackage, PinPolicy::kAllLPs);
+    HWY_ASSERT(pools.NumOuter() == 2);
+    HWY_ASSERT(pools.NumWorkers() == 6);
+    HWY_ASSERT((pools.LPs(0) == std::vector<size_t>{0, 1, 4}));
+    HWY_ASSERT((pools.LPs(1) == std::vector<size_t>{2, 3, 5}));
+    VerifyNested(pools);
+  }
+  {
+    NestedPools pools(topology, PoolGroup::kCluster, PinPolicy::kSkipSMT,
+                      /*max_outer=*/1, /*max_inner=*/2);
+    HWY_ASSERT(pools.NumOuter() == 1);
+    HWY_ASSERT((pools.LPs(0) == std::vector<size_t>{0, 1}));
+    HWY_ASSERT(pools.Inner(0).NumWorkers() == 2);
+    VerifyNested(pools);
+  }
+  {
+    const std::vector<size_t> allowed = {3, 4, 5};
+    NestedPools pools(topology, PoolGroup::kPackage, PinPolicy::kAllLPs,
+                      /*max_outer=*/0, /*max_inner=*/0, allowed);
+    HWY_ASSERT(pools.NumOuter() == 2);
+    HWY_ASSERT((pools.LPs(0) == std::vector<size_t>{4}));
+    HWY_ASSERT((pools.LPs(1) == std::vector<size_t>{3, 5}));
+  }
+}
+
+#endif  // HWY_OS_LINUX
+
+// Outer workers (except the caller) are pinned to the first LP of their group.
+TEST(NestedPoolsTest, TestOuterPinned) {
+  if (HWY_ARCH_WASM) return;  // WASM threading is unreliable
+
+  std::vector<size_t> allowed;
+  if (!GetThreadAffinity(allowed)) return;
+  const Topology topology;
+  if (topology.Empty()) return;
+  NestedPools pools(topology, PoolGroup::kCluster, PinPolicy::kSkipSMT,
+                    /*max_outer=*/0, /*max_inner=*/0, allowed);
+  const size_t num_outer = pools.NumOuter();
+  pools.Outer().Run(0, num_outer, [&](uint64_t /*task*/, size_t outer) {
+    if (outer == num_outer - 1) return;  // caller is not pinned
+    std::vector<size_t> pinned;
+    HWY_ASSERT(GetThreadAffinity(pinned));
+    HWY_ASSERT(pinned == std::vector<size_t>{pools.LPs(outer)[0]});
+  });
+}
+
+}  // namespace
+}  // namespace hwy
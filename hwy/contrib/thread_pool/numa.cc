@@ -0,0 +1,161 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hwy/contrib/thread_pool/numa.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>  // malloc
+
+#include <vector>
+
+#include "hwy/base.h"
+#include "hwy/detect_compiler_arch.h"  // HWY_OS_LINUX
+
+#if HWY_OS_LINUX
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(SYS_mbind) && defined(SYS_set_mempolicy) && \
+    defined(SYS_get_mempolicy)
+#define HWY_NUMA_SYSCALLS 1
+#endif
+#endif  // HWY_OS_LINUX
+
+#ifndef HWY_NUMA_SYSCALLS
+#define HWY_NUMA_SYSCALLS 0
+#endif
+
+namespace hwy {
+
+#if HWY_NUMA_SYSCALLS
+namespace {
+
+// From linux/mempolicy.h, which is not always installed.
+constexpr int kMpolDefault = 0;
+constexpr int kMpolPreferred = 1;
+constexpr int kMpolBind = 2;
+constexpr int kMpolInterleave = 3;
+constexpr unsigned long kMpolFMemsAllowed = 1u << 2;  // NOLINT
+
+// Upper bound on the number of nodes; the kernel default is at most 1024.
+constexpr size_t kMaxNodes = 4096;
+constexpr size_t kBitsPerWord = sizeof(unsigned long) * 8;  // NOLINT
+
+// Node bitmask as expected by the syscalls.
+class NodeMask {
+ public:
+  NodeMask() : words_(kMaxNodes / kBitsPerWord, 0) {}
+
+  void Set(size_t node) {
+    words_[node / kBitsPerWord] |= 1ul << (node % kBitsPerWord);
+  }
+
+  unsigned long* Words() { return words_.data(); }  // NOLINT
+
+  // The kernel decrements this before use, hence +1.
+  unsigned long MaxNode() const {  // NOLINT
+    return static_cast<unsigned long>(kMaxNodes + 1);  // NOLINT
+  }
+
+ private:
+  std::vector<unsigned long> words_;  // NOLINT
+};
+
+// Stored in front of the payload so that NumaFree knows the mapping size.
+constexpr size_t kHeaderSize = 64;
+
+}  // namespace
+#endif  // HWY_NUMA_SYSCALLS
+
+HWY_CONTRIB_DLLEXPORT bool SetThreadPreferredNode(size_t node) {
+#if HWY_NUMA_SYSCALLS
+  if (node >= kMaxNodes) return false;
+  NodeMask mask;
+  mask.Set(node);
+  return syscall(SYS_set_mempolicy, kMpolPreferred, mask.Words(),
+                 mask.MaxNode()) == 0;
+#else
+  (void)node;
+  return false;
+#endif
+}
+
+HWY_CONTRIB_DLLEXPORT bool ResetThreadMemoryPolicy() {
+#if HWY_NUMA_SYSCALLS
+  return syscall(SYS_set_mempolicy, kMpolDefault, nullptr, 0) == 0;
+#else
+  return false;
+#endif
+}
+
+namespace detail {
+
+HWY_CONTRIB_DLLEXPORT void* NumaAlloc(void* opaque, size_t bytes) {
+#if HWY_NUMA_SYSCALLS
+  const size_t size = kHeaderSize + bytes;
+  void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapping == MAP_FAILED) return nullptr;
+
+  // Apply the policy before any page is touched. Failure is not fatal: the
+  // memory is still usable, just not placed as requested.
+  const uintptr_t policy = reinterpret_cast<uintptr_t>(opaque);
+  if (policy != kNumaDefault) {
+    NodeMask mask;
+    int mode = kMpolInterleave;
+    if (policy == kNumaInterleave) {
+      // All nodes this thread may allocate from.
+      int unused_mode;
+      if (syscall(SYS_get_mempolicy, &unused_mode, mask.Words(),
+                  mask.MaxNode(), nullptr, kMpolFMemsAllowed) != 0) {
+        mode = kMpolDefault;
+      }
+    } else if (policy < kMaxNodes) {
+      mode = kMpolBind;
+      mask.Set(static_cast<size_t>(policy));
+    } else {
+      mode = kMpolDefault;
+    }
+    if (mode != kMpolDefault) {
+      (void)syscall(SYS_mbind, mapping, size, mode, mask.Words(),
+                    mask.MaxNode(), 0);
+    }
+  }
+
+  uint8_t* header = static_cast<uint8_t*>(mapping);
+  CopyBytes<sizeof(size)>(&size, header);
+  return header + kHeaderSize;
+#else
+  (void)opaque;
+  return malloc(bytes);
+#endif
+}
+
+HWY_CONTRIB_DLLEXPORT void NumaFree(void* /*opaque*/, void* memory) {
+  if (memory == nullptr) return;
+#if HWY_NUMA_SYSCALLS
+  uint8_t* header = static_cast<uint8_t*>(memory) - kHeaderSize;
+  size_t size;
+  CopyBytes<sizeof(size)>(header, &size);
+  HWY_ASSERT(munmap(header, size) == 0);
+#else
+  free(memory);
+#endif
+}
+
+}  // namespace detail
+}  // namespace hwy
@@ -0,0 +1,118 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HIGHWAY_HWY_CONTRIB_THREAD_POOL_NUMA_H_
+#define HIGHWAY_HWY_CONTRIB_THREAD_POOL_NUMA_H_
+
+// NUMA-aware variants of AllocateAligned. On multi-socket systems, memory is
+// typically placed on the node of the thread that first writes it, hence
+// arrays partitioned across a ThreadPool are remote for some of the workers.
+// These functions instead control the placement via the Linux mbind and
+// set_mempolicy syscalls, without depending on libnuma. On other platforms or
+// if the kernel rejects the policy, they behave like AllocateAligned.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>  // memset
+
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
+
+namespace hwy {
+
+// Sets the memory policy of the calling thread such that its subsequent page
+// faults allocate from NUMA node `node` (OS index, see Topology::Nodes), or
+// other nodes if that one is full. Useful after pinning a worker. Returns
+// false if not supported.
+HWY_CONTRIB_DLLEXPORT bool SetThreadPreferredNode(size_t node);
+
+// Restores the default policy, i.e. allocating on the node of the LP on which
+// the page fault occurs. Returns false if not supported.
+HWY_CONTRIB_DLLEXPORT bool ResetThreadMemoryPolicy();
+
+namespace detail {
+
+// Values of the `opaque` argument of NumaAlloc other than a node index.
+constexpr uintptr_t kNumaDefault = ~uintptr_t{0};
+constexpr uintptr_t kNumaInterleave = ~uintptr_t{1};
+
+// AllocPtr and FreePtr for AllocateAligned. Returns freshly mapped pages, with
+// the policy given by `opaque`, which is not dereferenced.
+HWY_CONTRIB_DLLEXPORT void* NumaAlloc(void* opaque, size_t bytes);
+HWY_CONTRIB_DLLEXPORT void NumaFree(void* opaque, void* memory);
+
+template <typename T>
+AlignedFreeUniquePtr<T[]> AllocateAlignedNuma(size_t items, uintptr_t policy) {
+  void* opaque = reinterpret_cast<void*>(policy);
+  return AllocateAligned<T>(items, &NumaAlloc, &NumaFree, opaque);
+}
+
+}  // namespace detail
+
+// Allocates an uninitialized array whose pages all reside on NUMA node `node`
+// (OS index, see Topology::Nodes or LogicalProcessor::node).
+template <typename T>
+AlignedFreeUniquePtr<T[]> AllocateAlignedOnNode(size_t items, size_t node) {
+  return detail::AllocateAlignedNuma<T>(items, static_cast<uintptr_t>(node));
+}
+
+// Allocates an uninitialized array whose pages are distributed round-robin
+// across all NUMA nodes. This balances the bandwidth of data accessed by all
+// workers, e.g. a shared input, at the cost of mostly remote accesses.
+template <typename T>
+AlignedFreeUniquePtr<T[]> AllocateAlignedInterleaved(size_t items) {
+  return detail::AllocateAlignedNuma<T>(items, detail::kNumaInterleave);
+}
+
+// Allocates a zero-initialized array and attempts to have each part first
+// written by the `pool` worker that will access it, so that it resides on that
+// worker's NUMA node. Task `t` initializes the t-th of `pool.NumWorkers()`
+// contiguous page-aligned ranges. `ThreadPool::Run` usually runs task `t` on
+// worker `t`, but a worker may also take tasks of others, so the placement is
+// only best-effort; the contents are zero regardless. This is only helpful if
+// the pool is pinned. Note that the main thread is also a worker, and that the
+// first page, which begins with an allocation header, is always first written
+// by the calling thread.
+template <typename T>
+AlignedFreeUniquePtr<T[]> AllocateAlignedFirstTouch(size_t items,
+                                                    ThreadPool& pool) {
+  AlignedFreeUniquePtr<T[]> array =
+      detail::AllocateAlignedNuma<T>(items, detail::kNumaDefault);
+  if (!array) return array;
+
+  constexpr size_t kPageSize = 4096;
+  uint8_t* bytes = reinterpret_cast<uint8_t*>(array.get());
+  const size_t total = items * sizeof(T);
+  const size_t num_workers = pool.NumWorkers();
+  // Range boundaries other than 0 and `total` are at page boundaries.
+  const size_t misalign = reinterpret_cast<uintptr_t>(bytes) % kPageSize;
+  const size_t per_worker =
+      RoundUpTo(DivCeil(total + misalign, num_workers), kPageSize);
+  const auto boundary = [=](size_t t) -> size_t {
+    return t == 0 ? 0 : HWY_MIN(t * per_worker - misalign, total);
+  };
+  // One task per worker, which ThreadPool::Run usually runs on worker `t`.
+  pool.Run(0, num_workers, [&](uint64_t task, size_t /*thread*/) {
+    const size_t begin = boundary(static_cast<size_t>(task));
+    const size_t end = boundary(static_cast<size_t>(task) + 1);
+    memset(bytes + begin, 0, end - begin);
+  });
+  return array;
+}
+
+}  // namespace hwy
+
+#endif  // HIGHWAY_HWY_CONTRIB_THREAD_POOL_NUMA_H_
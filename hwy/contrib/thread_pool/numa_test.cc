@@ -0,0 +1,92 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hwy/contrib/thread_pool/numa.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "hwy/aligned_allocator.h"
+#include "hwy/base.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
+#include "hwy/contrib/thread_pool/topology.h"
+#include "hwy/detect_compiler_arch.h"  // HWY_ARCH_WASM
+
+namespace hwy {
+namespace {
+
+std::vector<size_t> Nodes() {
+  std::vector<size_t> nodes = Topology().Nodes();
+  if (nodes.empty()) nodes.push_back(0);
+  return nodes;
+}
+
+template <class Array>
+void VerifyWritable(const Array& array, size_t items) {
+  HWY_ASSERT(array);
+  HWY_ASSERT(IsAligned(array.get()));
+  for (size_t i = 0; i < items; ++i) array[i] = static_cast<uint32_t>(i * 3);
+  for (size_t i = 0; i < items; ++i) {
+    HWY_ASSERT(array[i] == static_cast<uint32_t>(i * 3));
+  }
+}
+
+TEST(NumaTest, TestOnNode) {
+  for (size_t node : Nodes()) {
+    for (size_t items : {size_t{1}, size_t{1000}, size_t{300000}}) {
+      VerifyWritable(AllocateAlignedOnNode<uint32_t>(items, node), items);
+    }
+  }
+}
+
+TEST(NumaTest, TestInterleaved) {
+  for (size_t items : {size_t{1}, size_t{1000}, size_t{300000}}) {
+    VerifyWritable(AllocateAlignedInterleaved<uint32_t>(items), items);
+  }
+}
+
+TEST(NumaTest, TestFirstTouch) {
+  if (HWY_ARCH_WASM) return;  // WASM threading is unreliable
+
+  for (size_t num_threads = 0; num_threads <= 4; ++num_threads) {
+    ThreadPool pool(HWY_MIN(ThreadPool::MaxThreads(), num_threads));
+    for (size_t items : {size_t{1}, size_t{1023}, size_t{1024},
+                         size_t{5 * 1024 + 3}, size_t{100000}}) {
+      AlignedFreeUniquePtr<uint32_t[]> array =
+          AllocateAlignedFirstTouch<uint32_t>(items, pool);
+      HWY_ASSERT(array);
+      for (size_t i = 0; i < items; ++i) HWY_ASSERT(array[i] == 0);
+      VerifyWritable(array, items);
+    }
+  }
+}
+
+// Uses a separate thread to avoid changing the policy of the main thread.
+TEST(NumaTest, TestThreadPolicy) {
+  const size_t node = Nodes()[0];
+  std::thread thread([node]() {
+    if (!SetThreadPreferredNode(node)) return;  // not supported
+    VerifyWritable(AllocateAligned<uint32_t>(100000), 100000);
+    HWY_ASSERT(ResetThreadMemoryPolicy());
+  });
+  thread.join();
+}
+
+}  // namespace
+}  // namespace hwy
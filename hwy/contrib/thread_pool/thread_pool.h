@@ -30,12 +30,19 @@
 // IWYU pragma: end_exports
 
 #include <atomic>
+#include <new>  // placement new
 #include <vector>
 
 #include "hwy/aligned_allocator.h"  // HWY_ALIGNMENT
 #include "hwy/base.h"
 #include "hwy/cache_control.h"  // Pause
 #include "hwy/contrib/thread_pool/futex.h"
+#include "hwy/contrib/thread_pool/topology.h"
+
+#if HWY_OS_LINUX
+#include <sys/syscall.h>  // SYS_sched_setaffinity
+#include <unistd.h>       // syscall
+#endif
 
 // Temporary NOINLINE for profiling.
 #define HWY_POOL_INLINE HWY_NOINLINE
@@ -505,6 +512,30 @@ static inline void SetThreadName(const char* format, int thread) {
 #endif
 }
 
+namespace detail {
+
+// Same as PinThreadToLogicalProcessor, but defined here so that ThreadPool
+// remains header-only and does not require linking topology.cc. Uses the
+// syscall because the CPU_SET macros require _GNU_SOURCE.
+static inline bool PinCurrentThread(size_t lp) {
+#if HWY_OS_LINUX && defined(SYS_sched_setaffinity)
+  using Word = unsigned long;  // NOLINT
+  constexpr size_t kBitsPerWord = sizeof(Word) * 8;
+  if (lp >= 64 * 1024) return false;
+  // The kernel zero-extends masks smaller than its own.
+  std::vector<Word> mask(lp / kBitsPerWord + 1, 0);
+  mask[lp / kBitsPerWord] |= Word{1} << (lp % kBitsPerWord);
+  // pid 0 refers to the calling thread.
+  return syscall(SYS_sched_setaffinity, 0, mask.size() * sizeof(Word),
+                 mask.data()) == 0;
+#else
+  (void)lp;
+  return false;
+#endif
+}
+
+}  // namespace detail
+
 // Highly efficient parallel-for, intended for workloads with thousands of
 // fork-join regions which consist of calling tasks[t](i) for a few hundred i,
 // using dozens of threads.
@@ -523,9 +554,15 @@ static inline void SetThreadName(const char* format, int thread) {
 //
 // For load-balancing, we use work stealing in random order.
 class ThreadPool {
-  static void ThreadFunc(size_t thread, size_t num_workers, PoolMem* mem) {
+  // Value of ThreadFunc's `lp` if the thread should not be pinned.
+  static constexpr size_t kNoLP = ~size_t{0};
+
+  static void ThreadFunc(size_t thread, size_t num_workers, PoolMem* mem,
+                         size_t lp) {
     HWY_DASSERT(thread < num_workers);
     SetThreadName("worker%03zu", static_cast<int>(thread));
+    // Best-effort: if the OS rejects `lp`, the worker still runs, unpinned.
+    if (lp != kNoLP) (void)detail::PinCurrentThread(lp);
 
     // Ensure mem is ready to use (synchronize with PoolMemOwner's fence).
     std::atomic_thread_fence(std::memory_order_acquire);
@@ -561,7 +598,17 @@ class ThreadPool {
   // `num_threads` should not exceed `MaxThreads()`. If `num_threads` <= 1,
   // Run() runs only on the main thread. Otherwise, we launch `num_threads - 1`
   // threads because the main thread also participates.
-  explicit ThreadPool(size_t num_threads) : owner_(num_threads) {
+  explicit ThreadPool(size_t num_threads)
+      : ThreadPool(num_threads, std::vector<size_t>()) {}
+
+  // As above, but pins each worker thread `t` to the logical processor with OS
+  // index `lps[t % lps.size()]`, e.g. from Topology::LPsForPinning. This
+  // prevents migrations across clusters and sockets, which otherwise cause
+  // noisy fork-join latency. The main thread, which calls Run and also performs
+  // tasks, is not pinned; callers may pin it to `lps[num_threads - 1]` via
+  // PinThreadToLogicalProcessor. Does not pin if `lps` is empty.
+  ThreadPool(size_t num_threads, const std::vector<size_t>& lps)
+      : owner_(num_threads) {
     (void)busy_;  // unused in non-debug builds, avoid warning
     const size_t num_workers = owner_.NumWorkers();
 
@@ -569,7 +616,8 @@ class ThreadPool {
     // PoolCommands once ready.
     threads_.reserve(num_workers - 1);
     for (size_t thread = 0; thread < num_workers - 1; ++thread) {
-      threads_.emplace_back(ThreadFunc, thread, num_workers, owner_.Mem());
+      const size_t lp = lps.empty() ? kNoLP : lps[thread % lps.size()];
+      threads_.emplace_back(ThreadFunc, thread, num_workers, owner_.Mem(), lp);
     }
   }
 
@@ -680,6 +728,86 @@ class ThreadPool {
   std::atomic<int> busy_{0};
 };
 
+// One `T` per worker, each starting at a multiple of HWY_ALIGNMENT bytes, like
+// PoolWorker. This avoids false sharing when workers update their own
+// instance, e.g. accumulators, which is slow for adjacent vector elements.
+template <typename T>
+class PerWorker {
+  static constexpr size_t kStride = RoundUpTo(sizeof(T), HWY_ALIGNMENT);
+
+ public:
+  PerWorker(size_t num_workers, const T& init)
+      : num_workers_(num_workers),
+        bytes_(hwy::AllocateAligned<uint8_t>(num_workers * kStride)) {
+    HWY_ASSERT(bytes_);
+    for (size_t worker = 0; worker < num_workers_; ++worker) {
+      new (bytes_.get() + worker * kStride) T(init);
+    }
+  }
+
+  ~PerWorker() {
+    for (size_t worker = 0; worker < num_workers_; ++worker) {
+      (*this)[worker].~T();
+    }
+  }
+
+  PerWorker(const PerWorker&) = delete;
+  PerWorker& operator=(const PerWorker&) = delete;
+
+  size_t NumWorkers() const { return num_workers_; }
+
+  T& operator[](size_t worker) {
+    HWY_DASSERT(worker < num_workers_);
+    return *reinterpret_cast<T*>(bytes_.get() + worker * kStride);
+  }
+  const T& operator[](size_t worker) const {
+    HWY_DASSERT(worker < num_workers_);
+    return *reinterpret_cast<const T*>(bytes_.get() + worker * kStride);
+  }
+
+ private:
+  size_t num_workers_;
+  AlignedFreeUniquePtr<uint8_t[]> bytes_;
+};
+
+// Reduces `[begin, end)` to a single `T`. Task `w`, which any worker may run,
+// calls `func(range_begin, range_end, acc)` once with the w-th of
+// `NumWorkers()` equal-sized contiguous subranges and its own `T& acc`, which
+// is initialized to `identity` and resides in a PerWorker. Then returns
+// `combine(...combine(combine(identity, acc_0), acc_1)..., acc_{W-1})`.
+//
+// Unlike `Run`, this does not balance the load, but because the subranges only
+// depend on `NumWorkers()` and are combined in task order, floating-point
+// results are reproducible from run to run. `func` is also not called for
+// every index, which allows vectorizing the loop within a subrange.
+template <typename T, class Func, class Combine>
+T ParallelReduce(ThreadPool& pool, uint64_t begin, uint64_t end,
+                 const T& identity, const Func& func, const Combine& combine) {
+  HWY_DASSERT(begin <= end);
+  const size_t num_workers = pool.NumWorkers();
+  PerWorker<T> accumulators(num_workers, identity);
+  // As in ParallelFor::Plan, the first `remainder` subranges are one larger.
+  const uint64_t min_size = (end - begin) / num_workers;
+  const uint64_t remainder = (end - begin) % num_workers;
+  // One task per worker. Using the task rather than thread index for the
+  // subrange and accumulator guarantees the above order, even if the pool
+  // were to assign tasks differently.
+  pool.Run(0, num_workers, [&](uint64_t task, size_t /*thread*/) {
+    const uint64_t range_begin =
+        begin + min_size * task + HWY_MIN(task, remainder);
+    const uint64_t range_end = range_begin + min_size + (task < remainder);
+    if (range_begin != range_end) {
+      func(range_begin, range_end, accumulators[static_cast<size_t>(task)]);
+    }
+  });
+
+  T result = identity;
+  for (size_t worker = 0; worker < num_workers; ++worker) {
+    result = combine(result, accumulators[worker]);
+  }
+  return result;
+}
+
 }  // namespace hwy
 
 #endif  // HIGHWAY_HWY_CONTRIB_THREAD_POOL_THREAD_POOL_H_
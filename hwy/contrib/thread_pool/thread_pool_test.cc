@@ -394,5 +394,67 @@ TEST(ThreadPoolTest, TestCounter) {
   }
 }
 
+TEST(ThreadPoolTest, TestPerWorker) {
+  PerWorker<uint32_t> per_worker(5, 7u);
+  HWY_ASSERT_EQ(size_t{5}, per_worker.NumWorkers());
+  for (size_t worker = 0; worker < 5; ++worker) {
+    HWY_ASSERT_EQ(7u, per_worker[worker]);
+    HWY_ASSERT(IsAligned(&per_worker[worker]));
+  }
+}
+
+// Sums reciprocals, which is sensitive to the order of additions.
+float SumReduce(ThreadPool& pool, uint64_t begin, uint64_t end) {
+  return ParallelReduce(
+      pool, begin, end, 0.0f,
+      [](uint64_t range_begin, uint64_t range_end, float& acc) {
+        for (uint64_t i = range_begin; i < range_end; ++i) {
+          acc += 1.0f / static_cast<float>(i + 1);
+        }
+      },
+      [](float a, float b) { return a + b; });
+}
+
+TEST(ThreadPoolTest, TestParallelReduce) {
+  if (HWY_ARCH_WASM) return;  // WASM threading is unreliable
+
+  for (size_t num_threads = 0; num_threads <= 5; ++num_threads) {
+    ThreadPool pool(num_threads);
+    for (uint64_t begin : {uint64_t{0}, uint64_t{3}}) {
+      for (uint64_t size : {uint64_t{0}, uint64_t{1}, uint64_t{4},
+                            uint64_t{1000}, uint64_t{100003}}) {
+        const uint64_t end = begin + size;
+
+        // Each index is visited exactly once.
+        std::vector<uint8_t> visited(static_cast<size_t>(end));
+        const uint64_t sum = ParallelReduce(
+            pool, begin, end, uint64_t{0},
+            [&](uint64_t range_begin, uint64_t range_end, uint64_t& acc) {
+              HWY_ASSERT(begin <= range_begin && range_begin < range_end &&
+                         range_end <= end);
+              for (uint64_t i = range_begin; i < range_end; ++i) {
+                visited[static_cast<size_t>(i)]++;
+                acc += i;
+              }
+            },
+            [](uint64_t a, uint64_t b) { return a + b; });
+        HWY_ASSERT_EQ((begin + end - 1) * size / 2, sum);
+        for (uint64_t i = begin; i < end; ++i) {
+          HWY_ASSERT_EQ(1, visited[static_cast<size_t>(i)]);
+        }
+
+        // Floating-point results are reproducible, also with spinning.
+        const float expected = SumReduce(pool, begin, end);
+        for (size_t rep = 0; rep < 20; ++rep) {
+          pool.SetWaitMode((rep & 1) ? PoolWaitMode::kSpin
+                                     : PoolWaitMode::kBlock);
+          HWY_ASSERT(expected == SumReduce(pool, begin, end));
+        }
+        pool.SetWaitMode(PoolWaitMode::kBlock);
+      }
+    }
+  }
+}
+
 }  // namespace
 }  // namespace hwy
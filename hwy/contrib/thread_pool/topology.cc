@@ -0,0 +1,293 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE  // CPU_SET etc. Must precede any include.
+#endif
+
+#include "hwy/contrib/thread_pool/topology.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>  // strtoul
+#include <string.h>  // strncmp
+
+#include <algorithm>  // std::sort
+#include <string>
+#include <vector>
+
+#include "hwy/base.h"
+#include "hwy/detect_compiler_arch.h"  // HWY_OS_LINUX
+
+#if HWY_OS_LINUX
+#include <dirent.h>
+#include <errno.h>
+#include <sched.h>
+#endif
+
+namespace hwy {
+
+#if HWY_OS_LINUX
+namespace {
+
+// Upper bound on the number of LPs for which we query the affinity mask.
+constexpr size_t kMaxAffinityLPs = 64 * 1024;
+
+// Returns the file contents without trailing whitespace, or false.
+bool ReadFile(const std::string& path, std::string& contents) {
+  FILE* f = fopen(path.c_str(), "r");
+  if (f == nullptr) return false;
+  contents.clear();
+  char buf[256];
+  size_t bytes_read;
+  while ((bytes_read = fread(buf, 1, sizeof(buf), f)) != 0) {
+    contents.append(buf, bytes_read);
+  }
+  fclose(f);
+  while (!contents.empty() && contents.back() <= ' ') contents.pop_back();
+  return !contents.empty();
+}
+
+bool ReadNumber(const std::string& path, size_t& number) {
+  std::string contents;
+  if (!ReadFile(path, contents)) return false;
+  char* end;
+  const long value = strtol(contents.c_str(), &end, 10);  // NOLINT
+  if (*end != '\0') return false;
+  // Some VMs report -1 for the package; treat that as the only package.
+  number = value < 0 ? 0 : static_cast<size_t>(value);
+  return true;
+}
+
+// Parses the sysfs list format, e.g. "0-3,8,10-11", into ascending indices.
+bool ParseList(const std::string& list, std::vector<size_t>& indices) {
+  indices.clear();
+  const char* pos = list.c_str();
+  while (*pos != '\0') {
+    char* end;
+    const size_t first = static_cast<size_t>(strtoul(pos, &end, 10));
+    if (end == pos) return false;
+    size_t last = first;
+    pos = end;
+    if (*pos == '-') {
+      last = static_cast<size_t>(strtoul(pos + 1, &end, 10));
+      if (end == pos + 1 || last < first) return false;
+      pos = end;
+    }
+    for (size_t i = first; i <= last; ++i) indices.push_back(i);
+    if (*pos == ',') ++pos;
+  }
+  std::sort(indices.begin(), indices.end());
+  return !indices.empty();
+}
+
+bool ReadList(const std::string& path, std::vector<size_t>& indices) {
+  std::string contents;
+  return ReadFile(path, contents) && ParseList(contents, indices);
+}
+
+// The kernel creates a `nodeN` link in each CPU directory; there is no file
+// containing just N. Returns false if not found.
+bool ReadNode(const std::string& cpu, size_t& node) {
+  DIR* dir = opendir(cpu.c_str());
+  if (dir == nullptr) return false;
+  bool found = false;
+  while (const dirent* entry = readdir(dir)) {
+    const char* name = entry->d_name;
+    if (strncmp(name, "node", 4) != 0 || name[4] < '0' || name[4] > '9') {
+      continue;
+    }
+    char* end;
+    node = static_cast<size_t>(strtoul(name + 4, &end, 10));
+    if (*end == '\0') {
+      found = true;
+      break;
+    }
+  }
+  closedir(dir);
+  return found;
+}
+
+// Replaces each of `keys` with its rank among the unique `keys` and returns
+// the number of unique keys.
+size_t DenseRanks(std::vector<size_t>& keys) {
+  std::vector<size_t> unique = keys;
+  std::sort(unique.begin(), unique.end());
+  unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+  for (size_t& key : keys) {
+    key = static_cast<size_t>(
+        std::lower_bound(unique.begin(), unique.end(), key) - unique.begin());
+  }
+  return unique.size();
+}
+
+}  // namespace
+#endif  // HWY_OS_LINUX
+
+HWY_CONTRIB_DLLEXPORT bool PinThreadToLogicalProcessor(size_t lp) {
+#if HWY_OS_LINUX
+  if (lp >= kMaxAffinityLPs) return false;
+  const size_t num_lps = HWY_MAX(lp + 1, size_t{CPU_SETSIZE});
+  cpu_set_t* set = CPU_ALLOC(num_lps);
+  if (set == nullptr) return false;
+  const size_t size = CPU_ALLOC_SIZE(num_lps);
+  CPU_ZERO_S(size, set);
+  CPU_SET_S(lp, size, set);
+  // pid 0 refers to the calling thread.
+  const int err = sched_setaffinity(0, size, set);
+  CPU_FREE(set);
+  return err == 0;
+#else
+  (void)lp;
+  return false;
+#endif
+}
+
+HWY_CONTRIB_DLLEXPORT bool GetThreadAffinity(std::vector<size_t>& lps) {
+  lps.clear();
+#if HWY_OS_LINUX
+  // The kernel rejects masks smaller than its own, so retry with larger ones.
+  for (size_t num_lps = CPU_SETSIZE; num_lps <= kMaxAffinityLPs;
+       num_lps *= 2) {
+    cpu_set_t* set = CPU_ALLOC(num_lps);
+    if (set == nullptr) return false;
+    const size_t size = CPU_ALLOC_SIZE(num_lps);
+    CPU_ZERO_S(size, set);
+    if (sched_getaffinity(0, size, set) == 0) {
+      for (size_t lp = 0; lp < num_lps; ++lp) {
+        if (CPU_ISSET_S(lp, size, set)) lps.push_back(lp);
+      }
+      CPU_FREE(set);
+      return true;
+    }
+    CPU_FREE(set);
+    if (errno != EINVAL) return false;
+  }
+#endif
+  return false;
+}
+
+Topology::Topology() {
+#if HWY_OS_LINUX
+  Detect("/sys/devices/system/cpu");
+#endif
+}
+
+Topology::Topology(const char* sysfs_cpu_dir) { Detect(sysfs_cpu_dir); }
+
+void Topology::Detect(const char* sysfs_cpu_dir) {
+#if HWY_OS_LINUX
+  const std::string dir(sysfs_cpu_dir);
+  std::vector<size_t> online;
+  if (!ReadList(dir + "/online", online)) return;
+
+  // Per LP: keys that are unique per package/cluster/core, later made dense.
+  std::vector<size_t> packages, clusters, cores;
+  std::vector<size_t> siblings, shared;
+  std::string level;
+  lps_.clear();
+  nodes_.clear();
+  lps_.reserve(online.size());
+  for (size_t lp : online) {
+    const std::string cpu = dir + "/cpu" + std::to_string(lp);
+    size_t package;
+    if (!ReadNumber(cpu + "/topology/physical_package_id", package)) {
+      package = 0;
+    }
+
+    // A core is identified by its first LP; the others are its SMT siblings.
+    size_t core = lp;
+    size_t smt = 0;
+    if (ReadList(cpu + "/topology/thread_siblings_list", siblings)) {
+      core = siblings[0];
+      smt = static_cast<size_t>(
+          std::lower_bound(siblings.begin(), siblings.end(), lp) -
+          siblings.begin());
+    }
+
+    // A cluster is identified by the first LP sharing its L3, if any.
+    // Otherwise, the package is the cluster; offset to avoid collisions.
+    size_t cluster = ~size_t{0} - package;
+    for (size_t index = 0; index < 10; ++index) {
+      const std::string cache = cpu + "/cache/index" + std::to_string(index);
+      if (!ReadFile(cache + "/level", level)) break;
+      if (level == "3" && ReadList(cache + "/shared_cpu_list", shared)) {
+        cluster = shared[0];
+        break;
+      }
+    }
+
+    size_t node;
+    if (!ReadNode(cpu, node)) node = 0;
+    nodes_.push_back(node);
+
+    lps_.push_back(LogicalProcessor{lp, 0, 0, 0, smt, node});
+    packages.push_back(package);
+    clusters.push_back(cluster);
+    cores.push_back(core);
+  }
+
+  std::sort(nodes_.begin(), nodes_.end());
+  nodes_.erase(std::unique(nodes_.begin(), nodes_.end()), nodes_.end());
+  num_packages_ = DenseRanks(packages);
+  num_clusters_ = DenseRanks(clusters);
+  num_cores_ = DenseRanks(cores);
+  for (size_t i = 0; i < lps_.size(); ++i) {
+    lps_[i].package = packages[i];
+    lps_[i].cluster = clusters[i];
+    lps_[i].core = cores[i];
+  }
+#else
+  (void)sysfs_cpu_dir;
+#endif
+}
+
+std::vector<size_t> Topology::LPsForPinning(
+    PinPolicy policy, const std::vector<size_t>& allowed) const {
+  std::vector<size_t> sorted_allowed = allowed;
+  std::sort(sorted_allowed.begin(), sorted_allowed.end());
+
+  // Rank among the allowed LPs of the same core, so that skipping SMT still
+  // uses a core whose first LP is not allowed.
+  std::vector<size_t> num_per_core(num_cores_, 0);
+  std::vector<LogicalProcessor> candidates;
+  for (const LogicalProcessor& lp : lps_) {
+    if (!sorted_allowed.empty() &&
+        !std::binary_search(sorted_allowed.begin(), sorted_allowed.end(),
+                            lp.lp)) {
+      continue;
+    }
+    LogicalProcessor candidate = lp;
+    candidate.smt = num_per_core[lp.core]++;
+    if (policy == PinPolicy::kSkipSMT && candidate.smt != 0) continue;
+    candidates.push_back(candidate);
+  }
+
+  std::sort(candidates.begin(), candidates.end(),
+            [](const LogicalProcessor& a, const LogicalProcessor& b) {
+              if (a.smt != b.smt) return a.smt < b.smt;
+              if (a.package != b.package) return a.package < b.package;
+              if (a.cluster != b.cluster) return a.cluster < b.cluster;
+              if (a.core != b.core) return a.core < b.core;
+              return a.lp < b.lp;
+            });
+
+  std::vector<size_t> result;
+  result.reserve(candidates.size());
+  for (const LogicalProcessor& lp : candidates) result.push_back(lp.lp);
+  return result;
+}
+
+}  // namespace hwy
@@ -0,0 +1,102 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef HIGHWAY_HWY_CONTRIB_THREAD_POOL_TOPOLOGY_H_
+#define HIGHWAY_HWY_CONTRIB_THREAD_POOL_TOPOLOGY_H_
+
+// CPU topology detection and thread affinity. A logical processor (LP, also
+// known as hardware thread) is what the OS schedules threads on; there may be
+// several per core (SMT), and cores are grouped into clusters which share an
+// L3 cache, and packages (sockets).
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "hwy/base.h"  // HWY_CONTRIB_DLLEXPORT
+
+namespace hwy {
+
+// Pins the calling thread to the logical processor with OS index `lp`. Returns
+// false if not supported on this platform or the OS rejected the request, e.g.
+// because `lp` is not in the process's allowed set.
+HWY_CONTRIB_DLLEXPORT bool PinThreadToLogicalProcessor(size_t lp);
+
+// Replaces `lps` with the ascending OS indices of the logical processors on
+// which the calling thread may run. Returns false if not supported, in which
+// case `lps` is empty.
+HWY_CONTRIB_DLLEXPORT bool GetThreadAffinity(std::vector<size_t>& lps);
+
+struct LogicalProcessor {
+  size_t lp;       // OS index, as passed to PinThreadToLogicalProcessor.
+  size_t package;  // All of the following are dense indices starting at 0.
+  size_t cluster;  // Unique across packages, in the order of their first LP.
+  size_t core;     // Unique across packages and clusters.
+  size_t smt;      // 0 for the first LP of a core, 1 for its sibling etc.
+  size_t node;     // OS index of the NUMA node, as passed to mbind; else 0.
+};
+
+// Which logical processors LPsForPinning returns.
+enum class PinPolicy {
+  kAllLPs,   // All, including SMT siblings (after all first LPs of cores).
+  kSkipSMT,  // Only the first LP of each core, which avoids sharing its caches
+             // and execution units with another worker.
+};
+
+class HWY_CONTRIB_DLLEXPORT Topology {
+ public:
+  // Detects the topology of the logical processors that are online. On Linux,
+  // this parses /sys/devices/system/cpu. Otherwise, or if that fails, Empty().
+  Topology();
+
+  // As above, but reads from `sysfs_cpu_dir` instead, which has the same
+  // layout as /sys/devices/system/cpu. Used for testing.
+  explicit Topology(const char* sysfs_cpu_dir);
+
+  bool Empty() const { return lps_.empty(); }
+
+  // Sorted by ascending OS index.
+  const std::vector<LogicalProcessor>& LPs() const { return lps_; }
+
+  size_t NumPackages() const { return num_packages_; }
+  size_t NumClusters() const { return num_clusters_; }
+  size_t NumCores() const { return num_cores_; }
+
+  // Ascending OS indices of the NUMA nodes containing any of LPs(), or {0} if
+  // the kernel does not report nodes. Empty if Empty().
+  const std::vector<size_t>& Nodes() const { return nodes_; }
+
+  // Returns OS indices of logical processors for pinning ThreadPool workers,
+  // limited to those in `allowed` unless it is empty. Consecutive entries
+  // share a cluster where possible, so that workers with adjacent task ranges
+  // also share the L3. With kAllLPs, SMT siblings only follow after the first
+  // LP of every core, hence a prefix of the result also avoids sharing cores.
+  std::vector<size_t> LPsForPinning(
+      PinPolicy policy,
+      const std::vector<size_t>& allowed = std::vector<size_t>()) const;
+
+ private:
+  void Detect(const char* sysfs_cpu_dir);
+
+  std::vector<LogicalProcessor> lps_;
+  std::vector<size_t> nodes_;
+  size_t num_packages_ = 0;
+  size_t num_clusters_ = 0;
+  size_t num_cores_ = 0;
+};
+
+}  // namespace hwy
+
+#endif  // HIGHWAY_HWY_CONTRIB_THREAD_POOL_TOPOLOGY_H_
@@ -0,0 +1,234 @@
+// Copyright 2024 Google LLC
+// SPDX-License-Identifier: Apache-2.0
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "hwy/contrib/thread_pool/topology.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>  // mkdtemp
+
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "hwy/base.h"
+#include "hwy/contrib/thread_pool/thread_pool.h"
+#include "hwy/detect_compiler_arch.h"  // HWY_OS_LINUX
+
+#if HWY_OS_LINUX
+#include <sys/stat.h>  // mkdir
+#endif
+
+namespace hwy {
+namespace {
+
+#if HWY_OS_LINUX
+
+// Creates a directory tree with the same layout as /sys/devices/system/cpu and
+// removes it when destroyed.
+class FakeSysfs {
+ public:
+  FakeSysfs() {
+    char templ[] = "/tmp/hwy_topology_XXXXXX";
+    HWY_ASSERT(mkdtemp(templ) != nullptr);
+    dir_ = templ;
+    paths_.push_back(dir_);
+  }
+
+  ~FakeSysfs() {
+    // Children were created after their parents.
+    for (size_t i = paths_.size(); i != 0; --i) {
+      (void)remove(paths_[i - 1].c_str());
+    }
+  }
+
+  const char* Dir() const { return dir_.c_str(); }
+
+  void AddDir(const std::string& rel) {
+    const std::string path = dir_ + "/" + rel;
+    HWY_ASSERT(mkdir(path.c_str(), 0700) == 0);
+    paths_.push_back(path);
+  }
+
+  void AddFile(const std::string& rel, const std::string& contents) {
+    const std::string path = dir_ + "/" + rel;
+    FILE* f = fopen(path.c_str(), "w");
+    HWY_ASSERT(f != nullptr);
+    HWY_ASSERT(fwrite(contents.data(), 1, contents.size(), f) ==
+               contents.size());
+    HWY_ASSERT(fclose(f) == 0);
+    paths_.push_back(path);
+  }
+
+ private:
+  std::string dir_;
+  std::vector<std::string> paths_;
+};
+
+// Two packages, each with two L3 clusters of two cores with two LPs each.
+// Each package is a NUMA node. As on x86, LP i and i + 8 are SMT siblings.
+void AddTwoSocketTopology(FakeSysfs& sysfs) {
+  constexpr size_t kCores = 8;
+  sysfs.AddFile("online", "0-15\n");
+  for (size_t lp = 0; lp < 2 * kCores; ++lp) {
+    const size_t core = lp % kCores;
+    const size_t first = core & ~size_t{1};  // first core of the cluster
+    const std::string cpu = "cpu" + std::to_string(lp);
+    sysfs.AddDir(cpu);
+    sysfs.AddDir(cpu + "/node" + std::to_string(core / 4));
+    sysfs.AddDir(cpu + "/topology");
+    sysfs.AddFile(cpu + "/topology/physical_package_id",
+                  std::to_string(core / 4) + "\n");
+    sysfs.AddFile(cpu + "/topology/thread_siblings_list",
+                  std::to_string(core) + "," + std::to_string(core + kCores) +
+                      "\n");
+    sysfs.AddDir(cpu + "/cache");
+    const char* levels[3] = {"1", "2", "3"};
+    for (size_t index = 0; index < 3; ++index) {
+      const std::string cache = cpu + "/cache/index" + std::to_string(index);
+      sysfs.AddDir(cache);
+      sysfs.AddFile(cache + "/level", std::string(levels[index]) + "\n");
+      sysfs.AddFile(cache + "/shared_cpu_list",
+                    std::to_string(first) + "-" + std::to_string(first + 1) +
+                        "," + std::to_string(first + kCores) + "-" +
+                        std::to_string(first + kCores + 1) + "\n");
+    }
+  }
+}
+
+TEST(TopologyTest, TestFakeSysfs) {
+  FakeSysfs sysfs;
+  AddTwoSocketTopology(sysfs);
+  const Topology topology(sysfs.Dir());
+  HWY_ASSERT(!topology.Empty());
+  HWY_ASSERT(16 == topology.LPs().size());
+  HWY_ASSERT(2 == topology.NumPackages());
+  HWY_ASSERT(4 == topology.NumClusters());
+  HWY_ASSERT(8 == topology.NumCores());
+  HWY_ASSERT((std::vector<size_t>{0, 1}) == topology.Nodes());
+
+  const LogicalProcessor& lp13 = topology.LPs()[13];
+  HWY_ASSERT(13 == lp13.lp);
+  HWY_ASSERT(1 == lp13.package);
+  HWY_ASSERT(2 == lp13.cluster);
+  HWY_ASSERT(5 == lp13.core);
+  HWY_ASSERT(1 == lp13.smt);
+  HWY_ASSERT(1 == lp13.node);
+
+  std::vector<size_t> expected;
+  for (size_t lp = 0; lp < 8; ++lp) expected.push_back(lp);
+  HWY_ASSERT(expected == topology.LPsForPinning(PinPolicy::kSkipSMT));
+  for (size_t lp = 8; lp < 16; ++lp) expected.push_back(lp);
+  HWY_ASSERT(expected == topology.LPsForPinning(PinPolicy::kAllLPs));
+
+  // LP 10 is the first allowed LP of its core, hence not skipped. LP 10 and 3
+  // share a cluster, which precedes SMT siblings.
+  const std::vector<size_t> allowed = {1, 3, 9, 10, 11};
+  HWY_ASSERT((std::vector<size_t>{1, 10, 3}) ==
+             topology.LPsForPinning(PinPolicy::kSkipSMT, allowed));
+  HWY_ASSERT((std::vector<size_t>{1, 10, 3, 9, 11}) ==
+             topology.LPsForPinning(PinPolicy::kAllLPs, allowed));
+}
+
+// Missing cache and package information: each package is one cluster.
+TEST(TopologyTest, TestMissingFiles) {
+  FakeSysfs sysfs;
+  sysfs.AddFile("online", "0,2-3\n");
+  for (size_t lp : {size_t{0}, size_t{2}, size_t{3}}) {
+    const std::string cpu = "cpu" + std::to_string(lp);
+    sysfs.AddDir(cpu);
+    sysfs.AddDir(cpu + "/topology");
+    sysfs.AddFile(cpu + "/topology/thread_siblings_list",
+                  lp == 0 ? "0\n" : "2-3\n");
+  }
+  const Topology topology(sysfs.Dir());
+  HWY_ASSERT(3 == topology.LPs().size());
+  HWY_ASSERT(1 == topology.NumPackages());
+  HWY_ASSERT(1 == topology.NumClusters());
+  HWY_ASSERT(2 == topology.NumCores());
+  HWY_ASSERT((std::vector<size_t>{0}) == topology.Nodes());
+  HWY_ASSERT((std::vector<size_t>{0, 2}) ==
+             topology.LPsForPinning(PinPolicy::kSkipSMT));
+  HWY_ASSERT((std::vector<size_t>{0, 2, 3}) ==
+             topology.LPsForPinning(PinPolicy::kAllLPs));
+}
+
+TEST(TopologyTest, TestInvalidDir) {
+  HWY_ASSERT(Topology("/nonexistent/hwy/cpu").Empty());
+}
+
+#endif  // HWY_OS_LINUX
+
+TEST(TopologyTest, TestDetect) {
+  const Topology topology;
+  if (topology.Empty()) {
+    fprintf(stderr, "Topology not supported.\n");
+    return;
+  }
+  fprintf(stderr, "%zu LPs, %zu packages, %zu clusters, %zu cores\n",
+          topology.LPs().size(), topology.NumPackages(),
+          topology.NumClusters(), topology.NumCores());
+  HWY_ASSERT(topology.NumPackages() <= topology.NumClusters());
+  HWY_ASSERT(topology.NumClusters() <= topology.NumCores());
+  HWY_ASSERT(topology.NumCores() <= topology.LPs().size());
+
+  const std::vector<size_t> lps = topology.LPsForPinning(PinPolicy::kAllLPs);
+  HWY_ASSERT(topology.LPs().size() == lps.size());
+  HWY_ASSERT(topology.NumCores() ==
+             topology.LPsForPinning(PinPolicy::kSkipSMT).size());
+}
+
+// Uses a separate thread to avoid changing the affinity of the main thread.
+TEST(TopologyTest, TestPin) {
+  std::thread thread([]() {
+    std::vector<size_t> allowed;
+    if (!GetThreadAffinity(allowed)) {
+      fprintf(stderr, "Affinity not supported.\n");
+      return;
+    }
+    HWY_ASSERT(!allowed.empty());
+    const size_t lp = allowed.back();
+    HWY_ASSERT(PinThreadToLogicalProcessor(lp));
+    std::vector<size_t> pinned;
+    HWY_ASSERT(GetThreadAffinity(pinned));
+    HWY_ASSERT(pinned == std::vector<size_t>{lp});
+  });
+  thread.join();
+}
+
+TEST(TopologyTest, TestPinnedPool) {
+  if (HWY_ARCH_WASM) return;  // WASM threading is unreliable
+
+  std::vector<size_t> allowed;
+  if (!GetThreadAffinity(allowed)) return;
+  const std::vector<size_t> lps =
+      Topology().LPsForPinning(PinPolicy::kSkipSMT, allowed);
+  if (lps.empty()) return;
+
+  const size_t num_threads = HWY_MIN(ThreadPool::MaxThreads(), size_t{4});
+  ThreadPool pool(num_threads, lps);
+  const size_t num_workers = pool.NumWorkers();
+  pool.Run(0, 64, [&](uint64_t /*task*/, size_t thread) {
+    HWY_ASSERT(thread < num_workers);
+    if (thread == num_workers - 1) return;  // main thread is not pinned
+    std::vector<size_t> pinned;
+    HWY_ASSERT(GetThreadAffinity(pinned));
+    HWY_ASSERT(pinned == std::vector<size_t>{lps[thread % lps.size()]});
+  });
+}
+
+}  // namespace
+}  // namespace hwy